@@ -0,0 +1,931 @@
+// Бенчмарки библиотеки фигур.
+// Запуск: ./benchmark_Laboratory_4 [количество фигур] [наибольшее количество точек для выпуклой оболочки]
+// Бенчмарки не входят в ctest: время выполнения зависит от машины, а не от корректности кода.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "../include/point.h"
+#include "../include/figure.h"
+#include "../include/rhombus.h"
+#include "../include/pentagon.h"
+#include "../include/hexagon.h"
+#include "../include/arrayoffigures.h"
+#include "../include/threadpool.h"
+#include "../include/ownership.h"
+#include "../include/figureio.h"
+#include "../include/proximity.h"
+#include "../include/convexhull.h"
+#include "../include/clipping.h"
+#include "../include/rasterizer.h"
+#include "../include/kdtree.h"
+#include "../include/compressedfigures.h"
+#include "../include/mappedfigures.h"
+
+// Защита результата от удаления оптимизатором.
+template<class V>
+void do_not_optimize(const V& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Лучшее время (в секундах) из нескольких запусков функции.
+template<class F>
+double best_time(F&& function, int repeats = 5) {
+    double best = 1e300;
+    for (int r = 0; r < repeats; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+// Строка результата: время, пропускная способность (миллионов элементов в секунду) и дополнительная колонка.
+void print_row(const std::string& name, double seconds, double items, const std::string& extra = "") {
+    std::cout << std::left << std::setw(44) << name << std::right
+              << std::setw(12) << std::fixed << std::setprecision(3) << seconds * 1e3 << " ms"
+              << std::setw(14) << std::setprecision(1) << items / seconds / 1e6 << " M/s"
+              << "  " << extra << std::endl;
+}
+
+// Вершины правильного N-угольника с центром (cx, cy) и радиусом r.
+template<size_t N>
+std::vector<Point<double>> regular_points(double cx, double cy, double r) {
+    std::vector<Point<double>> points;
+    for (size_t i = 0; i < N; ++i) {
+        double angle = 2.0 * M_PI * static_cast<double>(i) / N;
+        points.emplace_back(cx + r * std::cos(angle), cy + r * std::sin(angle));
+    }
+    return points;
+}
+
+// Смешанный массив фигур. Виды фигур идут крупными блоками, поэтому стоимость обработки
+// соседних частей массива сильно различается - нерегулярная нагрузка для планировщика.
+ArrayOfFigures<Figure<double>> make_mixed_figures(size_t n) {
+    ArrayOfFigures<Figure<double>> figures(n);
+    const size_t block = 4096;
+    for (size_t i = 0; i < n; ++i) {
+        double cx = static_cast<double>(i % 1000);
+        double cy = static_cast<double>(i / 1000);
+        double r = 0.125 * static_cast<double>(2 + i % 5);
+        switch ((i / block) % 4) {
+            case 0: {
+                // Ромб строится по осям: проверка сторон у ромба точная, без погрешности.
+                figures.add_figure(std::make_shared<Rhombus<double>>(Point<double>(cx, cy + r), Point<double>(cx - r, cy),
+                                                                     Point<double>(cx, cy - r), Point<double>(cx + r, cy)));
+                break;
+            }
+            case 1: {
+                auto p = regular_points<5>(cx, cy, r);
+                figures.add_figure(std::make_shared<Pentagon<double>>(p[0], p[1], p[2], p[3], p[4]));
+                break;
+            }
+            default: {
+                auto p = regular_points<6>(cx, cy, r);
+                figures.add_figure(std::make_shared<Hexagon<double>>(p[0], p[1], p[2], p[3], p[4], p[5]));
+                break;
+            }
+        }
+    }
+    return figures;
+}
+
+// Масштабирование массовых операций ArrayOfFigures в зависимости от количества потоков.
+void benchmark_bulk_scaling(size_t n) {
+    std::cout << "\n=== Bulk operations scaling (" << n << " mixed figures) ===" << std::endl;
+    auto figures = make_mixed_figures(n);
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<unsigned> thread_counts;
+    for (unsigned t = 1; t < max_threads; t *= 2) {
+        thread_counts.push_back(t);
+    }
+    thread_counts.push_back(max_threads);
+
+    struct Operation {
+        std::string name;
+        std::function<void(const ArrayOfFigures<Figure<double>>&)> run;
+    };
+    std::vector<Operation> operations = {
+        {"total_square", [](const auto& a) { do_not_optimize(a.parallel_total_square()); }},
+        {"validation", [](const auto& a) { do_not_optimize(a.find_invalid().size()); }},
+        {"centroids", [](const auto& a) { do_not_optimize(a.centroids().size()); }},
+        {"clone_all", [](const auto& a) { do_not_optimize(a.clone_all().get_size()); }},
+        {"print_to_buffers", [](const auto& a) { do_not_optimize(a.print_to_buffers().size()); }},
+    };
+
+    for (const auto& operation : operations) {
+        double base = 0.0;
+        for (unsigned threads : thread_counts) {
+            figures.set_thread_pool(std::make_shared<ThreadPool>(threads));
+            double seconds = best_time([&]() { operation.run(figures); }, 3);
+            if (threads == 1) {
+                base = seconds;
+            }
+            std::ostringstream speedup;
+            speedup << "speedup x" << std::fixed << std::setprecision(2) << base / seconds;
+            print_row(operation.name + " threads=" + std::to_string(threads), seconds, static_cast<double>(n), speedup.str());
+        }
+    }
+}
+
+// Операции над массивом с заданной политикой владения.
+template<class Ownership>
+void benchmark_ownership_policy(const std::string& policy, size_t n) {
+    using Array = ArrayOfFigures<Figure<double>, Ownership>;
+    using Pointer = typename Array::value_type;
+    auto make = []() -> Pointer {
+        Point<double> p1(0.0, 1.0), p2(-1.0, 0.0), p3(0.0, -1.0), p4(1.0, 0.0);
+        if constexpr (std::is_copy_constructible_v<Pointer>) {
+            return std::make_shared<Rhombus<double>>(p1, p2, p3, p4);
+        } else {
+            return std::make_unique<Rhombus<double>>(p1, p2, p3, p4);
+        }
+    };
+    const double items = static_cast<double>(n);
+
+    // Добавление с ростом ёмкости от 1: каждое увеличение перемещает все указатели.
+    std::vector<Pointer> prepared;
+    Array array;
+    double seconds = best_time([&]() {
+        prepared.clear();
+        for (size_t i = 0; i < n; ++i) {
+            prepared.push_back(make());
+        }
+        Array grown(0);
+        for (auto& figure : prepared) {
+            grown.add_figure(std::move(figure));
+        }
+        array = std::move(grown);
+    }, 3);
+    print_row(policy + " build + add_figure", seconds, items);
+
+    // Чтение через operator[]: для shared_ptr копия указателя - атомарный инкремент и декремент.
+    seconds = best_time([&]() {
+        double total = 0.0;
+        for (size_t i = 0; i < array.get_size(); ++i) {
+            if constexpr (std::is_copy_constructible_v<Pointer>) {
+                auto figure = array[i];
+                total += figure->square();
+            } else {
+                total += array[i]->square();
+            }
+        }
+        do_not_optimize(total);
+    });
+    print_row(policy + " operator[] read", seconds, items);
+
+    seconds = best_time([&]() { do_not_optimize(array.total_square()); });
+    print_row(policy + " total_square", seconds, items);
+
+    seconds = best_time([&]() {
+        Array copy(array);
+        do_not_optimize(copy.get_size());
+    }, 3);
+    print_row(policy + " copy (deep clone)", seconds, items);
+
+    // Удаление из начала небольшого массива: сдвиг всех элементов перемещением.
+    const size_t removals = std::min<size_t>(n, 20000);
+    seconds = best_time([&]() {
+        Array small(removals);
+        for (size_t i = 0; i < removals; ++i) {
+            small.add_figure(make());
+        }
+        while (small.get_size() > 0) {
+            small.remove_figure(0);
+        }
+    }, 1);
+    print_row(policy + " remove_figure(0) x" + std::to_string(removals), seconds, static_cast<double>(removals));
+}
+
+// Сравнение политик владения ArrayOfFigures.
+void benchmark_ownership(size_t n) {
+    std::cout << "\n=== Ownership policies (" << n << " rhombi) ===" << std::endl;
+    benchmark_ownership_policy<SharedOwnership>("shared", n);
+    benchmark_ownership_policy<UniqueOwnership>("unique", n);
+}
+
+// Способы добавления фигур: по одной через add_figure, создание на месте и пакетное добавление.
+void benchmark_insertion(size_t n) {
+    std::cout << "\n=== Insertion (" << n << " rhombi) ===" << std::endl;
+    const double items = static_cast<double>(n);
+    Point<double> p1(0.0, 1.0), p2(-1.0, 0.0), p3(0.0, -1.0), p4(1.0, 0.0);
+
+    double seconds = best_time([&]() {
+        ArrayOfFigures<Figure<double>> array(0);
+        for (size_t i = 0; i < n; ++i) {
+            array.add_figure(std::make_shared<Rhombus<double>>(p1, p2, p3, p4));
+        }
+        do_not_optimize(array.get_size());
+    }, 3);
+    print_row("make_shared + add_figure", seconds, items);
+
+    seconds = best_time([&]() {
+        ArrayOfFigures<Figure<double>> array(0);
+        array.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            array.emplace_figure<Rhombus<double>>(p1, p2, p3, p4);
+        }
+        do_not_optimize(array.get_size());
+    }, 3);
+    print_row("reserve + emplace_figure", seconds, items);
+
+    std::vector<std::shared_ptr<Figure<double>>> batch;
+    seconds = best_time([&]() {
+        batch.clear();
+        for (size_t i = 0; i < n; ++i) {
+            batch.push_back(std::make_shared<Rhombus<double>>(p1, p2, p3, p4));
+        }
+        ArrayOfFigures<Figure<double>> array(0);
+        array.add_figures(std::move(batch));
+        do_not_optimize(array.get_size());
+    }, 3);
+    print_row("build batch + add_figures(move)", seconds, items);
+}
+
+// Правильные многоугольники: конструктор с проверкой по вершинам против фабрики regular().
+void benchmark_regular_factory(size_t n) {
+    std::cout << "\n=== Regular polygons (" << n << " hexagons) ===" << std::endl;
+    const double items = static_cast<double>(n);
+
+    double seconds = best_time([&]() {
+        double total = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            auto p = regular_points<6>(static_cast<double>(i % 1000), static_cast<double>(i / 1000), 0.5);
+            Hexagon<double> hexagon(p[0], p[1], p[2], p[3], p[4], p[5]);
+            total += hexagon.square() + hexagon.perimeter();
+        }
+        do_not_optimize(total);
+    }, 3);
+    print_row("cos/sin + validating constructor", seconds, items);
+
+    seconds = best_time([&]() {
+        double total = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            auto hexagon = Hexagon<double>::regular(Point<double>(static_cast<double>(i % 1000), static_cast<double>(i / 1000)), 0.5);
+            total += hexagon.square() + hexagon.perimeter();
+        }
+        do_not_optimize(total);
+    }, 3);
+    print_row("Hexagon::regular", seconds, items);
+}
+
+// Проверка недоверенных записей (5% некорректных): исключения против std::expected и try_build.
+void benchmark_validation(size_t n) {
+    std::cout << "\n=== Validation of untrusted records (" << n << " records, 5% invalid) ===" << std::endl;
+    std::vector<FigureRecord<double>> records(n);
+    for (size_t i = 0; i < n; ++i) {
+        double r = 0.125 * static_cast<double>(2 + i % 5);
+        records[i].vertex_count = 4;
+        records[i].vertices[0] = Point<double>(0.0, r);
+        records[i].vertices[1] = Point<double>(-r, 0.0);
+        records[i].vertices[2] = Point<double>(0.0, -r);
+        records[i].vertices[3] = Point<double>(i % 20 == 0 ? 2.0 * r : r, 0.0);
+    }
+    const double items = static_cast<double>(n);
+
+    double seconds = best_time([&]() {
+        ArrayOfFigures<Figure<double>> figures(n);
+        size_t rejected = 0;
+        for (const auto& record : records) {
+            try {
+                figures.add_figure(make_figure(record));
+            } catch (const std::invalid_argument&) {
+                ++rejected;
+            }
+        }
+        do_not_optimize(rejected);
+    }, 3);
+    print_row("make_figure + catch", seconds, items);
+
+    seconds = best_time([&]() {
+        ArrayOfFigures<Figure<double>> figures;
+        std::vector<FigureRejection> rejected;
+        try_build(std::span<const FigureRecord<double>>(records), figures, rejected);
+        do_not_optimize(rejected.size());
+    }, 3);
+    print_row("try_build (std::expected)", seconds, items);
+}
+
+// Операции над массивами точек (векторная арифметика Point<T>).
+template<class T>
+void benchmark_point_ops_for(const std::string& type, size_t n) {
+    std::vector<Point<T>> a(n), b(n), out(n);
+    std::vector<T> scalars(n);
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = Point<T>(static_cast<T>(i % 1000) * T(0.5), static_cast<T>(i / 1000) * T(0.25));
+        b[i] = Point<T>(static_cast<T>(i % 7) - T(3), static_cast<T>(i % 11) * T(0.125));
+    }
+    const double items = static_cast<double>(n);
+    auto run_points = [&](const std::string& name, auto op) {
+        double seconds = best_time([&]() {
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = op(a[i], b[i]);
+            }
+            do_not_optimize(out[n / 2]);
+        });
+        print_row(type + " " + name, seconds, items);
+    };
+    auto run_scalars = [&](const std::string& name, auto op) {
+        double seconds = best_time([&]() {
+            for (size_t i = 0; i < n; ++i) {
+                scalars[i] = op(a[i], b[i]);
+            }
+            do_not_optimize(scalars[n / 2]);
+        });
+        print_row(type + " " + name, seconds, items);
+    };
+    run_points("a + b", [](const Point<T>& p, const Point<T>& q) { return p + q; });
+    run_points("a - b", [](const Point<T>& p, const Point<T>& q) { return p - q; });
+    run_points("a * s", [](const Point<T>& p, const Point<T>&) { return p * T(1.5); });
+    run_points("lerp(a, b, t)", [](const Point<T>& p, const Point<T>& q) { return lerp(p, q, 0.25); });
+    run_scalars("dot(a, b)", [](const Point<T>& p, const Point<T>& q) { return dot(p, q); });
+    run_scalars("cross(a, b)", [](const Point<T>& p, const Point<T>& q) { return cross(p, q); });
+    run_scalars("squared_norm(a - b)", [](const Point<T>& p, const Point<T>& q) { return squared_norm(p - q); });
+}
+
+void benchmark_point_ops(size_t n) {
+    std::cout << "\n=== Point arithmetic (" << n << " points) ===" << std::endl;
+    benchmark_point_ops_for<double>("double", n);
+    benchmark_point_ops_for<float>("float", n);
+
+    // Вычислительные ядра фигур поверх арифметики точек.
+    std::vector<Hexagon<double>> hexagons;
+    hexagons.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        auto p = regular_points<6>(static_cast<double>(i % 1000), static_cast<double>(i / 1000), 0.5);
+        hexagons.emplace_back(p[0], p[1], p[2], p[3], p[4], p[5]);
+    }
+    const double items = static_cast<double>(n);
+    double seconds = best_time([&]() {
+        double total = 0.0;
+        for (const auto& hexagon : hexagons) {
+            total += hexagon.square();
+        }
+        do_not_optimize(total);
+    });
+    print_row("Hexagon::square (shoelace)", seconds, items);
+    seconds = best_time([&]() {
+        double total = 0.0;
+        for (const auto& hexagon : hexagons) {
+            total += hexagon.perimeter();
+        }
+        do_not_optimize(total);
+    });
+    print_row("Hexagon::perimeter", seconds, items);
+    seconds = best_time([&]() {
+        size_t valid = 0;
+        for (const auto& hexagon : hexagons) {
+            valid += hexagon.is_valid() ? 1 : 0;
+        }
+        do_not_optimize(valid);
+    });
+    print_row("Hexagon::is_valid", seconds, items);
+}
+
+// Преобразование всех фигур: transform_all с аналитическим обновлением агрегатов
+// против поэлементного transform с полным пересчётом агрегатов.
+void benchmark_transform(size_t n) {
+    std::cout << "\n=== Affine transforms (" << n << " mixed figures) ===" << std::endl;
+    auto figures = make_mixed_figures(n);
+    // Поворот без масштабирования, чтобы координаты не росли от повторов.
+    const auto matrix = Affine2D::rotation(0.01, 500.0, 500.0);
+    const double items = static_cast<double>(n);
+
+    double seconds = best_time([&]() {
+        for (size_t i = 0; i < figures.get_size(); ++i) {
+            figures.get_unchecked(i)->transform(matrix);
+        }
+        figures.refresh_aggregates();
+        do_not_optimize(figures.total_area());
+    }, 3);
+    print_row("per-figure transform + refresh", seconds, items);
+
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> thread_counts = {1u};
+    if (max_threads > 1) {
+        thread_counts.push_back(max_threads);
+    }
+    for (unsigned threads : thread_counts) {
+        figures.set_thread_pool(std::make_shared<ThreadPool>(threads));
+        seconds = best_time([&]() {
+            figures.transform_all(matrix);
+            do_not_optimize(figures.total_area());
+        }, 3);
+        print_row("transform_all threads=" + std::to_string(threads), seconds, items);
+    }
+}
+
+// Упорядочивание вдоль кривых Мортона и Гильберта: время перестановки и время прохода по соседям
+// (расстояние между центрами соседних в массиве фигур) до и после неё.
+void benchmark_spatial_order(size_t n) {
+    std::cout << "\n=== Spatial reordering (" << n << " mixed figures) ===" << std::endl;
+    const double items = static_cast<double>(n);
+    auto neighbour_pass = [](const ArrayOfFigures<Figure<double>>& figures, const std::string& name) {
+        double step = 0.0;
+        double seconds = best_time([&]() {
+            step = 0.0;
+            for (size_t i = 1; i < figures.get_size(); ++i) {
+                auto box_a = figures[i - 1]->bounding_box();
+                auto box_b = figures[i]->bounding_box();
+                step += std::fabs(box_a.min_x - box_b.min_x) + std::fabs(box_a.min_y - box_b.min_y);
+            }
+            do_not_optimize(step);
+        }, 3);
+        std::ostringstream extra;
+        extra << "mean step " << std::fixed << std::setprecision(2) << step / static_cast<double>(figures.get_size());
+        print_row(name, seconds, static_cast<double>(figures.get_size()), extra.str());
+    };
+
+    auto figures = make_mixed_figures(n);
+    auto slots = figures.as_span();
+    std::shuffle(slots.begin(), slots.end(), std::mt19937(1));
+    neighbour_pass(figures, "neighbour pass, shuffled");
+    for (auto [curve, name] : {std::pair{SpaceFillingCurve::Morton, "morton"}, std::pair{SpaceFillingCurve::Hilbert, "hilbert"}}) {
+        double seconds = best_time([&]() { figures.reorder_spatially(curve); }, 3);
+        print_row(std::string("reorder_spatially ") + name, seconds, items);
+        neighbour_pass(figures, std::string("neighbour pass, ") + name);
+    }
+}
+
+// Удаление дубликатов: набор из n фигур, в котором каждая фигура повторяется 4 раза.
+void benchmark_deduplication(size_t n) {
+    std::cout << "\n=== Deduplication (" << n << " figures, 4 copies each) ===" << std::endl;
+    auto unique = make_mixed_figures(std::max<size_t>(n / 4, 1));
+    ArrayOfFigures<Figure<double>> source(n);
+    for (size_t i = 0; i < n; ++i) {
+        source.add_figure(unique[i % unique.get_size()]->clone());
+    }
+    const double items = static_cast<double>(n);
+
+    double seconds = best_time([&]() { do_not_optimize(source.signatures().size()); }, 3);
+    print_row("signatures (identical)", seconds, items);
+    seconds = best_time([&]() { do_not_optimize(source.signatures(DeduplicationMode::Congruent).size()); }, 3);
+    print_row("signatures (congruent)", seconds, items);
+    for (auto [mode, name] : {std::pair{DeduplicationMode::Identical, "identical"}, std::pair{DeduplicationMode::Congruent, "congruent"}}) {
+        size_t removed = 0;
+        seconds = best_time([&]() {
+            auto copy = source;
+            removed = copy.deduplicate(mode);
+        }, 3);
+        print_row(std::string("copy + deduplicate ") + name, seconds, items, "removed " + std::to_string(removed));
+    }
+    size_t shared = 0;
+    seconds = best_time([&]() {
+        auto copy = source.clone_all();
+        shared = copy.share_duplicates();
+    }, 3);
+    print_row("clone_all + share_duplicates", seconds, items, "shared " + std::to_string(shared));
+}
+
+// Площадь объединения фигур (соседние фигуры смешанного набора перекрываются).
+void benchmark_covered_area(size_t n) {
+    std::cout << "\n=== Covered (union) area (" << n << " mixed figures) ===" << std::endl;
+    auto figures = make_mixed_figures(n);
+    const double items = static_cast<double>(n);
+    double area = 0.0;
+    double seconds = best_time([&]() { do_not_optimize(figures.total_square()); }, 3);
+    print_row("total_square (overlaps counted twice)", seconds, items);
+    seconds = best_time([&]() { area = figures.covered_area(); }, 3);
+    std::ostringstream extra;
+    extra << "area " << std::fixed << std::setprecision(1) << area << " of " << figures.total_square();
+    print_row("covered_area", seconds, items, extra.str());
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    figures.set_thread_pool(std::make_shared<ThreadPool>(max_threads));
+    seconds = best_time([&]() { do_not_optimize(figures.parallel_covered_area()); }, 3);
+    print_row("parallel_covered_area threads=" + std::to_string(max_threads), seconds, items);
+}
+
+// Поиск пересекающихся фигур: заметание по прямоугольникам и точная проверка SAT.
+void benchmark_collisions(size_t n) {
+    std::cout << "\n=== Collision detection (" << n << " mixed figures) ===" << std::endl;
+    auto figures = make_mixed_figures(n);
+    const double items = static_cast<double>(n);
+    size_t pairs = 0;
+    double seconds = best_time([&]() { pairs = figures.find_collisions().size(); }, 3);
+    print_row("find_collisions", seconds, items, "pairs " + std::to_string(pairs));
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    figures.set_thread_pool(std::make_shared<ThreadPool>(max_threads));
+    seconds = best_time([&]() { pairs = figures.parallel_find_collisions().size(); }, 3);
+    print_row("parallel_find_collisions threads=" + std::to_string(max_threads), seconds, items, "pairs " + std::to_string(pairs));
+}
+
+// Запросы близости одной фигуры ко всем фигурам массива.
+void benchmark_proximity(size_t n) {
+    std::cout << "\n=== Proximity queries (" << n << " mixed figures) ===" << std::endl;
+    auto figures = make_mixed_figures(n);
+    const double items = static_cast<double>(n);
+    auto target = Hexagon<double>::regular(Point<double>(500.0, 100.0), 3.0);
+
+    double seconds = best_time([&]() {
+        double total = 0.0;
+        for (size_t i = 0; i < figures.get_size(); ++i) {
+            total += figure_distance<double>(target, *figures[i]);
+        }
+        do_not_optimize(total);
+    }, 3);
+    print_row("figure_distance per pair", seconds, items);
+
+    ConvexProbe<double> probe(target);
+    seconds = best_time([&]() {
+        double total = 0.0;
+        for (size_t i = 0; i < figures.get_size(); ++i) {
+            total += probe.distance(figures[i]->vertices());
+        }
+        do_not_optimize(total);
+    }, 3);
+    print_row("ConvexProbe::distance (reused probe)", seconds, items);
+
+    seconds = best_time([&]() { do_not_optimize(figures.distances_to(probe).size()); }, 3);
+    print_row("distances_to", seconds, items);
+    size_t near = 0;
+    seconds = best_time([&]() { near = figures.within_distance(probe, 5.0).size(); }, 3);
+    print_row("within_distance r=5 (box prefilter)", seconds, items, "near " + std::to_string(near));
+}
+
+// Отсечение фигур окном: классификация по прямоугольникам, отсекаются только фигуры на границе окна.
+void benchmark_clipping(size_t n) {
+    std::cout << "\n=== Viewport clipping (" << n << " mixed figures) ===" << std::endl;
+    auto figures = make_mixed_figures(n);
+    const double items = static_cast<double>(n);
+    BoundingBox<double> window;
+    window.expand(100.3, 0.3);
+    window.expand(600.7, static_cast<double>(n / 1000) / 2.0 + 0.7);
+
+    size_t polygons = 0;
+    double seconds = best_time([&]() {
+        ClippedPolygons clipped;
+        std::vector<Point<double>> current;
+        std::vector<Point<double>> next;
+        for (size_t i = 0; i < figures.get_size(); ++i) {
+            sutherland_hodgman(figures[i]->vertices(), window, current, next);
+            clipped.add(std::span<const Point<double>>(current), i);
+        }
+        polygons = clipped.size();
+    }, 3);
+    print_row("sutherland_hodgman every figure", seconds, items, "polygons " + std::to_string(polygons));
+    seconds = best_time([&]() { polygons = figures.clip(window).size(); }, 3);
+    print_row("clip (bounding box classification)", seconds, items, "polygons " + std::to_string(polygons));
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    figures.set_thread_pool(std::make_shared<ThreadPool>(max_threads));
+    seconds = best_time([&]() { polygons = figures.clip(window).size(); }, 3);
+    print_row("clip threads=" + std::to_string(max_threads), seconds, items, "polygons " + std::to_string(polygons));
+}
+
+// Выпуклая оболочка: вершины всех фигур массива и большие наборы точек (1M, 10M, 100M - до max_points).
+void benchmark_convex_hull(size_t n, size_t max_points) {
+    std::cout << "\n=== Convex hull (" << n << " mixed figures, up to " << max_points << " points) ===" << std::endl;
+    auto figures = make_mixed_figures(n);
+    double vertex_count = 0.0;
+    for (size_t i = 0; i < figures.get_size(); ++i) {
+        vertex_count += static_cast<double>(figures[i]->vertices().size());
+    }
+    size_t hull_size = 0;
+    double seconds = best_time([&]() {
+        std::vector<Point<double>> vertices;
+        for (size_t i = 0; i < figures.get_size(); ++i) {
+            auto span = figures[i]->vertices();
+            vertices.insert(vertices.end(), span.begin(), span.end());
+        }
+        hull_size = monotone_chain(vertices).size();
+    }, 3);
+    print_row("copy vertices + monotone_chain", seconds, vertex_count, "hull " + std::to_string(hull_size));
+    seconds = best_time([&]() { hull_size = figures.convex_hull().size(); }, 3);
+    print_row("convex_hull", seconds, vertex_count, "hull " + std::to_string(hull_size));
+
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    ThreadPool pool(max_threads);
+    std::mt19937_64 rng(44);
+    std::uniform_real_distribution<double> coordinate(-1.0, 1.0);
+    std::vector<Point<double>> points;
+    for (size_t count = 1000000; count <= max_points; count *= 10) {
+        points.reserve(count);
+        while (points.size() < count) {
+            points.emplace_back(coordinate(rng), coordinate(rng));
+        }
+        const double items = static_cast<double>(count);
+        const std::string label = std::to_string(count / 1000000) + "M points";
+        // Последовательной версии нужна копия всех точек, поэтому она измеряется только до 10M.
+        if (count <= 10000000) {
+            seconds = best_time([&]() {
+                std::vector<Point<double>> copy = points;
+                hull_size = monotone_chain(copy).size();
+            }, 1);
+            print_row("monotone_chain " + label, seconds, items, "hull " + std::to_string(hull_size));
+        }
+        seconds = best_time([&]() {
+            hull_size = parallel_convex_hull(pool, std::span<const Point<double>>(points), 1 << 16).size();
+        }, 3);
+        print_row("parallel_convex_hull " + label + " threads=" + std::to_string(max_threads), seconds, items,
+                  "hull " + std::to_string(hull_size));
+    }
+}
+
+// Растеризация фигур в сетку (8 x 8 ячеек на единицу площади): построчное заполнение против проверки
+// центра каждой ячейки ограничивающего прямоугольника.
+void benchmark_rasterization(size_t n) {
+    std::cout << "\n=== Rasterization (" << n << " mixed figures) ===" << std::endl;
+    auto figures = make_mixed_figures(n);
+    const double items = static_cast<double>(n);
+    constexpr size_t per_unit = 8;
+    BoundingBox<double> window;
+    window.expand(-1.0, -1.0);
+    window.expand(1000.0, static_cast<double>((n + 999) / 1000) + 1.0);
+    const size_t width = static_cast<size_t>(window.width()) * per_unit;
+    const size_t height = static_cast<size_t>(window.height()) * per_unit;
+    const std::string cells = std::to_string(width) + "x" + std::to_string(height) + " cells";
+
+    std::vector<std::uint8_t> binary(width * height);
+    RasterGrid<std::uint8_t> binary_grid(std::span<std::uint8_t>(binary), width, height, window);
+    double seconds = best_time([&]() {
+        std::fill(binary.begin(), binary.end(), 0);
+        const double step = 1.0 / static_cast<double>(per_unit);
+        for (size_t i = 0; i < figures.get_size(); ++i) {
+            auto box = figures[i]->bounding_box();
+            auto vertices = figures[i]->vertices();
+            size_t c0 = static_cast<size_t>((box.min_x - window.min_x) * per_unit);
+            size_t c1 = static_cast<size_t>((box.max_x - window.min_x) * per_unit) + 1;
+            size_t r0 = static_cast<size_t>((box.min_y - window.min_y) * per_unit);
+            size_t r1 = static_cast<size_t>((box.max_y - window.min_y) * per_unit) + 1;
+            for (size_t r = r0; r < std::min(r1, height); ++r) {
+                for (size_t c = c0; c < std::min(c1, width); ++c) {
+                    Point<double> center(window.min_x + (static_cast<double>(c) + 0.5) * step,
+                                         window.min_y + (static_cast<double>(r) + 0.5) * step);
+                    bool inside = true;
+                    for (size_t k = 0; k < vertices.size() && inside; ++k) {
+                        inside = cross(vertices[(k + 1) % vertices.size()] - vertices[k], center - vertices[k]) >= 0.0;
+                    }
+                    if (inside) {
+                        binary[r * width + c] = 1;
+                    }
+                }
+            }
+        }
+    }, 3);
+    print_row("per-cell center test (" + cells + ")", seconds, items);
+    seconds = best_time([&]() {
+        std::fill(binary.begin(), binary.end(), 0);
+        figures.rasterize(binary_grid, RasterMode::Binary);
+    }, 3);
+    print_row("rasterize Binary", seconds, items);
+
+    std::vector<std::uint16_t> counts(width * height);
+    seconds = best_time([&]() {
+        std::fill(counts.begin(), counts.end(), 0);
+        figures.rasterize(RasterGrid<std::uint16_t>(std::span<std::uint16_t>(counts), width, height, window), RasterMode::Count);
+    }, 3);
+    print_row("rasterize Count", seconds, items);
+
+    std::vector<float> coverage(width * height);
+    seconds = best_time([&]() {
+        std::fill(coverage.begin(), coverage.end(), 0.0f);
+        figures.rasterize(RasterGrid<float>(std::span<float>(coverage), width, height, window), RasterMode::Area);
+    }, 3);
+    print_row("rasterize Area", seconds, items);
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    figures.set_thread_pool(std::make_shared<ThreadPool>(max_threads));
+    seconds = best_time([&]() {
+        std::fill(coverage.begin(), coverage.end(), 0.0f);
+        figures.rasterize(RasterGrid<float>(std::span<float>(coverage), width, height, window), RasterMode::Area);
+    }, 3);
+    print_row("rasterize Area threads=" + std::to_string(max_threads), seconds, items);
+}
+
+// Пакетная проверка принадлежности точек: одна фигура (скалярная проверка против ядра полуплоскостей)
+// и вся коллекция (отсечение по прямоугольникам и сетке).
+void benchmark_containment(size_t n) {
+    constexpr size_t queries = 4000000;
+    std::cout << "\n=== Point containment (" << queries << " points, " << n << " mixed figures) ===" << std::endl;
+    std::mt19937_64 rng(47);
+    std::uniform_real_distribution<double> unit(-2.0, 2.0);
+    std::vector<Point<double>> points(queries);
+    for (auto& point : points) {
+        point = Point<double>(unit(rng), unit(rng));
+    }
+    std::vector<std::uint8_t> out(queries);
+    const double items = static_cast<double>(queries);
+    auto hexagon = Hexagon<double>::regular(Point<double>(0.0, 0.0), 1.5);
+
+    double seconds = best_time([&]() {
+        auto vertices = hexagon.vertices();
+        for (size_t i = 0; i < queries; ++i) {
+            bool inside = true;
+            for (size_t k = 0; k < vertices.size() && inside; ++k) {
+                inside = cross(vertices[(k + 1) % vertices.size()] - vertices[k], points[i] - vertices[k]) >= 0.0;
+            }
+            out[i] = inside;
+        }
+        do_not_optimize(out.data());
+    }, 3);
+    print_row("hexagon scalar cross-product loop", seconds, items);
+    seconds = best_time([&]() {
+        hexagon.contains_batch(points, out);
+        do_not_optimize(out.data());
+    }, 3);
+    print_row("hexagon contains_batch", seconds, items);
+
+    // Небольшой набор фигур (один ряд из 256) и вся коллекция из n фигур; точки равномерно по области фигур.
+    size_t inside = 0;
+    for (size_t count : {size_t{256}, n}) {
+        auto figures = make_mixed_figures(count);
+        std::uniform_real_distribution<double> field_x(0.0, static_cast<double>(std::min<size_t>(count, 1000)));
+        std::uniform_real_distribution<double> field_y(-1.0, static_cast<double>(count / 1000) + 1.0);
+        for (auto& point : points) {
+            point = Point<double>(field_x(rng), field_y(rng));
+        }
+        seconds = best_time([&]() {
+            figures.contains_batch(std::span<const Point<double>>(points), std::span<std::uint8_t>(out));
+            inside = static_cast<size_t>(std::count(out.begin(), out.end(), 1));
+        }, 3);
+        print_row("ArrayOfFigures::contains_batch " + std::to_string(count) + " figures", seconds, items, "inside " + std::to_string(inside));
+    }
+}
+
+// Ближайшие соседи и ближайшая пара по геометрическим центрам: k-d дерево против перебора.
+void benchmark_neighbours(size_t n) {
+    std::cout << "\n=== Nearest neighbours (" << n << " mixed figures) ===" << std::endl;
+    auto figures = make_mixed_figures(n);
+    const double items = static_cast<double>(n);
+
+    // Перебор O(n^2) - только на первых 20000 фигурах.
+    const size_t brute = std::min<size_t>(n, 20000);
+    auto centers = figures.centroids();
+    double seconds = best_time([&]() {
+        double best = 1e300;
+        for (size_t i = 0; i < brute; ++i) {
+            for (size_t j = i + 1; j < brute; ++j) {
+                best = std::min(best, squared_norm(centers[i] - centers[j]));
+            }
+        }
+        do_not_optimize(best);
+    }, 1);
+    print_row("O(n^2) closest pair scan n=" + std::to_string(brute), seconds, static_cast<double>(brute));
+    seconds = best_time([&]() { do_not_optimize(figures.closest_pair()->distance); }, 3);
+    print_row("closest_pair (sweep)", seconds, items);
+
+    std::vector<Point<double>> points(centers.begin(), centers.end());
+    seconds = best_time([&]() { KdTree tree(points, figures.get_thread_pool()); do_not_optimize(tree.size()); }, 3);
+    print_row("KdTree build", seconds, items);
+    for (size_t k : {size_t{1}, size_t{8}}) {
+        seconds = best_time([&]() { do_not_optimize(figures.nearest_neighbours(k).size()); }, 3);
+        print_row("nearest_neighbours k=" + std::to_string(k), seconds, items);
+    }
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    figures.set_thread_pool(std::make_shared<ThreadPool>(max_threads));
+    seconds = best_time([&]() { do_not_optimize(figures.nearest_neighbours(8).size()); }, 3);
+    print_row("nearest_neighbours k=8 threads=" + std::to_string(max_threads), seconds, items);
+}
+
+// Сжатое хранение: байт на фигуру в сравнении с объектами и записями, скорость сжатия и распаковки.
+void benchmark_compression(size_t n) {
+    std::cout << "\n=== Compressed storage (" << n << " mixed figures) ===" << std::endl;
+    auto figures = make_mixed_figures(n);
+    const double items = static_cast<double>(n);
+
+    // Объём живой коллекции: указатель в массиве и объект фигуры (без учёта служебных данных распределителя).
+    size_t object_bytes = 0;
+    for (size_t i = 0; i < n; ++i) {
+        switch (figures[i]->vertex_count()) {
+            case 4: object_bytes += sizeof(Rhombus<double>); break;
+            case 5: object_bytes += sizeof(Pentagon<double>); break;
+            default: object_bytes += sizeof(Hexagon<double>); break;
+        }
+        object_bytes += sizeof(std::shared_ptr<Figure<double>>);
+    }
+    auto per_figure = [&](size_t bytes) {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(1) << static_cast<double>(bytes) / items << " B/figure";
+        return oss.str();
+    };
+    std::cout << std::left << std::setw(44) << "objects (shared_ptr + sizeof)" << per_figure(object_bytes) << std::endl;
+    std::cout << std::left << std::setw(44) << "FigureRecord<double>" << per_figure(n * sizeof(FigureRecord<double>)) << std::endl;
+
+    CompressedFigures<double> compressed;
+    double seconds = best_time([&]() { compressed = CompressedFigures<double>::compress(figures); }, 3);
+    print_row("compress (quantum 2^-24)", seconds, items, per_figure(compressed.byte_size()));
+    seconds = best_time([&]() { do_not_optimize(CompressedFigures<double>::compress(figures, 1.0 / 1024).byte_size()); }, 3);
+    print_row("compress (quantum 2^-10)", seconds, items,
+              per_figure(CompressedFigures<double>::compress(figures, 1.0 / 1024).byte_size()));
+
+    std::vector<FigureRecord<double>> block(CompressedFigures<double>::BLOCK_SIZE);
+    seconds = best_time([&]() {
+        double sum = 0.0;
+        for (size_t b = 0; b < compressed.block_count(); ++b) {
+            size_t count = compressed.decode_block(b, block);
+            for (size_t r = 0; r < count; ++r) {
+                sum += block[r].vertices[0].get_x();
+            }
+        }
+        do_not_optimize(sum);
+    });
+    print_row("decode_block (all blocks to records)", seconds, items);
+    const size_t lookups = std::min<size_t>(n, 100000);
+    seconds = best_time([&]() {
+        double sum = 0.0;
+        for (size_t i = 0; i < lookups; ++i) {
+            sum += compressed.record((i * 7919) % n).vertices[0].get_y();
+        }
+        do_not_optimize(sum);
+    }, 3);
+    print_row("record(i) random access", seconds, static_cast<double>(lookups));
+    std::vector<FigureRejection> rejected;
+    seconds = best_time([&]() {
+        rejected.clear();
+        do_not_optimize(compressed.decompress(rejected).get_size());
+    }, 3);
+    print_row("decompress to ArrayOfFigures", seconds, items, "rejected " + std::to_string(rejected.size()));
+}
+
+// Запуск с сохранённой коллекцией: разбор текста и проверка конструкторами против открытия отображённого файла.
+void benchmark_mapped_startup(size_t n) {
+    std::cout << "\n=== Persistent collection startup (" << n << " mixed figures) ===" << std::endl;
+    auto figures = make_mixed_figures(n);
+    const double items = static_cast<double>(n);
+    const auto directory = std::filesystem::temp_directory_path();
+    const std::string text_path = (directory / "benchmark_figures.txt").string();
+    const std::string mapped_path = (directory / "benchmark_figures.figs").string();
+    {
+        std::ofstream os(text_path);
+        for (const auto& figure : figures) {
+            write_text_record(os, to_record(*figure));
+        }
+        MappedFigures<double>::create(mapped_path).append(figures);
+    }
+
+    double seconds = best_time([&]() {
+        std::ifstream is(text_path);
+        std::vector<FigureRecord<double>> records;
+        FigureRecord<double> record;
+        while (read_text_record(is, record)) {
+            records.push_back(record);
+        }
+        ArrayOfFigures<Figure<double>> loaded;
+        std::vector<FigureRejection> rejected;
+        try_build(std::span<const FigureRecord<double>>(records), loaded, rejected);
+        do_not_optimize(loaded.total_square());
+    }, 3);
+    print_row("text parse + validate + total_square", seconds, items);
+    seconds = best_time([&]() {
+        MappedFigures<double> mapped(mapped_path);
+        do_not_optimize(mapped.size());
+    });
+    print_row("mmap open (header check only)", seconds, items);
+    seconds = best_time([&]() {
+        MappedFigures<double> mapped(mapped_path);
+        do_not_optimize(mapped.total_square());
+    });
+    print_row("mmap open + total_square", seconds, items);
+    seconds = best_time([&]() {
+        MappedFigures<double> mapped(mapped_path);
+        KdTree tree(mapped.centroids(), ThreadPool::global());
+        do_not_optimize(tree.size());
+    }, 3);
+    print_row("mmap open + centroids + KdTree", seconds, items);
+    seconds = best_time([&]() {
+        auto mapped = MappedFigures<double>::create(mapped_path);
+        mapped.append(figures);
+        do_not_optimize(mapped.size());
+    }, 3);
+    print_row("create + append collection", seconds, items);
+    std::filesystem::remove(text_path);
+    std::filesystem::remove(mapped_path);
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 200000;
+    size_t max_points = argc > 2 ? static_cast<size_t>(std::strtoull(argv[2], nullptr, 10)) : 10000000;
+    std::cout << "Laboratory 4 benchmarks" << std::endl;
+    benchmark_bulk_scaling(n);
+    benchmark_ownership(n);
+    benchmark_insertion(n);
+    benchmark_regular_factory(n);
+    benchmark_validation(n);
+    benchmark_point_ops(n);
+    benchmark_transform(n);
+    benchmark_spatial_order(n);
+    benchmark_deduplication(n);
+    benchmark_covered_area(n);
+    benchmark_collisions(n);
+    benchmark_proximity(n);
+    benchmark_convex_hull(n, max_points);
+    benchmark_clipping(n);
+    benchmark_rasterization(n);
+    benchmark_containment(n);
+    benchmark_neighbours(n);
+    benchmark_compression(n);
+    benchmark_mapped_startup(n);
+    return 0;
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <stdexcept>
+#include "point.h"
+
+// Аффинное преобразование плоскости:
+//   x' = a * x + b * y + tx
+//   y' = c * x + d * y + ty
+// Коэффициенты хранятся в double независимо от типа координат фигур.
+struct Affine2D {
+    double a{1.0};
+    double b{0.0};
+    double c{0.0};
+    double d{1.0};
+    double tx{0.0};
+    double ty{0.0};
+
+    static Affine2D identity() {
+        return Affine2D{};
+    };
+
+    static Affine2D translation(double dx, double dy) {
+        return Affine2D{1.0, 0.0, 0.0, 1.0, dx, dy};
+    };
+
+    // Поворот на angle радиан против часовой стрелки вокруг начала координат.
+    static Affine2D rotation(double angle) {
+        double cs = std::cos(angle);
+        double sn = std::sin(angle);
+        return Affine2D{cs, -sn, sn, cs, 0.0, 0.0};
+    };
+
+    // Поворот вокруг точки (cx, cy).
+    static Affine2D rotation(double angle, double cx, double cy) {
+        return translation(cx, cy) * rotation(angle) * translation(-cx, -cy);
+    };
+
+    static Affine2D scaling(double sx, double sy) {
+        return Affine2D{sx, 0.0, 0.0, sy, 0.0, 0.0};
+    };
+
+    static Affine2D scaling(double factor) {
+        return scaling(factor, factor);
+    };
+
+    // Композиция: (m * n)(p) = m(n(p)).
+    friend Affine2D operator*(const Affine2D& m, const Affine2D& n) {
+        return Affine2D{m.a * n.a + m.b * n.c, m.a * n.b + m.b * n.d,
+                        m.c * n.a + m.d * n.c, m.c * n.b + m.d * n.d,
+                        m.a * n.tx + m.b * n.ty + m.tx, m.c * n.tx + m.d * n.ty + m.ty};
+    }
+
+    // Определитель линейной части: во сколько раз (по модулю) меняются площади.
+    double determinant() const {
+        return a * d - b * c;
+    };
+
+    // Коэффициент изменения длин для преобразования подобия.
+    double length_scale() const {
+        return std::sqrt(std::fabs(determinant()));
+    };
+
+    // Преобразование подобия (повороты, отражения, равномерное масштабирование и сдвиги) сохраняет форму:
+    // ромб остаётся ромбом, правильный многоугольник - правильным.
+    bool is_similarity(double eps = 1e-12) const {
+        double column1 = a * a + c * c;
+        double column2 = b * b + d * d;
+        double tolerance = eps * std::max(1.0, column1 + column2);
+        return std::fabs(a * b + c * d) <= tolerance && std::fabs(column1 - column2) <= tolerance && column1 > 0.0;
+    };
+
+    // Сохраняет ли преобразование оси координат (нет поворота): тогда ограничивающий прямоугольник
+    // переходит в ограничивающий прямоугольник.
+    bool is_axis_aligned() const {
+        return b == 0.0 && c == 0.0;
+    };
+
+    // Проверка перед применением к фигурам.
+    void require_similarity() const {
+        if (!is_similarity()) {
+            throw std::invalid_argument("Affine transform must be a similarity (rotation, reflection, uniform scale, translation).");
+        }
+    };
+
+    template<Scalar T>
+    Point<T> apply(const Point<T>& point) const {
+        double x = static_cast<double>(point.get_x());
+        double y = static_cast<double>(point.get_y());
+        return Point<T>(to_coordinate<T>(a * x + b * y + tx), to_coordinate<T>(c * x + d * y + ty));
+    };
+
+    // Целочисленные координаты округляются к ближайшему целому (а не отбрасыванием дробной части).
+    template<Scalar T>
+    static T to_coordinate(double value) {
+        if constexpr (std::integral<T>) {
+            return static_cast<T>(std::llround(value));
+        } else {
+            return static_cast<T>(value);
+        }
+    };
+};
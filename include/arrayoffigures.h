@@ -1,23 +1,60 @@
 #pragma once
 
 #include "figure.h"
+#include <array>
 #include <cstddef>
 #include <iostream>
 #include <initializer_list>
+#include <limits>
 #include <iostream>
 #include <algorithm>
+#include <concepts>
+#include <ranges>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
+#include <span>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "threadpool.h"
+#include "ownership.h"
+#include "instrumentation.h"
+#include "figureaggregates.h"
+#include "spatialorder.h"
+#include "geometricsignature.h"
+#include "unionarea.h"
+#include "collision.h"
+#include "proximity.h"
+#include "convexhull.h"
+#include "clipping.h"
+#include "rasterizer.h"
+#include "kdtree.h"
 
 
 template<class Figure>
 // Концепт проверяет, что Figure - это класс или структура
 concept Arrayable = std::is_class_v<Figure>;
 
-template<Arrayable Figure>
+// Ownership - политика владения фигурами (см. ownership.h): SharedOwnership (std::shared_ptr, по умолчанию)
+// или UniqueOwnership (std::unique_ptr, без атомарных операций со счётчиками ссылок).
+template<Arrayable Figure, class Ownership = SharedOwnership>
 class ArrayOfFigures {
     public:
+        // Типы для совместимости со стандартными алгоритмами и std::ranges.
+        // Указатели на фигуры лежат в одном непрерывном буфере, поэтому в качестве итератора
+        // используется итератор std::span - он является contiguous random-access итератором.
+        using value_type = typename Ownership::template pointer<Figure>;
+        using size_type = size_t;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using iterator = typename std::span<value_type>::iterator;
+        using const_iterator = typename std::span<const value_type>::iterator;
+
         // Конструктор по умолчанию.
         ArrayOfFigures() = default;
         
@@ -25,24 +62,33 @@ class ArrayOfFigures {
         ArrayOfFigures(size_t cap){
             size = 0;
             capacity = (cap == 0) ? 1 : (cap * 2);
-            figures = std::make_shared<std::shared_ptr<Figure>[]>(capacity);
+            figures = Ownership::template allocate<Figure>(capacity);
+            FIGURES_COUNT_N(BytesAllocated, capacity * sizeof(value_type));
             std::fill_n(figures.get(), capacity, nullptr);
         };
 
         // Конструктор с инициализацией из initializer списка в котором фигуры.
-        ArrayOfFigures(std::initializer_list<std::shared_ptr<Figure>> list) {
+        ArrayOfFigures(std::initializer_list<value_type> list) {
             size = list.size();
             capacity = (size == 0) ? 1 : (size * 2);
-            figures = std::make_shared<std::shared_ptr<Figure>[]>(capacity);
+            figures = Ownership::template allocate<Figure>(capacity);
+            FIGURES_COUNT_N(BytesAllocated, capacity * sizeof(value_type));
             std::fill_n(figures.get(), capacity, nullptr);
             // Глубокое копирование указателей из списка в массив.
-            std::transform(list.begin(), list.end(), figures,
-                        [](Figure* fig) { return (fig ? fig->clone() : nullptr); });
+            std::transform(list.begin(), list.end(), figures.get(),
+                        [](const value_type& fig) { return (fig ? Ownership::clone(*fig) : nullptr); });
+            recompute_totals();
         };
 
         // Конструктор перемещения.
         ArrayOfFigures(ArrayOfFigures&& other) noexcept
-            : figures(other.figures), size(other.size), capacity(other.capacity) {
+            : figures(std::move(other.figures)), size(other.size), capacity(other.capacity), pool(std::move(other.pool)),
+              totals(other.totals), pending(std::move(other.pending)), pending_slot(std::move(other.pending_slot)),
+              totals_stale(other.totals_stale) {
+            other.totals.clear();
+            other.pending.clear();
+            other.pending_slot.clear();
+            other.totals_stale = false;
             other.figures.reset();
             other.size = 0;
             other.capacity = 0;
@@ -53,10 +99,13 @@ class ArrayOfFigures {
         ArrayOfFigures(const ArrayOfFigures& other) {
             size = other.size;
             capacity = other.capacity;
-            figures = std::make_shared<std::shared_ptr<Figure>[]>(capacity);
+            pool = other.pool;
+            copy_totals_from(other);
+            figures = Ownership::template allocate<Figure>(capacity);
+            FIGURES_COUNT_N(BytesAllocated, capacity * sizeof(value_type));
             std::fill_n(figures.get(), capacity, nullptr);
             for (size_t i = 0; i < size; ++i) {
-                figures[i] = other.figures[i] ? other.figures[i]->clone() : nullptr;
+                figures[i] = other.figures[i] ? Ownership::clone(*other.figures[i]) : nullptr;
             }
         };
 
@@ -71,15 +120,24 @@ class ArrayOfFigures {
         // Оператор перемещения.
         ArrayOfFigures& operator=(ArrayOfFigures&& other) noexcept {
             if (this == &other) return *this;
-            // Удаляем только сам массив, так как shared_ptr сам управляет памятью под фигуры.
+            // Удаляем только сам массив, так как умные указатели сами управляют памятью под фигуры.
             figures.reset();
 
             // Перемещаем ресурсы из другого объекта.
-            figures = other.figures;
+            figures = std::move(other.figures);
             size = other.size;
             capacity = other.capacity;
+            pool = std::move(other.pool);
+            totals = other.totals;
+            pending = std::move(other.pending);
+            pending_slot = std::move(other.pending_slot);
+            totals_stale = other.totals_stale;
 
             // Обнуляем другой объект.
+            other.totals.clear();
+            other.pending.clear();
+            other.pending_slot.clear();
+            other.totals_stale = false;
             other.figures.reset();
             other.size = 0;
             other.capacity = 0;
@@ -88,15 +146,74 @@ class ArrayOfFigures {
 
         // Деструктор.
         ~ArrayOfFigures() {
-            figures.reset(); // shared_ptr автоматически освободит память под фигуры и массив.
+            figures.reset(); // Умный указатель автоматически освободит память под фигуры и массив.
         };
 
         // Функция для добавления фигуры в массив.
-        void add_figure(std::shared_ptr<Figure> figure) {
+        // Указатель принимается по значению и перемещается в массив, поэтому при передаче временного объекта
+        // или std::move счётчик ссылок shared_ptr не изменяется.
+        void add_figure(value_type figure) {
             if (size >= capacity) {
                 resize();
             }
-            figures[size++] = figure;
+            append_unchecked(std::move(figure));
+        };
+
+        // Создание фигуры вида Kind прямо в массиве: аргументы передаются конструктору фигуры,
+        // объект создаётся политикой владения (для shared_ptr - одним выделением памяти вместе со счётчиком).
+        // Возвращает ссылку на созданную фигуру.
+        template<class Kind = Figure, class... Args>
+        requires std::derived_from<Kind, Figure>
+        Kind& emplace_figure(Args&&... args) {
+            auto figure = Ownership::template make<Kind>(std::forward<Args>(args)...);
+            Kind& created = *figure;
+            add_figure(std::move(figure));
+            return created;
+        };
+
+        // Добавление набора фигур. Для диапазонов известного размера ёмкость увеличивается один раз.
+        // Элементы lvalue-диапазона копируются (для SharedOwnership - разделяются с вызывающим кодом),
+        // элементы владеющего rvalue-диапазона (например, std::move(vector)) перемещаются в массив.
+        // Представления над чужими контейнерами (borrowed_range) всегда копируются.
+        template<std::ranges::input_range R>
+        requires std::constructible_from<value_type, std::ranges::range_reference_t<R>> ||
+                 std::constructible_from<value_type, std::ranges::range_rvalue_reference_t<R>>
+        void add_figures(R&& range) {
+            if constexpr (std::ranges::sized_range<R>) {
+                reserve(size + static_cast<size_t>(std::ranges::size(range)));
+            }
+            for (auto&& figure : range) {
+                if (size >= capacity) {
+                    resize();
+                }
+                if constexpr (std::is_lvalue_reference_v<R> || std::ranges::borrowed_range<R>) {
+                    append_unchecked(value_type(figure));
+                } else {
+                    append_unchecked(value_type(std::move(figure)));
+                }
+            }
+        };
+
+        // Резервирование ёмкости не меньше new_capacity (одно перераспределение буфера).
+        void reserve(size_t new_capacity) {
+            if (new_capacity > capacity) {
+                reallocate(new_capacity);
+            }
+        };
+
+        // Замена фигуры по индексу с обновлением агрегатов за O(1).
+        void replace_figure(size_t index, value_type figure) {
+            if (index >= size) {
+                throw std::out_of_range("Index out of range");
+            }
+            if (!totals_stale) {
+                apply_pending();
+                totals.remove(contribution(index));
+                if (figure) {
+                    totals.add(FigureContribution::of(*figure));
+                }
+            }
+            figures[index] = std::move(figure);
         };
         
 
@@ -105,31 +222,106 @@ class ArrayOfFigures {
         // Возвращаемый тип - указатель на Figure (не const), чтобы можно было изменять фигуры.
         // Возвращаем ссылку на указатель, чтобы можно было изменять указатель в массиве (например, присваивать новый объект).
         // Это увеличивает счётчик ссылок, так как возвращаем shared_ptr по ссылке.
-        std::shared_ptr<Figure>& operator[](size_t index){
+        // Через ссылку фигуру можно заменить или изменить, поэтому вклад ячейки в агрегаты запоминается
+        // и сверяется с её содержимым при следующем чтении агрегатов.
+        value_type& operator[](size_t index){
         if (index >= size) {
                 throw std::out_of_range("Index out of range");
             }
+            remember_slot(index);
             return figures[index];
         };
         
         // Const версия оператора индексации.
         // Возвращает копию указателя на Figure, чтобы предотвратить изменение фигур.
         // Не увеличиваем счетчик ссылок, так как возвращаем ссылку на существующий shared_ptr.
-        const std::shared_ptr<Figure>& operator[](size_t index) const{
+        const value_type& operator[](size_t index) const{
             if (index >= size) {
                 throw std::out_of_range("Index out of range");
             }
             return figures[index];
         };
 
+        // Доступ к фигуре без проверки границ.
+        // Предназначен для горячих циклов, где индекс уже гарантированно корректен (например, i < get_size()).
+        // При выходе за границы поведение не определено.
+        // Неконстантные версии доступа к буферу (get_unchecked, data, as_span, итераторы) не отслеживают
+        // изменения отдельных ячеек: агрегаты будут полностью пересчитаны при следующем чтении.
+        value_type& get_unchecked(size_t index) noexcept {
+            totals_stale = true;
+            return figures[index];
+        };
+
+        const value_type& get_unchecked(size_t index) const noexcept {
+            return figures[index];
+        };
+
+        // Указатель на начало непрерывного буфера фигур (nullptr для пустого массива без буфера).
+        value_type* data() noexcept {
+            totals_stale = true;
+            return figures.get();
+        };
+
+        const value_type* data() const noexcept {
+            return figures.get();
+        };
+
+        // Представление занятой части массива в виде std::span.
+        // Span остаётся валидным до ближайшего изменения размера массива (add_figure, remove_figure).
+        std::span<value_type> as_span() noexcept {
+            totals_stale = true;
+            return std::span<value_type>(figures.get(), size);
+        };
+
+        std::span<const value_type> as_span() const noexcept {
+            return std::span<const value_type>(figures.get(), size);
+        };
+
+        // Итераторы по занятой части массива.
+        // Позволяют использовать range-for, std::ranges и параллельные алгоритмы
+        // (например, std::for_each(std::execution::par_unseq, arr.begin(), arr.end(), ...)).
+        iterator begin() noexcept {
+            return as_span().begin();
+        };
+
+        iterator end() noexcept {
+            return as_span().end();
+        };
+
+        const_iterator begin() const noexcept {
+            return as_span().begin();
+        };
+
+        const_iterator end() const noexcept {
+            return as_span().end();
+        };
+
+        const_iterator cbegin() const noexcept {
+            return begin();
+        };
+
+        const_iterator cend() const noexcept {
+            return end();
+        };
+
+        // Проверка на пустоту массива.
+        bool empty() const noexcept {
+            return size == 0;
+        };
+
         // Функция для удаления фигуры из массива по индексу.
         void remove_figure(size_t index) {
             if (index >= size) {
                 throw std::out_of_range("Index out of range");
             }
-            figures[index].reset(); // Освобождение shared_ptr.
+            if (!totals_stale) {
+                // Отложенные сверки ссылаются на индексы, которые сейчас сдвинутся.
+                apply_pending();
+                totals.remove(contribution(index));
+            }
+            figures[index].reset(); // Освобождение указателя.
             for (size_t i = index; i < size - 1; ++i) {
-                figures[i] = figures[i + 1]; // Сдвиг элементов влево.
+                figures[i] = std::move(figures[i + 1]); // Сдвиг элементов влево перемещением.
             }
             --size;
             if (size >= 0) figures[size] = nullptr; // Обнуляем последний элемент.
@@ -147,43 +339,711 @@ class ArrayOfFigures {
 
         // Функция для вывода всех фигур в массиве.
         void print_figures(std::ostream& os) const {
-            for (size_t i = 0; i < size; ++i) {
-                if (figures[i]) {
-                    os << *figures[i] << std::endl;
+            FIGURES_MEASURE_LATENCY(PrintFigures);
+            for (const auto& figure : *this) {
+                if (figure) {
+                    os << *figure << std::endl;
                 }
             }
         };
 
         // Функция для нахождения общей площади всех фигур в массиве.
         double total_square() const{
+            FIGURES_MEASURE_LATENCY(TotalSquare);
             double total = 0.0;
-            for (size_t i = 0; i < size; ++i) {
-                if (figures[i]) {
+            for (const auto& figure : *this) {
+                if (figure) {
                     // Используется неявное преобразование к double через перегруженный оператор.
-                    // total += *figures[i]; Так тодже работает, но ниже будет быолее явно, с помощью функции square().
-                    total += figures[i]->square();
+                    // total += *figure; Так тодже работает, но ниже будет быолее явно, с помощью функции square().
+                    total += figure->square();
                 }
             }
             return total;
         };
 
+        // Количество фигур каждого вида (индекс - static_cast<size_t>(FigureKind)).
+        // Берётся из агрегатов, без просмотра массива.
+        std::array<size_t, FIGURE_KIND_COUNT> count_by_kind() const {
+            return aggregates().get_counts_by_kind();
+        };
+
+        // Агрегаты массива (количество по видам, суммарные площадь и периметр, сумма центров, общий прямоугольник).
+        // Поддерживаются при add_figure, remove_figure, replace_figure и присваивании через operator[],
+        // поэтому чтение выполняется за O(1) (плюс сверка ячеек, выданных через operator[] с прошлого чтения).
+        // Изменения фигур в обход массива (через внешние копии shared_ptr или константный доступ) не отслеживаются -
+        // после них нужно вызвать refresh_aggregates(). Чтение агрегатов не потокобезопасно.
+        const FigureAggregates& aggregates() const {
+            sync_totals();
+            return totals;
+        };
+
+        double total_area() const {
+            return aggregates().get_total_area();
+        };
+
+        double total_perimeter() const {
+            return aggregates().get_total_perimeter();
+        };
+
+        BoundingBox<double> bounding_box() const {
+            return aggregates().get_bounding_box();
+        };
+
+        // Полный пересчёт агрегатов.
+        void refresh_aggregates() {
+            recompute_totals();
+        };
+
+        // Пул потоков для параллельных операций над массивом.
+        // По умолчанию используется общий пул ThreadPool::global(); nullptr возвращает массив к общему пулу.
+        // Копии массива используют тот же пул.
+        void set_thread_pool(std::shared_ptr<ThreadPool> thread_pool) {
+            pool = std::move(thread_pool);
+        };
+
+        ThreadPool& get_thread_pool() const {
+            return pool ? *pool : ThreadPool::global();
+        };
+
+        // Параллельные версии массовых операций. Массив делится на части по PARALLEL_GRAIN фигур,
+        // которые выполняются задачами пула потоков. Во время выполнения массив не должен изменяться.
+
+        // Параллельное вычисление общей площади. Результат не зависит от количества потоков.
+        double parallel_total_square() const {
+            FIGURES_MEASURE_LATENCY(ParallelTotalSquare);
+            return get_thread_pool().parallel_reduce(0, size, PARALLEL_GRAIN, 0.0,
+                [this](size_t lo, size_t hi) {
+                    double total = 0.0;
+                    for (size_t i = lo; i < hi; ++i) {
+                        if (figures[i]) {
+                            total += figures[i]->square();
+                        }
+                    }
+                    return total;
+                },
+                [](double a, double b) { return a + b; });
+        };
+
+        // Контуры всех фигур в одном непрерывном буфере (обход против часовой стрелки).
+        PolygonSet polygons() const {
+            PolygonSet result;
+            size_t vertices = 0;
+            for (size_t i = 0; i < size; ++i) {
+                vertices += figures[i] ? figures[i]->vertex_count() : 0;
+            }
+            result.reserve(size, vertices);
+            for (size_t i = 0; i < size; ++i) {
+                if (figures[i]) {
+                    result.add(figures[i]->vertices());
+                }
+            }
+            return result;
+        };
+
+        // Площадь, покрытая фигурами (площадь объединения: в отличие от total_square(),
+        // перекрывающиеся части считаются один раз). См. UnionArea.
+        double covered_area() const {
+            return UnionArea::compute(polygons(), get_thread_pool(), std::max<size_t>(size, 1));
+        };
+
+        // Параллельное вычисление покрытой площади. Результат не зависит от количества потоков.
+        double parallel_covered_area() const {
+            return UnionArea::compute(polygons(), get_thread_pool(), PARALLEL_GRAIN);
+        };
+
+        // Все пары пересекающихся фигур (касание тоже считается пересечением), first < second.
+        // Широкая фаза - заметание по ограничивающим прямоугольникам (см. sweep_and_prune), узкая - точная проверка
+        // выпуклых многоугольников по разделяющей оси (SAT). Пустые ячейки пропускаются. Пары идут в порядке заметания.
+        std::vector<CollisionPair> find_collisions() const {
+            return collisions(false);
+        };
+
+        // Параллельный поиск пересекающихся фигур: полосы заметания обрабатываются задачами пула.
+        // Результат совпадает с find_collisions().
+        std::vector<CollisionPair> parallel_find_collisions() const {
+            return collisions(true);
+        };
+
+        // Пакетные запросы близости: одна подготовленная фигура probe против всех фигур массива (параллельно).
+
+        // Расстояния от probe до каждой фигуры (0 для пересекающихся, NaN для пустых ячеек).
+        template<Scalar T>
+        std::vector<double> distances_to(const ConvexProbe<T>& probe) const {
+            std::vector<double> result(size, std::numeric_limits<double>::quiet_NaN());
+            get_thread_pool().parallel_for(0, size, PARALLEL_GRAIN, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) {
+                    if (figures[i]) {
+                        result[i] = probe.distance(figures[i]->vertices());
+                    }
+                }
+            });
+            return result;
+        };
+
+        // Индексы фигур на расстоянии не больше radius от probe, по возрастанию.
+        // Фигуры, чей прямоугольник дальше radius, отбрасываются без точной проверки.
+        template<Scalar T>
+        std::vector<size_t> within_distance(const ConvexProbe<T>& probe, double radius) const {
+            return get_thread_pool().parallel_reduce(0, size, PARALLEL_GRAIN, std::vector<size_t>{},
+                [&](size_t lo, size_t hi) {
+                    std::vector<size_t> near;
+                    for (size_t i = lo; i < hi; ++i) {
+                        if (figures[i] && probe.get_bounding_box().distance(FigureContribution::box_of(*figures[i])) <= radius &&
+                            probe.distance(figures[i]->vertices()) <= radius) {
+                            near.push_back(i);
+                        }
+                    }
+                    return near;
+                },
+                [](std::vector<size_t> a, std::vector<size_t> b) {
+                    a.insert(a.end(), b.begin(), b.end());
+                    return a;
+                });
+        };
+
+        // Фигуры, пересекающиеся с probe, и глубина проникновения каждой из них, по возрастанию индекса.
+        template<Scalar T>
+        std::vector<std::pair<size_t, Penetration>> penetrations(const ConvexProbe<T>& probe) const {
+            return get_thread_pool().parallel_reduce(0, size, PARALLEL_GRAIN, std::vector<std::pair<size_t, Penetration>>{},
+                [&](size_t lo, size_t hi) {
+                    std::vector<std::pair<size_t, Penetration>> hits;
+                    for (size_t i = lo; i < hi; ++i) {
+                        if (figures[i] && probe.get_bounding_box().intersects(FigureContribution::box_of(*figures[i]))) {
+                            if (auto penetration = probe.penetration(figures[i]->vertices())) {
+                                hits.emplace_back(i, *penetration);
+                            }
+                        }
+                    }
+                    return hits;
+                },
+                [](std::vector<std::pair<size_t, Penetration>> a, std::vector<std::pair<size_t, Penetration>> b) {
+                    a.insert(a.end(), b.begin(), b.end());
+                    return a;
+                });
+        };
+
+        // Отсечение всех фигур окном window (алгоритм Сазерленда-Ходжмана) в один непрерывный буфер многоугольников
+        // по возрастанию индекса фигуры. Фигуры сначала классифицируются по ограничивающему прямоугольнику:
+        // лежащие целиком внутри копируются, лежащие снаружи и пустые ячейки пропускаются, и только
+        // пересекающие границу окна отсекаются. Части массива обрабатываются задачами пула.
+        ClippedPolygons clip(const BoundingBox<double>& window) const {
+            if (window.is_empty()) {
+                throw std::invalid_argument("Clip window must not be empty.");
+            }
+            return get_thread_pool().parallel_reduce(0, size, PARALLEL_GRAIN, ClippedPolygons{},
+                [&](size_t lo, size_t hi) {
+                    ClippedPolygons part;
+                    std::vector<Point<double>> current;
+                    std::vector<Point<double>> next;
+                    for (size_t i = lo; i < hi; ++i) {
+                        if (!figures[i]) {
+                            continue;
+                        }
+                        switch (classify(FigureContribution::box_of(*figures[i]), window)) {
+                            case ClipClass::Inside:
+                                part.add(figures[i]->vertices(), i);
+                                break;
+                            case ClipClass::Boundary:
+                                sutherland_hodgman(figures[i]->vertices(), window, current, next);
+                                part.add(std::span<const Point<double>>(current), i);
+                                break;
+                            case ClipClass::Outside:
+                                break;
+                        }
+                    }
+                    return part;
+                },
+                [](ClippedPolygons a, ClippedPolygons b) {
+                    if (a.size() == 0) {
+                        return b;
+                    }
+                    a.append(b);
+                    return a;
+                });
+        };
+
+        // Растеризация всех фигур в сетку пользователя на месте (см. RasterMode и rasterize_polygons):
+        // строки сетки делятся на полосы, каждая полоса рисуется задачей пула. Пустые ячейки пропускаются.
+        template<class Cell>
+        void rasterize(const RasterGrid<Cell>& grid, RasterMode mode) const {
+            std::vector<BoundingBox<double>> boxes(size);
+            get_thread_pool().parallel_for(0, size, PARALLEL_GRAIN, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) {
+                    if (figures[i]) {
+                        boxes[i] = FigureContribution::box_of(*figures[i]);
+                    }
+                }
+            });
+            rasterize_polygons(get_thread_pool(), grid, mode, std::span<const BoundingBox<double>>(boxes),
+                               [this](size_t i) { return figures[i]->vertices(); });
+        };
+
+        // Пакетная проверка точек по всей коллекции: out[i] = 1, если points[i] лежит хотя бы в одной фигуре.
+        // Полуплоскости фигур вычисляются один раз, точки отсекаются по общему прямоугольнику и прямоугольникам
+        // фигур своей ячейки сетки (см. ConvexRegionIndex). Точки обрабатываются частями задачами пула.
+        template<Scalar T>
+        void contains_batch(std::span<const Point<T>> points, std::span<std::uint8_t> out) const {
+            if (out.size() != points.size()) {
+                throw std::invalid_argument("Output size must match the number of points.");
+            }
+            std::vector<HalfPlanes<MAX_HALF_PLANES>> regions;
+            regions.reserve(size);
+            for (size_t i = 0; i < size; ++i) {
+                if (figures[i]) {
+                    regions.push_back(HalfPlanes<MAX_HALF_PLANES>::of(figures[i]->vertices()));
+                }
+            }
+            const ConvexRegionIndex index(std::move(regions));
+            get_thread_pool().parallel_for(0, points.size(), PARALLEL_GRAIN * 16, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) {
+                    out[i] = index.contains(static_cast<double>(points[i].get_x()), static_cast<double>(points[i].get_y()));
+                }
+            });
+        };
+
+        // Выпуклая оболочка вершин всех фигур (против часовой стрелки, без точек на сторонах; см. monotone_chain).
+        // Части массива по PARALLEL_GRAIN * 16 фигур обрабатываются задачами пула: вершины читаются прямо из
+        // хранилища фигур через vertices() (один виртуальный вызов на фигуру), точки внутри крайних отбрасываются,
+        // оболочки частей объединяются в конце. Пустые ячейки пропускаются.
+        auto convex_hull() const {
+            using PointType = std::ranges::range_value_t<decltype(std::declval<const Figure&>().vertices())>;
+            using Coordinate = std::remove_cvref_t<decltype(std::declval<const PointType&>().get_x())>;
+            return parallel_convex_hull<Coordinate>(get_thread_pool(), size, PARALLEL_GRAIN * 16, [this](size_t lo, size_t hi, auto&& visit) {
+                for (size_t i = lo; i < hi; ++i) {
+                    if (figures[i]) {
+                        for (const auto& vertex : figures[i]->vertices()) {
+                            visit(vertex);
+                        }
+                    }
+                }
+            });
+        };
+
+        // Параллельная проверка фигур. Возвращает индексы фигур, не прошедших проверку is_valid(), по возрастанию.
+        std::vector<size_t> find_invalid() const {
+            return get_thread_pool().parallel_reduce(0, size, PARALLEL_GRAIN, std::vector<size_t>{},
+                [this](size_t lo, size_t hi) {
+                    std::vector<size_t> invalid;
+                    for (size_t i = lo; i < hi; ++i) {
+                        if (figures[i] && !figures[i]->is_valid()) {
+                            invalid.push_back(i);
+                        }
+                    }
+                    return invalid;
+                },
+                [](std::vector<size_t> a, std::vector<size_t> b) {
+                    a.insert(a.end(), b.begin(), b.end());
+                    return a;
+                });
+        };
+
+        // Параллельное вычисление геометрических центров всех фигур (для пустых ячеек - точка по умолчанию).
+        auto centroids() const {
+            using CenterPoint = std::remove_cvref_t<decltype(*std::declval<const Figure&>().geometric_center())>;
+            std::vector<CenterPoint> centers(size);
+            get_thread_pool().parallel_for(0, size, PARALLEL_GRAIN, [this, &centers](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) {
+                    if (figures[i]) {
+                        centers[i] = *figures[i]->geometric_center();
+                    }
+                }
+            });
+            return centers;
+        };
+
+        // k ближайших соседей каждой фигуры по геометрическим центрам (см. KdTree). Строка i результата -
+        // элементы [i * k, (i + 1) * k) - соседи фигуры i (номера - индексы в массиве) по возрастанию расстояния.
+        // Для пустых ячеек и при нехватке фигур строка дополняется Neighbour{}.
+        std::vector<Neighbour> nearest_neighbours(size_t k) const {
+            auto [points, slots] = occupied_centroids();
+            const KdTree tree(points, get_thread_pool());
+            std::vector<Neighbour> rows = tree.all_nearest(k, get_thread_pool(), PARALLEL_GRAIN);
+            std::vector<Neighbour> result(size * k);
+            get_thread_pool().parallel_for(0, slots.size(), PARALLEL_GRAIN, [&](size_t lo, size_t hi) {
+                for (size_t p = lo; p < hi; ++p) {
+                    for (size_t j = 0; j < k; ++j) {
+                        Neighbour neighbour = rows[p * k + j];
+                        if (neighbour.index != Neighbour::NONE) {
+                            neighbour.index = slots[neighbour.index];
+                        }
+                        result[slots[p] * k + j] = neighbour;
+                    }
+                }
+            });
+            return result;
+        };
+
+        // Две фигуры с ближайшими геометрическими центрами (индексы в массиве, first < second) за O(n log n).
+        // std::nullopt, если непустых фигур меньше двух.
+        std::optional<ClosestPair> closest_pair() const {
+            auto [points, slots] = occupied_centroids();
+            auto pair = ::closest_pair(points);
+            if (pair) {
+                pair->first = slots[pair->first];
+                pair->second = slots[pair->second];
+            }
+            return pair;
+        };
+
+        // Параллельное глубокое копирование массива. Результат использует тот же пул потоков.
+        ArrayOfFigures clone_all() const {
+            ArrayOfFigures result(size);
+            result.pool = pool;
+            get_thread_pool().parallel_for(0, size, PARALLEL_GRAIN, [this, &result](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) {
+                    if (figures[i]) {
+                        result.figures[i] = Ownership::clone(*figures[i]);
+                    }
+                }
+            });
+            result.size = size;
+            result.copy_totals_from(*this);
+            return result;
+        };
+
+        // Параллельная печать фигур в текстовые буферы: буфер k содержит вывод фигур
+        // с индексами [k * PARALLEL_GRAIN, (k + 1) * PARALLEL_GRAIN). Буферы можно последовательно записать в поток.
+        std::vector<std::string> print_to_buffers() const {
+            std::vector<std::string> buffers((size + PARALLEL_GRAIN - 1) / PARALLEL_GRAIN);
+            get_thread_pool().parallel_for(0, buffers.size(), 1, [this, &buffers](size_t first, size_t last) {
+                for (size_t block = first; block < last; ++block) {
+                    std::ostringstream oss;
+                    size_t hi = std::min(size, (block + 1) * PARALLEL_GRAIN);
+                    for (size_t i = block * PARALLEL_GRAIN; i < hi; ++i) {
+                        if (figures[i]) {
+                            oss << *figures[i] << std::endl;
+                        }
+                    }
+                    buffers[block] = std::move(oss).str();
+                }
+            });
+            return buffers;
+        };
+
+        // Применение преобразования подобия matrix ко всем фигурам (параллельно для больших массивов).
+        // Матрица проверяется один раз до изменения фигур, поэтому при ошибке массив остаётся прежним.
+        // Агрегаты пересчитываются аналитически для фигур с вещественными координатами; для целочисленных
+        // координат вершины округляются, и агрегаты пересчитываются полностью при следующем чтении.
+        // Каждая фигура преобразуется ровно один раз, даже если на неё ссылаются несколько ячеек
+        // (SharedOwnership, например после share_duplicates): такие фигуры собираются в список различных объектов.
+        void transform_all(const Affine2D& matrix) {
+            matrix.require_similarity();
+            using Coordinate = decltype(std::declval<const Figure&>().vertex(0).get_x());
+            if (!totals_stale) {
+                apply_pending();
+            }
+            std::vector<Figure*> targets;
+            targets.reserve(size);
+            bool aliased = false;
+            for (size_t i = 0; i < size; ++i) {
+                if (figures[i]) {
+                    targets.push_back(figures[i].get());
+                    if constexpr (std::same_as<Ownership, SharedOwnership>) {
+                        aliased |= figures[i].use_count() > 1;
+                    }
+                }
+            }
+            // Счётчик ссылок больше 1 - признак возможного разделения фигуры между ячейками (или с внешним кодом).
+            if (aliased) {
+                std::sort(targets.begin(), targets.end());
+                targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+            }
+            get_thread_pool().parallel_for(0, targets.size(), PARALLEL_GRAIN, [&targets, &matrix](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) {
+                    targets[i]->transform_unchecked(matrix);
+                }
+            });
+            if constexpr (std::floating_point<std::remove_cvref_t<Coordinate>>) {
+                if (!totals_stale) {
+                    totals.transform(matrix);
+                }
+            } else {
+                totals_stale = true;
+            }
+        };
+
+        // Упорядочивание фигур вдоль кривой, заполняющей плоскость, по их геометрическим центрам.
+        // Центры приводятся к сетке 2^16 x 2^16 внутри их общего прямоугольника, ключи сортируются
+        // параллельной поразрядной сортировкой (фигуры с одинаковым ключом сохраняют взаимный порядок).
+        // Пустые ячейки переносятся в конец. Агрегаты от перестановки не меняются.
+        void reorder_spatially(SpaceFillingCurve curve = SpaceFillingCurve::Morton) {
+            if (!totals_stale) {
+                apply_pending();
+            }
+            auto centers = centroids();
+            std::vector<size_t> occupied;
+            occupied.reserve(size);
+            BoundingBox<double> box;
+            for (size_t i = 0; i < size; ++i) {
+                if (figures[i]) {
+                    occupied.push_back(i);
+                    box.expand(static_cast<double>(centers[i].get_x()), static_cast<double>(centers[i].get_y()));
+                }
+            }
+            if (occupied.empty()) {
+                return;
+            }
+            const double grid = static_cast<double>(SPATIAL_GRID_MAX);
+            const double scale_x = box.width() > 0.0 ? grid / box.width() : 0.0;
+            const double scale_y = box.height() > 0.0 ? grid / box.height() : 0.0;
+            std::vector<SpatialKey> keys(occupied.size());
+            get_thread_pool().parallel_for(0, keys.size(), PARALLEL_GRAIN, [&](size_t lo, size_t hi) {
+                for (size_t k = lo; k < hi; ++k) {
+                    const auto& center = centers[occupied[k]];
+                    double x = (static_cast<double>(center.get_x()) - box.min_x) * scale_x;
+                    double y = (static_cast<double>(center.get_y()) - box.min_y) * scale_y;
+                    auto cell_x = static_cast<std::uint32_t>(std::clamp(x, 0.0, grid));
+                    auto cell_y = static_cast<std::uint32_t>(std::clamp(y, 0.0, grid));
+                    keys[k] = SpatialKey{space_filling_key(curve, cell_x, cell_y), occupied[k]};
+                }
+            });
+            parallel_radix_sort(get_thread_pool(), keys, PARALLEL_GRAIN * 16);
+
+            // Перестановка указателей через временный буфер (счётчики ссылок не меняются).
+            std::vector<value_type> ordered(keys.size());
+            get_thread_pool().parallel_for(0, keys.size(), PARALLEL_GRAIN, [&](size_t lo, size_t hi) {
+                for (size_t k = lo; k < hi; ++k) {
+                    ordered[k] = std::move(figures[keys[k].index]);
+                }
+            });
+            for (size_t k = 0; k < ordered.size(); ++k) {
+                figures[k] = std::move(ordered[k]);
+            }
+            for (size_t i = ordered.size(); i < size; ++i) {
+                figures[i] = nullptr;
+            }
+        };
+
+        // Геометрические сигнатуры всех фигур (параллельно). Для пустых ячеек - сигнатура по умолчанию.
+        std::vector<GeometricSignature> signatures(DeduplicationMode mode = DeduplicationMode::Identical, double quantum = 1e-6) const {
+            std::vector<GeometricSignature> result(size);
+            get_thread_pool().parallel_for(0, size, PARALLEL_GRAIN, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) {
+                    if (figures[i]) {
+                        result[i] = GeometricSignature::of(*figures[i], mode, quantum);
+                    }
+                }
+            });
+            return result;
+        };
+
+        // Удаление дубликатов: остаётся первая фигура каждой сигнатуры, порядок оставшихся сохраняется.
+        // Сигнатуры вычисляются параллельно, поиск повторов - по хеш-таблице за ожидаемое O(n).
+        // Пустые ячейки не удаляются. Пользовательские описания фигур не учитываются. Возвращает количество удалённых фигур.
+        size_t deduplicate(DeduplicationMode mode = DeduplicationMode::Identical, double quantum = 1e-6) {
+            auto keys = signatures(mode, quantum);
+            if (!totals_stale) {
+                apply_pending();
+            }
+            std::unordered_set<GeometricSignature> seen;
+            seen.reserve(size);
+            size_t kept = 0;
+            for (size_t i = 0; i < size; ++i) {
+                if (figures[i] && !seen.insert(keys[i]).second) {
+                    if (!totals_stale) {
+                        totals.remove(contribution(i));
+                    }
+                    figures[i] = nullptr;
+                    continue;
+                }
+                if (kept != i) {
+                    figures[kept] = std::move(figures[i]);
+                }
+                ++kept;
+            }
+            size_t removed = size - kept;
+            for (size_t i = kept; i < size; ++i) {
+                figures[i] = nullptr;
+            }
+            size = kept;
+            return removed;
+        };
+
+        // Разделение памяти между совпадающими фигурами (DeduplicationMode::Identical): ячейки с повторной
+        // фигурой начинают указывать на первую такую фигуру, копии освобождаются, если на них нет внешних ссылок.
+        // Количество и порядок ячеек не меняются. Конгруэнтные фигуры на разных местах так разделить нельзя:
+        // фигура хранит абсолютные координаты вершин. После разделения ячейки ссылаются на общие фигуры,
+        // поэтому изменение фигуры через одну ячейку видно во всех (transform_all преобразует общую фигуру один раз).
+        // Возвращает количество ячеек, перенаправленных на общую фигуру.
+        size_t share_duplicates(double quantum = 1e-6) requires std::same_as<Ownership, SharedOwnership> {
+            auto keys = signatures(DeduplicationMode::Identical, quantum);
+            if (!totals_stale) {
+                apply_pending();
+            }
+            std::unordered_map<GeometricSignature, size_t> first;
+            first.reserve(size);
+            size_t shared = 0;
+            for (size_t i = 0; i < size; ++i) {
+                if (!figures[i]) {
+                    continue;
+                }
+                auto [it, inserted] = first.try_emplace(keys[i], i);
+                if (inserted || figures[it->second] == figures[i]) {
+                    continue;
+                }
+                if (!totals_stale) {
+                    totals.remove(contribution(i));
+                }
+                figures[i] = figures[it->second];
+                if (!totals_stale) {
+                    totals.add(contribution(i));
+                }
+                ++shared;
+            }
+            return shared;
+        };
+
+        // Количество фигур в одной задаче параллельных операций.
+        static constexpr size_t PARALLEL_GRAIN = 256;
+
     private:
         // Динамический массив указателей на фигуры.
-        std::shared_ptr<std::shared_ptr<Figure>[]> figures{nullptr};
+        typename Ownership::template buffer<Figure> figures{nullptr};
         // Текущий размер массива.
         size_t size{0};
         // Текущая емкость массива.
         size_t capacity{0};
+        // Пул потоков для параллельных операций (nullptr - общий пул).
+        std::shared_ptr<ThreadPool> pool{nullptr};
+        // Агрегаты массива. Изменяются и из константных методов (отложенная сверка и пересчёт).
+        mutable FigureAggregates totals;
+        // Ячейки, выданные через неконстантный operator[], и их вклад в агрегаты на момент выдачи.
+        mutable std::vector<std::pair<size_t, FigureContribution>> pending;
+        // Отметки ячеек, уже записанных в pending.
+        mutable std::vector<bool> pending_slot;
+        // Агрегаты требуют полного пересчёта (был выдан неконстантный доступ ко всему буферу).
+        mutable bool totals_stale{false};
+
+        // Добавление в конец без проверки ёмкости (вызывающий гарантирует size < capacity).
+        void append_unchecked(value_type figure) {
+            if (figure && !totals_stale) {
+                totals.add(FigureContribution::of(*figure));
+            }
+            figures[size++] = std::move(figure);
+        };
+
+        FigureContribution contribution(size_t index) const {
+            return figures[index] ? FigureContribution::of(*figures[index]) : FigureContribution{};
+        };
+
+        // Запоминание вклада ячейки перед выдачей ссылки на неё.
+        void remember_slot(size_t index) {
+            if (totals_stale) {
+                return;
+            }
+            if (pending_slot.size() <= index) {
+                pending_slot.resize(capacity);
+            }
+            if (!pending_slot[index]) {
+                pending_slot[index] = true;
+                pending.emplace_back(index, contribution(index));
+            }
+        };
+
+        // Сверка ячеек, выданных через operator[]: старый вклад вычитается, текущий добавляется.
+        void apply_pending() const {
+            for (const auto& [index, before] : pending) {
+                totals.remove(before);
+                totals.add(contribution(index));
+                pending_slot[index] = false;
+            }
+            pending.clear();
+        };
+
+        void recompute_totals() const {
+            totals.clear();
+            for (size_t i = 0; i < size; ++i) {
+                totals.add(contribution(i));
+            }
+            pending.clear();
+            pending_slot.clear();
+            totals_stale = false;
+        };
+
+        void sync_totals() const {
+            if (totals_stale) {
+                recompute_totals();
+            } else {
+                apply_pending();
+            }
+            if (!totals.has_valid_bounding_box()) {
+                BoundingBox<double> box;
+                for (size_t i = 0; i < size; ++i) {
+                    if (figures[i]) {
+                        box.expand(FigureContribution::box_of(*figures[i]));
+                    }
+                }
+                totals.set_bounding_box(box);
+            }
+        };
+
+        // Геометрические центры непустых фигур в double и индексы их ячеек (по возрастанию).
+        std::pair<std::vector<Point<double>>, std::vector<size_t>> occupied_centroids() const {
+            auto centers = centroids();
+            std::vector<Point<double>> points;
+            std::vector<size_t> slots;
+            points.reserve(size);
+            slots.reserve(size);
+            for (size_t i = 0; i < size; ++i) {
+                if (figures[i]) {
+                    points.emplace_back(static_cast<double>(centers[i].get_x()), static_cast<double>(centers[i].get_y()));
+                    slots.push_back(i);
+                }
+            }
+            return {std::move(points), std::move(slots)};
+        };
+
+        // Поиск пересечений (последовательно или задачами пула).
+        std::vector<CollisionPair> collisions(bool parallel) const {
+            const size_t grain = parallel ? PARALLEL_GRAIN : std::max<size_t>(size, 1);
+            std::vector<SweepEntry> entries(size);
+            std::vector<unsigned char> present(size, 0);
+            get_thread_pool().parallel_for(0, size, grain, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) {
+                    if (figures[i]) {
+                        auto box = figures[i]->bounding_box();
+                        entries[i] = SweepEntry{static_cast<double>(box.min_x), static_cast<double>(box.max_x),
+                                                static_cast<double>(box.min_y), static_cast<double>(box.max_y), i};
+                        present[i] = !box.is_empty();
+                    }
+                }
+            });
+            size_t kept = 0;
+            for (size_t i = 0; i < size; ++i) {
+                if (present[i]) {
+                    entries[kept++] = entries[i];
+                }
+            }
+            entries.resize(kept);
+            return sweep_and_prune(std::span<const SweepEntry>(entries), get_thread_pool(), parallel, [this](size_t i, size_t j) {
+                return convex_polygons_intersect(figures[i]->vertices(), figures[j]->vertices());
+            });
+        };
+
+        void copy_totals_from(const ArrayOfFigures& other) {
+            totals = other.totals;
+            pending = other.pending;
+            pending_slot = other.pending_slot;
+            totals_stale = other.totals_stale;
+        };
         // Функция для изменения размера массива.
         void resize(){
-            capacity = (capacity == 0) ? 1 : capacity * 2;
-            std::shared_ptr<std::shared_ptr<Figure>[]> new_figures = std::make_shared<std::shared_ptr<Figure>[]>(capacity);
+            reallocate((capacity == 0) ? 1 : capacity * 2);
+        };
+
+        // Перенос фигур в новый буфер ёмкостью new_capacity.
+        void reallocate(size_t new_capacity) {
+            capacity = new_capacity;
+            FIGURES_COUNT(ArrayResizes);
+            FIGURES_COUNT_N(BytesAllocated, capacity * sizeof(value_type));
+            auto new_figures = Ownership::template allocate<Figure>(capacity);
             std::fill_n(new_figures.get(), capacity, nullptr);
+            // Элементы перемещаются в новый буфер (без изменения счётчиков ссылок).
             for (size_t i = 0; i < size; ++i) {
-                new_figures[i] = figures[i];
+                new_figures[i] = std::move(figures[i]);
             }
             figures.reset();
-            figures = new_figures;
+            figures = std::move(new_figures);
         };
 
         // Метод для обмена ресурсами между двумя объектами класса ArrayOfFigures.
@@ -191,5 +1051,10 @@ class ArrayOfFigures {
             std::swap(figures, other.figures);
             std::swap(size, other.size);
             std::swap(capacity, other.capacity);
+            std::swap(pool, other.pool);
+            std::swap(totals, other.totals);
+            std::swap(pending, other.pending);
+            std::swap(pending_slot, other.pending_slot);
+            std::swap(totals_stale, other.totals_stale);
         };
 };
\ No newline at end of file
@@ -0,0 +1,161 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <utility>
+
+// Размер строки кэша, по которому выравниваются счётчики очереди, чтобы производители и потребители
+// не делили одну строку кэша (false sharing).
+inline constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+// Статистика ожиданий, накопленная одним потоком при работе с очередью.
+struct QueueWaitStats {
+    // Сколько раз поток не смог сразу положить элемент (очередь полна - сработало обратное давление).
+    std::size_t full_waits{0};
+    // Сколько раз поток не смог сразу достать элемент (очередь пуста).
+    std::size_t empty_waits{0};
+    // Суммарное время ожидания в секундах.
+    double wait_seconds{0.0};
+};
+
+// Ограниченная неблокирующая очередь для нескольких производителей и нескольких потребителей
+// (кольцевой буфер Д. Вьюкова). Ёмкость округляется вверх до степени двойки.
+// try_push/try_pop никогда не блокируются; push/pop ждут (с уступкой процессора), пока операция не станет возможной
+// или очередь не будет закрыта.
+template<class V>
+class BoundedQueue {
+    public:
+        explicit BoundedQueue(std::size_t requested_capacity) {
+            std::size_t cap = 2;
+            while (cap < requested_capacity) {
+                cap *= 2;
+            }
+            mask = cap - 1;
+            buffer = std::make_unique<Cell[]>(cap);
+            for (std::size_t i = 0; i < cap; ++i) {
+                buffer[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        };
+
+        BoundedQueue(const BoundedQueue&) = delete;
+        BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+        // Попытка положить элемент. Возвращает false, если очередь полна (элемент при этом не перемещается).
+        bool try_push(V& value) {
+            std::size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+            for (;;) {
+                Cell& cell = buffer[pos & mask];
+                std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+                if (diff == 0) {
+                    if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        cell.value = std::move(value);
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = enqueue_pos.load(std::memory_order_relaxed);
+                }
+            }
+        };
+
+        // Попытка достать элемент. Возвращает false, если очередь пуста.
+        bool try_pop(V& value) {
+            std::size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+            for (;;) {
+                Cell& cell = buffer[pos & mask];
+                std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+                if (diff == 0) {
+                    if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        value = std::move(cell.value);
+                        cell.sequence.store(pos + mask + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = dequeue_pos.load(std::memory_order_relaxed);
+                }
+            }
+        };
+
+        // Положить элемент, ожидая свободного места. Возвращает false, если очередь закрыта.
+        bool push(V& value, QueueWaitStats& stats) {
+            if (try_push(value)) {
+                return true;
+            }
+            ++stats.full_waits;
+            auto start = std::chrono::steady_clock::now();
+            bool pushed = false;
+            while (!closed.load(std::memory_order_acquire)) {
+                if (try_push(value)) {
+                    pushed = true;
+                    break;
+                }
+                std::this_thread::yield();
+            }
+            stats.wait_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return pushed;
+        };
+
+        // Достать элемент, ожидая его появления. Возвращает false, если очередь закрыта и пуста.
+        bool pop(V& value, QueueWaitStats& stats) {
+            if (try_pop(value)) {
+                return true;
+            }
+            ++stats.empty_waits;
+            auto start = std::chrono::steady_clock::now();
+            bool popped = false;
+            for (;;) {
+                if (try_pop(value)) {
+                    popped = true;
+                    break;
+                }
+                if (closed.load(std::memory_order_acquire)) {
+                    // Элемент мог быть положен непосредственно перед закрытием.
+                    popped = try_pop(value);
+                    break;
+                }
+                std::this_thread::yield();
+            }
+            stats.wait_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return popped;
+        };
+
+        // Закрытие очереди: новые элементы больше не поступят. Потребители дочитывают оставшиеся элементы.
+        void close() {
+            closed.store(true, std::memory_order_release);
+        };
+
+        bool is_closed() const {
+            return closed.load(std::memory_order_acquire);
+        };
+
+        // Приблизительное количество элементов в очереди (точное только при отсутствии параллельных операций).
+        std::size_t approx_size() const {
+            std::size_t head = dequeue_pos.load(std::memory_order_relaxed);
+            std::size_t tail = enqueue_pos.load(std::memory_order_relaxed);
+            return tail > head ? tail - head : 0;
+        };
+
+        std::size_t get_capacity() const {
+            return mask + 1;
+        };
+
+    private:
+        struct Cell {
+            std::atomic<std::size_t> sequence{0};
+            V value{};
+        };
+
+        std::unique_ptr<Cell[]> buffer;
+        std::size_t mask{0};
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> enqueue_pos{0};
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> dequeue_pos{0};
+        alignas(CACHE_LINE_SIZE) std::atomic<bool> closed{false};
+};
@@ -0,0 +1,74 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "point.h"
+
+// Ограничивающий прямоугольник со сторонами, параллельными осям координат.
+// Пустой прямоугольник (ни одной точки) имеет min > max по обеим осям.
+template<Scalar T>
+struct BoundingBox {
+    T min_x{std::numeric_limits<T>::max()};
+    T min_y{std::numeric_limits<T>::max()};
+    T max_x{std::numeric_limits<T>::lowest()};
+    T max_y{std::numeric_limits<T>::lowest()};
+
+    bool is_empty() const {
+        return min_x > max_x || min_y > max_y;
+    };
+
+    // Расширение прямоугольника до точки.
+    void expand(T x, T y) {
+        min_x = std::min(min_x, x);
+        min_y = std::min(min_y, y);
+        max_x = std::max(max_x, x);
+        max_y = std::max(max_y, y);
+    };
+
+    void expand(const Point<T>& point) {
+        expand(point.get_x(), point.get_y());
+    };
+
+    // Расширение прямоугольника до другого прямоугольника (пустой прямоугольник ничего не меняет).
+    void expand(const BoundingBox& other) {
+        if (!other.is_empty()) {
+            expand(other.min_x, other.min_y);
+            expand(other.max_x, other.max_y);
+        }
+    };
+
+    bool contains(T x, T y) const {
+        return x >= min_x && x <= max_x && y >= min_y && y <= max_y;
+    };
+
+    // Пересечение прямоугольников (касание границами тоже считается пересечением).
+    bool intersects(const BoundingBox& other) const {
+        return min_x <= other.max_x && other.min_x <= max_x && min_y <= other.max_y && other.min_y <= max_y;
+    };
+
+    // Лежит ли прямоугольник other внутри этого прямоугольника, касаясь его границы.
+    // Если такой прямоугольник убрать из объединения, объединение может уменьшиться.
+    bool touches_boundary_from_inside(const BoundingBox& other) const {
+        return other.min_x == min_x || other.min_y == min_y || other.max_x == max_x || other.max_y == max_y;
+    };
+
+    // Расстояние между прямоугольниками (0, если они пересекаются). Не больше расстояния между
+    // любыми фигурами, которые они ограничивают.
+    double distance(const BoundingBox& other) const {
+        double dx = std::max({0.0, static_cast<double>(other.min_x) - static_cast<double>(max_x),
+                              static_cast<double>(min_x) - static_cast<double>(other.max_x)});
+        double dy = std::max({0.0, static_cast<double>(other.min_y) - static_cast<double>(max_y),
+                              static_cast<double>(min_y) - static_cast<double>(other.max_y)});
+        return std::hypot(dx, dy);
+    };
+
+    double width() const {
+        return is_empty() ? 0.0 : static_cast<double>(max_x) - static_cast<double>(min_x);
+    };
+
+    double height() const {
+        return is_empty() ? 0.0 : static_cast<double>(max_y) - static_cast<double>(min_y);
+    };
+
+    bool operator==(const BoundingBox& other) const = default;
+};
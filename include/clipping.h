@@ -0,0 +1,138 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+#include "point.h"
+#include "boundingbox.h"
+
+// Положение фигуры относительно окна отсечения, определяемое по её ограничивающему прямоугольнику.
+enum class ClipClass : std::uint8_t {
+    // Прямоугольник фигуры целиком в окне: фигура копируется без отсечения.
+    Inside,
+    // Прямоугольник фигуры не пересекается с окном (или фигура пустая): фигура пропускается.
+    Outside,
+    // Прямоугольник пересекает границу окна: фигура отсекается.
+    Boundary
+};
+
+inline ClipClass classify(const BoundingBox<double>& box, const BoundingBox<double>& window) {
+    if (box.is_empty() || !window.intersects(box)) {
+        return ClipClass::Outside;
+    }
+    if (box.min_x >= window.min_x && box.max_x <= window.max_x && box.min_y >= window.min_y && box.max_y <= window.max_y) {
+        return ClipClass::Inside;
+    }
+    return ClipClass::Boundary;
+}
+
+// Отсечение выпуклого (или любого простого) многоугольника окном алгоритмом Сазерленда-Ходжмана:
+// многоугольник последовательно отсекается четырьмя полуплоскостями сторон окна.
+// Результат остаётся в current; next - рабочий буфер. Буферы переиспользуются между вызовами,
+// поэтому при отсечении многих фигур память выделяется только при росте максимального размера.
+template<Scalar T>
+void sutherland_hodgman(std::span<const Point<T>> polygon, const BoundingBox<double>& window,
+                        std::vector<Point<double>>& current, std::vector<Point<double>>& next) {
+    current.clear();
+    for (const auto& vertex : polygon) {
+        current.emplace_back(static_cast<double>(vertex.get_x()), static_cast<double>(vertex.get_y()));
+    }
+    // Одна полуплоскость: inside(p) - точка внутри, crossing(a, b) - точка пересечения стороны с границей.
+    auto clip = [&](auto inside, auto crossing) {
+        next.clear();
+        const std::size_t n = current.size();
+        for (std::size_t i = 0; i < n; ++i) {
+            const Point<double>& a = current[i];
+            const Point<double>& b = current[i + 1 < n ? i + 1 : 0];
+            const bool a_inside = inside(a);
+            const bool b_inside = inside(b);
+            if (a_inside) {
+                next.push_back(a);
+            }
+            if (a_inside != b_inside) {
+                next.push_back(crossing(a, b));
+            }
+        }
+        std::swap(current, next);
+    };
+    auto at_x = [](double x) {
+        return [x](const Point<double>& a, const Point<double>& b) {
+            double t = (x - a.get_x()) / (b.get_x() - a.get_x());
+            return Point<double>(x, a.get_y() + t * (b.get_y() - a.get_y()));
+        };
+    };
+    auto at_y = [](double y) {
+        return [y](const Point<double>& a, const Point<double>& b) {
+            double t = (y - a.get_y()) / (b.get_y() - a.get_y());
+            return Point<double>(a.get_x() + t * (b.get_x() - a.get_x()), y);
+        };
+    };
+    clip([&](const Point<double>& p) { return p.get_x() >= window.min_x; }, at_x(window.min_x));
+    clip([&](const Point<double>& p) { return p.get_x() <= window.max_x; }, at_x(window.max_x));
+    clip([&](const Point<double>& p) { return p.get_y() >= window.min_y; }, at_y(window.min_y));
+    clip([&](const Point<double>& p) { return p.get_y() <= window.max_y; }, at_y(window.max_y));
+}
+
+// Многоугольники - результат отсечения коллекции фигур окном - в одном непрерывном буфере точек
+// (многоугольник i - точки [offsets[i], offsets[i + 1])), для каждого хранится номер исходной фигуры.
+// Многоугольники нулевой площади (фигура касается окна только стороной или вершиной) не хранятся.
+class ClippedPolygons {
+    public:
+        ClippedPolygons() : offsets{0} {};
+
+        std::size_t size() const {
+            return sources.size();
+        };
+
+        std::span<const Point<double>> contour(std::size_t index) const {
+            return std::span<const Point<double>>(points).subspan(offsets[index], offsets[index + 1] - offsets[index]);
+        };
+
+        // Номер фигуры в исходной коллекции, из которой получен многоугольник index.
+        std::size_t source(std::size_t index) const {
+            return sources[index];
+        };
+
+        // Все точки всех многоугольников подряд.
+        std::span<const Point<double>> vertices() const {
+            return points;
+        };
+
+        // Добавление многоугольника, полученного из фигуры source (меньше трёх вершин или нулевая площадь - не добавляется).
+        template<Scalar T>
+        void add(std::span<const Point<T>> contour, std::size_t source) {
+            if (contour.size() < 3) {
+                return;
+            }
+            const std::size_t first = points.size();
+            double doubled_area = 0.0;
+            for (const auto& vertex : contour) {
+                points.emplace_back(static_cast<double>(vertex.get_x()), static_cast<double>(vertex.get_y()));
+            }
+            for (std::size_t i = first; i < points.size(); ++i) {
+                doubled_area += cross(points[i], points[i + 1 < points.size() ? i + 1 : first]);
+            }
+            if (doubled_area == 0.0) {
+                points.resize(first);
+                return;
+            }
+            offsets.push_back(points.size());
+            sources.push_back(source);
+        };
+
+        // Добавление в конец всех многоугольников other (используется при объединении результатов частей).
+        void append(const ClippedPolygons& other) {
+            const std::size_t shift = points.size();
+            points.insert(points.end(), other.points.begin(), other.points.end());
+            for (std::size_t i = 1; i < other.offsets.size(); ++i) {
+                offsets.push_back(other.offsets[i] + shift);
+            }
+            sources.insert(sources.end(), other.sources.begin(), other.sources.end());
+        };
+
+    private:
+        std::vector<Point<double>> points;
+        std::vector<std::size_t> offsets;
+        std::vector<std::size_t> sources;
+};
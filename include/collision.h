@@ -0,0 +1,153 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <vector>
+#include "point.h"
+#include "threadpool.h"
+
+// Пара пересекающихся фигур (индексы в коллекции, first < second).
+struct CollisionPair {
+    std::size_t first{0};
+    std::size_t second{0};
+
+    bool operator==(const CollisionPair& other) const = default;
+};
+
+// Есть ли среди нормалей к сторонам выпуклого многоугольника a разделяющая ось:
+// все вершины b лежат строго снаружи от стороны a. Направление обхода a определяется по знаку площади.
+// У вырожденного a (нулевая площадь) стороны не задают осей.
+template<Scalar T>
+bool has_separating_edge(std::span<const Point<T>> a, std::span<const Point<T>> b) {
+    const std::size_t n = a.size();
+    double orientation = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        orientation += static_cast<double>(cross(a[i], a[i + 1 < n ? i + 1 : 0]));
+    }
+    if (orientation == 0.0) {
+        return false;
+    }
+    const double side = orientation > 0.0 ? 1.0 : -1.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const Point<T>& start = a[i];
+        const Point<T>& end = a[i + 1 < n ? i + 1 : 0];
+        // Внешняя нормаль к стороне.
+        const double nx = side * static_cast<double>(end.get_y() - start.get_y());
+        const double ny = -side * static_cast<double>(end.get_x() - start.get_x());
+        bool outside = true;
+        for (const auto& point : b) {
+            double projection = nx * static_cast<double>(point.get_x() - start.get_x()) + ny * static_cast<double>(point.get_y() - start.get_y());
+            if (projection <= 0.0) {
+                outside = false;
+                break;
+            }
+        }
+        if (outside) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Точная проверка пересечения выпуклых многоугольников по теореме о разделяющей оси (SAT):
+// многоугольники не пересекаются, только если одна из нормалей к их сторонам разделяет их.
+// Касание (общая точка или сторона) считается пересечением.
+template<Scalar T>
+bool convex_polygons_intersect(std::span<const Point<T>> a, std::span<const Point<T>> b) {
+    return !has_separating_edge(a, b) && !has_separating_edge(b, a);
+}
+
+// Ограничивающий прямоугольник объекта для заметания.
+struct SweepEntry {
+    double min_x{0.0};
+    double max_x{0.0};
+    double min_y{0.0};
+    double max_y{0.0};
+    std::size_t index{0};
+};
+
+// Широкая фаза «заметание и отсечение» (sweep and prune) по горизонтальным полосам.
+// Плоскость делится на полосы высотой в два средних прямоугольника, каждый прямоугольник попадает во все полосы,
+// которые задевает. В полосе прямоугольники сортируются по min_x (и индексу), и для каждого просматриваются
+// следующие за ним, пока их min_x не больше его max_x. Без деления на полосы заметание по одной оси
+// просматривало бы все фигуры вертикального слоя (O(n sqrt n) для равномерно распределённых фигур).
+// Пара учитывается только в полосе, содержащей большее из min_y, поэтому повторов нет.
+// Кандидаты с пересекающимися по Y прямоугольниками передаются узкой фазе narrow(i, j).
+// При parallel полосы сортируются и обрабатываются задачами пула; пары идут по полосам в порядке заметания,
+// поэтому результат не зависит от количества потоков и совпадает с последовательным.
+template<class Narrow>
+std::vector<CollisionPair> sweep_and_prune(std::span<const SweepEntry> entries, ThreadPool& pool, bool parallel, Narrow&& narrow) {
+    const std::size_t n = entries.size();
+    if (n < 2) {
+        return {};
+    }
+    double min_y = entries[0].min_y;
+    double max_y = entries[0].max_y;
+    double height_sum = 0.0;
+    for (const auto& entry : entries) {
+        min_y = std::min(min_y, entry.min_y);
+        max_y = std::max(max_y, entry.max_y);
+        height_sum += entry.max_y - entry.min_y;
+    }
+    const double extent = max_y - min_y;
+    double strip_height = 2.0 * height_sum / static_cast<double>(n);
+    std::size_t strips = 1;
+    if (strip_height > 0.0 && extent > strip_height) {
+        strips = static_cast<std::size_t>(std::min(std::ceil(extent / strip_height), static_cast<double>(n)));
+        strip_height = extent / static_cast<double>(strips);
+    }
+    auto strip_of = [&](double y) {
+        if (strips == 1) {
+            return std::size_t{0};
+        }
+        return std::min(strips - 1, static_cast<std::size_t>(std::max(0.0, (y - min_y) / strip_height)));
+    };
+
+    // Раскладка прямоугольников по полосам (подсчёт, префиксные суммы, заполнение).
+    std::vector<std::size_t> starts(strips + 1, 0);
+    for (const auto& entry : entries) {
+        for (std::size_t s = strip_of(entry.min_y); s <= strip_of(entry.max_y); ++s) {
+            ++starts[s + 1];
+        }
+    }
+    for (std::size_t s = 0; s < strips; ++s) {
+        starts[s + 1] += starts[s];
+    }
+    std::vector<SweepEntry> by_strip(starts.back());
+    std::vector<std::size_t> fill(starts.begin(), starts.end() - 1);
+    for (const auto& entry : entries) {
+        for (std::size_t s = strip_of(entry.min_y); s <= strip_of(entry.max_y); ++s) {
+            by_strip[fill[s]++] = entry;
+        }
+    }
+
+    const std::size_t grain = parallel ? 1 : strips;
+    return pool.parallel_reduce(0, strips, grain, std::vector<CollisionPair>{},
+        [&](std::size_t first_strip, std::size_t last_strip) {
+            std::vector<CollisionPair> pairs;
+            for (std::size_t s = first_strip; s < last_strip; ++s) {
+                auto begin = by_strip.begin() + static_cast<std::ptrdiff_t>(starts[s]);
+                auto end = by_strip.begin() + static_cast<std::ptrdiff_t>(starts[s + 1]);
+                std::sort(begin, end, [](const SweepEntry& a, const SweepEntry& b) {
+                    return a.min_x < b.min_x || (a.min_x == b.min_x && a.index < b.index);
+                });
+                for (auto a = begin; a != end; ++a) {
+                    for (auto b = a + 1; b != end && b->min_x <= a->max_x; ++b) {
+                        if (a->min_y <= b->max_y && b->min_y <= a->max_y && strip_of(std::max(a->min_y, b->min_y)) == s &&
+                            narrow(a->index, b->index)) {
+                            pairs.push_back(CollisionPair{std::min(a->index, b->index), std::max(a->index, b->index)});
+                        }
+                    }
+                }
+            }
+            return pairs;
+        },
+        [](std::vector<CollisionPair> a, std::vector<CollisionPair> b) {
+            if (a.empty()) {
+                return b;
+            }
+            a.insert(a.end(), b.begin(), b.end());
+            return a;
+        });
+}
@@ -0,0 +1,281 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "point.h"
+#include "figure.h"
+#include "validation.h"
+#include "ownership.h"
+#include "threadpool.h"
+#include "arrayoffigures.h"
+#include "figureio.h"
+
+// Сжатое представление коллекции фигур только для чтения - для «холодных» коллекций, которые долго хранятся
+// в памяти и редко запрашиваются. Хранятся только вершины, без объектов, описаний и указателей.
+//
+// Координаты квантуются: хранится целое q = round(x / quantum). Для целочисленных координат шаг всегда 1
+// (сжатие без потерь), для координат с плавающей точкой шаг задаётся при сжатии. Шаг - степень двойки -
+// восстанавливает без потерь все координаты, кратные ему. Шаг по умолчанию 2^-24: погрешность квантования
+// (полшага) намного меньше допуска 1e-6 проверки правильных многоугольников.
+//
+// Фигуры разбиты на блоки по BLOCK_SIZE. Фигура в блоке - байт с количеством вершин (0 - пустая ячейка массива),
+// затем приращения координат в виде zigzag-varint: первая вершина - относительно первой вершины предыдущей
+// фигуры блока (у первой фигуры блока - относительно начала координат), остальные - относительно предыдущей
+// вершины. Блоки независимы: для доступа к фигуре распаковывается только её блок, смещения блоков хранятся в индексе.
+//
+// Описания фигур не сохраняются. Фигуры восстанавливаются проверяющими конструкторами: запись,
+// которая после квантования перестала проходить проверку (например, ромб с неравными сторонами), отвергается
+// и при распаковке заменяется пустой ячейкой.
+template<Scalar T>
+class CompressedFigures {
+    public:
+        static constexpr std::size_t BLOCK_SIZE = 64;
+        // Шаг квантования по умолчанию.
+        static constexpr double DEFAULT_QUANTUM = std::is_floating_point_v<T> ? 1.0 / (1 << 24) : 1.0;
+
+        CompressedFigures() : offsets{0} {};
+
+        // Сжатие коллекции. Блоки кодируются параллельно задачами пула коллекции.
+        // std::invalid_argument - если шаг не положителен (для целочисленных координат - не равен 1),
+        // у фигуры больше MAX_FIGURE_VERTICES вершин или квантованная координата не помещается в 62 бита.
+        template<class Ownership>
+        static CompressedFigures compress(const ArrayOfFigures<Figure<T>, Ownership>& figures, double quantum = DEFAULT_QUANTUM) {
+            CompressedFigures result(quantum);
+            const std::size_t n = figures.get_size();
+            const std::size_t blocks = (n + BLOCK_SIZE - 1) / BLOCK_SIZE;
+            std::vector<std::vector<std::uint8_t>> encoded(blocks);
+            figures.get_thread_pool().parallel_for(0, blocks, 1, [&](std::size_t lo, std::size_t hi) {
+                for (std::size_t b = lo; b < hi; ++b) {
+                    std::vector<std::uint8_t>& out = encoded[b];
+                    Quantized previous{0, 0};
+                    for (std::size_t i = b * BLOCK_SIZE; i < std::min(n, (b + 1) * BLOCK_SIZE); ++i) {
+                        const auto& figure = figures.get_unchecked(i);
+                        result.encode_figure(figure ? figure->vertices() : std::span<const Point<T>>{}, previous, out);
+                    }
+                }
+            });
+            std::size_t total = 0;
+            for (const auto& block : encoded) {
+                total += block.size();
+            }
+            result.bytes.reserve(total);
+            result.offsets.reserve(blocks + 1);
+            for (const auto& block : encoded) {
+                result.bytes.insert(result.bytes.end(), block.begin(), block.end());
+                result.offsets.push_back(result.bytes.size());
+            }
+            result.count = n;
+            return result;
+        };
+
+        // Количество фигур (включая пустые ячейки).
+        std::size_t size() const {
+            return count;
+        };
+
+        std::size_t block_count() const {
+            return offsets.size() - 1;
+        };
+
+        double quantum() const {
+            return step;
+        };
+
+        // Объём сжатых данных в байтах: поток блоков и индекс смещений.
+        std::size_t byte_size() const {
+            return bytes.size() + offsets.size() * sizeof(std::uint64_t);
+        };
+
+        // Распаковка блока block в записи; out - не меньше BLOCK_SIZE записей. Возвращает количество записей блока.
+        // Пустая ячейка массива распаковывается в запись с vertex_count == 0.
+        std::size_t decode_block(std::size_t block, std::span<FigureRecord<T>> out) const {
+            if (block >= block_count()) {
+                throw std::out_of_range("Block index out of range");
+            }
+            const std::size_t records = std::min(BLOCK_SIZE, count - block * BLOCK_SIZE);
+            if (out.size() < records) {
+                throw std::invalid_argument("Output is smaller than the block.");
+            }
+            const std::uint8_t* cursor = bytes.data() + offsets[block];
+            Quantized previous{0, 0};
+            for (std::size_t r = 0; r < records; ++r) {
+                cursor = decode_figure(cursor, previous, out[r]);
+            }
+            return records;
+        };
+
+        // Запись фигуры index: предыдущие фигуры её блока пропускаются без распаковки (читаются только их первые вершины).
+        FigureRecord<T> record(std::size_t index) const {
+            if (index >= count) {
+                throw std::out_of_range("Index out of range");
+            }
+            const std::uint8_t* cursor = bytes.data() + offsets[index / BLOCK_SIZE];
+            Quantized previous{0, 0};
+            for (std::size_t r = 0; r < index % BLOCK_SIZE; ++r) {
+                cursor = skip_figure(cursor, previous);
+            }
+            FigureRecord<T> result;
+            decode_figure(cursor, previous, result);
+            return result;
+        };
+
+        // Фигура index (nullptr для пустой ячейки). FigureValidationError - если запись не проходит проверку.
+        std::shared_ptr<Figure<T>> figure(std::size_t index) const {
+            FigureRecord<T> value = record(index);
+            return value.vertex_count == 0 ? nullptr : make_figure(value);
+        };
+
+        // Распаковка всей коллекции. Блоки распаковываются и фигуры создаются параллельно задачами пула.
+        // Номера фигур сохраняются: фигура i сжатого представления - ячейка i результата. Пустые ячейки остаются пустыми,
+        // на месте отвергнутых записей - пустые ячейки, а сами записи попадают в rejected (индекс - номер фигуры).
+        template<class Ownership = SharedOwnership>
+        ArrayOfFigures<Figure<T>, Ownership> decompress(std::vector<FigureRejection>& rejected, ThreadPool& pool = ThreadPool::global()) const {
+            using Pointer = typename Ownership::template pointer<Figure<T>>;
+            std::vector<Pointer> slots(count);
+            std::vector<ValidationError> errors(count, ValidationError::None);
+            pool.parallel_for(0, block_count(), 1, [&](std::size_t lo, std::size_t hi) {
+                std::vector<FigureRecord<T>> records(BLOCK_SIZE);
+                for (std::size_t b = lo; b < hi; ++b) {
+                    const std::size_t decoded = decode_block(b, records);
+                    for (std::size_t r = 0; r < decoded; ++r) {
+                        if (records[r].vertex_count == 0) {
+                            continue;
+                        }
+                        auto created = try_make_figure<Ownership>(records[r]);
+                        if (created) {
+                            slots[b * BLOCK_SIZE + r] = std::move(*created);
+                        } else {
+                            errors[b * BLOCK_SIZE + r] = created.error();
+                        }
+                    }
+                }
+            });
+            ArrayOfFigures<Figure<T>, Ownership> result;
+            result.reserve(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                if (errors[i] != ValidationError::None) {
+                    rejected.push_back(FigureRejection{i, errors[i]});
+                }
+                result.add_figure(std::move(slots[i]));
+            }
+            return result;
+        };
+
+    private:
+        struct Quantized {
+            std::uint64_t x;
+            std::uint64_t y;
+        };
+
+        explicit CompressedFigures(double quantum) : step(quantum), offsets{0} {
+            if (!(quantum > 0.0) || !std::isfinite(quantum) || (!std::is_floating_point_v<T> && quantum != 1.0)) {
+                throw std::invalid_argument("Invalid quantization step.");
+            }
+        };
+
+        // Квантованная координата в виде 64-битного слова. Приращения считаются по модулю 2^64,
+        // поэтому для целочисленных координат переполнение разности не искажает данные.
+        std::uint64_t quantize(T value) const {
+            if constexpr (std::is_floating_point_v<T>) {
+                const double scaled = std::round(static_cast<double>(value) / step);
+                if (!(std::fabs(scaled) < 0x1p62)) {
+                    throw std::invalid_argument("Coordinate does not fit the quantized range.");
+                }
+                return static_cast<std::uint64_t>(static_cast<std::int64_t>(scaled));
+            } else {
+                return static_cast<std::uint64_t>(value);
+            }
+        };
+
+        T dequantize(std::uint64_t value) const {
+            if constexpr (std::is_floating_point_v<T>) {
+                return static_cast<T>(static_cast<double>(static_cast<std::int64_t>(value)) * step);
+            } else {
+                return static_cast<T>(value);
+            }
+        };
+
+        static void put_delta(std::uint64_t current, std::uint64_t previous, std::vector<std::uint8_t>& out) {
+            const std::uint64_t delta = current - previous;
+            // zigzag: 0, -1, 1, -2, ... -> 0, 1, 2, 3, ...
+            std::uint64_t zigzag = (delta << 1) ^ static_cast<std::uint64_t>(static_cast<std::int64_t>(delta) >> 63);
+            while (zigzag >= 0x80) {
+                out.push_back(static_cast<std::uint8_t>(zigzag | 0x80));
+                zigzag >>= 7;
+            }
+            out.push_back(static_cast<std::uint8_t>(zigzag));
+        };
+
+        static std::uint64_t get_delta(const std::uint8_t*& cursor) {
+            std::uint64_t zigzag = 0;
+            for (unsigned shift = 0;; shift += 7) {
+                const std::uint8_t byte = *cursor++;
+                zigzag |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if (byte < 0x80) {
+                    break;
+                }
+            }
+            return (zigzag >> 1) ^ (~(zigzag & 1) + 1);
+        };
+
+        void encode_figure(std::span<const Point<T>> vertices, Quantized& first, std::vector<std::uint8_t>& out) const {
+            if (vertices.size() > MAX_FIGURE_VERTICES) {
+                throw std::invalid_argument("Figure has too many vertices for compression.");
+            }
+            out.push_back(static_cast<std::uint8_t>(vertices.size()));
+            Quantized previous = first;
+            for (std::size_t v = 0; v < vertices.size(); ++v) {
+                const Quantized current{quantize(vertices[v].get_x()), quantize(vertices[v].get_y())};
+                put_delta(current.x, previous.x, out);
+                put_delta(current.y, previous.y, out);
+                if (v == 0) {
+                    first = current;
+                }
+                previous = current;
+            }
+        };
+
+        // Пропуск фигуры: первая вершина нужна следующей фигуре блока, остальные приращения только пропускаются
+        // (у каждого varint ровно один байт без старшего бита).
+        static const std::uint8_t* skip_figure(const std::uint8_t* cursor, Quantized& first) {
+            const std::uint32_t vertices = *cursor++;
+            if (vertices == 0) {
+                return cursor;
+            }
+            first.x += get_delta(cursor);
+            first.y += get_delta(cursor);
+            for (std::uint32_t rest = 2 * (vertices - 1); rest > 0; --rest) {
+                while (*cursor++ >= 0x80) {
+                }
+            }
+            return cursor;
+        };
+
+        const std::uint8_t* decode_figure(const std::uint8_t* cursor, Quantized& first, FigureRecord<T>& out) const {
+            out = FigureRecord<T>{};
+            out.vertex_count = *cursor++;
+            Quantized previous = first;
+            for (std::uint32_t v = 0; v < out.vertex_count; ++v) {
+                previous.x += get_delta(cursor);
+                previous.y += get_delta(cursor);
+                out.vertices[v] = Point<T>(dequantize(previous.x), dequantize(previous.y));
+                if (v == 0) {
+                    first = previous;
+                }
+            }
+            return cursor;
+        };
+
+        double step{DEFAULT_QUANTUM};
+        std::size_t count{0};
+        // Поток сжатых блоков; блок b - байты [offsets[b], offsets[b + 1]).
+        std::vector<std::uint8_t> bytes;
+        std::vector<std::uint64_t> offsets;
+};
@@ -0,0 +1,141 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "point.h"
+#include "boundingbox.h"
+#include "uniformgrid.h"
+
+// Наибольшее количество вершин выпуклого многоугольника для пакетной проверки принадлежности точек.
+inline constexpr std::size_t MAX_HALF_PLANES = 8;
+
+// Выпуклый многоугольник как пересечение N полуплоскостей a x + b y + c >= 0 (по одной на сторону,
+// внутренняя сторона - слева при обходе против часовой стрелки). Если сторон меньше N, лишние полуплоскости
+// заполняются условием 0 >= -1 (выполняется всегда), поэтому проверка точки - всегда ровно N умножений-сложений
+// без ветвлений, и цикл по точкам векторизуется компилятором. У вырожденного многоугольника (нулевая площадь)
+// одна из полуплоскостей пустая, и ни одна точка не принадлежит ему.
+// Точки на границе считаются внутренними (с точностью до округления при вычислении коэффициентов).
+template<std::size_t N>
+struct HalfPlanes {
+    BoundingBox<double> box;
+    std::array<double, N> a{};
+    std::array<double, N> b{};
+    std::array<double, N> c{};
+
+    template<Scalar T>
+    static HalfPlanes of(std::span<const Point<T>> polygon) {
+        const std::size_t n = polygon.size();
+        if (n > N) {
+            throw std::invalid_argument("Too many vertices for half-plane containment.");
+        }
+        HalfPlanes result;
+        result.c.fill(1.0);
+        double doubled_area = 0.0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto& p = polygon[i];
+            const auto& q = polygon[i + 1 < n ? i + 1 : 0];
+            doubled_area += static_cast<double>(p.get_x()) * static_cast<double>(q.get_y()) -
+                            static_cast<double>(q.get_x()) * static_cast<double>(p.get_y());
+            result.box.expand(static_cast<double>(p.get_x()), static_cast<double>(p.get_y()));
+        }
+        if (n < 3 || doubled_area == 0.0) {
+            result.c[0] = -1.0;
+            return result;
+        }
+        const double side = doubled_area > 0.0 ? 1.0 : -1.0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const double x0 = static_cast<double>(polygon[i].get_x());
+            const double y0 = static_cast<double>(polygon[i].get_y());
+            const double x1 = static_cast<double>(polygon[i + 1 < n ? i + 1 : 0].get_x());
+            const double y1 = static_cast<double>(polygon[i + 1 < n ? i + 1 : 0].get_y());
+            result.a[i] = -side * (y1 - y0);
+            result.b[i] = side * (x1 - x0);
+            result.c[i] = -(result.a[i] * x0 + result.b[i] * y0);
+        }
+        return result;
+    };
+
+    bool contains(double x, double y) const {
+        bool inside = true;
+        for (std::size_t k = 0; k < N; ++k) {
+            inside &= a[k] * x + b[k] * y + c[k] >= 0.0;
+        }
+        return inside;
+    };
+};
+
+// Ядро пакетной проверки: out[i] = 1, если точка points[i] принадлежит многоугольнику, иначе 0.
+template<std::size_t N, Scalar T>
+void contains_kernel(const HalfPlanes<N>& planes, std::span<const Point<T>> points, std::span<std::uint8_t> out) {
+    const std::size_t count = points.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = planes.contains(static_cast<double>(points[i].get_x()), static_cast<double>(points[i].get_y()));
+    }
+}
+
+// Пакетная проверка принадлежности точек выпуклому многоугольнику. Ядро выбирается по количеству вершин:
+// для ромба, пятиугольника и шестиугольника (4, 5 и 6 вершин) количество полуплоскостей известно при компиляции,
+// остальные многоугольники до MAX_HALF_PLANES вершин проверяются общим ядром.
+template<Scalar T>
+void contains_convex(std::span<const Point<T>> polygon, std::span<const Point<T>> points, std::span<std::uint8_t> out) {
+    if (out.size() != points.size()) {
+        throw std::invalid_argument("Output size must match the number of points.");
+    }
+    switch (polygon.size()) {
+        case 4:
+            contains_kernel(HalfPlanes<4>::of(polygon), points, out);
+            break;
+        case 5:
+            contains_kernel(HalfPlanes<5>::of(polygon), points, out);
+            break;
+        case 6:
+            contains_kernel(HalfPlanes<6>::of(polygon), points, out);
+            break;
+        default:
+            contains_kernel(HalfPlanes<MAX_HALF_PLANES>::of(polygon), points, out);
+            break;
+    }
+}
+
+// Набор выпуклых многоугольников для проверки «лежит ли точка хотя бы в одном из них».
+// Точки вне общего ограничивающего прямоугольника отбрасываются сразу. Остальные проверяются только
+// по многоугольникам из своей ячейки равномерной сетки (см. UniformGrid), и полуплоскости считаются только
+// для многоугольников, чей прямоугольник содержит точку.
+class ConvexRegionIndex {
+    public:
+        explicit ConvexRegionIndex(std::vector<HalfPlanes<MAX_HALF_PLANES>> polygons) : regions(std::move(polygons)) {
+            std::vector<BoundingBox<double>> boxes;
+            boxes.reserve(regions.size());
+            for (const auto& region : regions) {
+                boxes.push_back(region.box);
+            }
+            grid = UniformGrid(boxes);
+        };
+
+        std::size_t size() const {
+            return regions.size();
+        };
+
+        bool contains(double x, double y) const {
+            if (!grid.get_bounds().contains(x, y)) {
+                return false;
+            }
+            for (std::size_t k : grid.cell_entries(x, y)) {
+                const auto& region = regions[k];
+                if (region.box.contains(x, y) && region.contains(x, y)) {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+    private:
+        std::vector<HalfPlanes<MAX_HALF_PLANES>> regions;
+        UniformGrid grid;
+};
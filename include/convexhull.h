@@ -0,0 +1,120 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+#include "point.h"
+#include "threadpool.h"
+
+// Выпуклая оболочка точек алгоритмом Эндрю (monotone chain) за O(n log n).
+// Точки сортируются на месте. Результат - вершины оболочки против часовой стрелки, начиная с самой левой
+// (при равенстве - нижней), без повторов и без точек, лежащих на сторонах. Для одной различной точки
+// возвращается она сама, для двух - обе.
+template<Scalar T>
+std::vector<Point<T>> monotone_chain(std::vector<Point<T>>& points) {
+    auto less = [](const Point<T>& a, const Point<T>& b) {
+        return a.get_x() < b.get_x() || (a.get_x() == b.get_x() && a.get_y() < b.get_y());
+    };
+    std::sort(points.begin(), points.end(), less);
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+    if (points.size() < 3) {
+        return points;
+    }
+    std::vector<Point<T>> hull(2 * points.size());
+    std::size_t k = 0;
+    // Нижняя цепь слева направо, затем верхняя справа налево.
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        while (k >= 2 && cross(hull[k - 1] - hull[k - 2], points[i] - hull[k - 2]) <= 0) {
+            --k;
+        }
+        hull[k++] = points[i];
+    }
+    for (std::size_t i = points.size() - 1, lower = k + 1; i > 0; --i) {
+        while (k >= lower && cross(hull[k - 1] - hull[k - 2], points[i - 1] - hull[k - 2]) <= 0) {
+            --k;
+        }
+        hull[k++] = points[i - 1];
+    }
+    hull.resize(k - 1);
+    return hull;
+}
+
+// Оболочка части точек. for_each(visit) вызывает visit(point) для каждой точки части и выполняется дважды:
+// первый проход находит 8 крайних точек (по x, y, x + y и x - y), второй отбрасывает точки строго внутри
+// их оболочки (отсечение Экла-Туссена) - они не могут быть вершинами, и сортируются только оставшиеся.
+template<Scalar T, class ForEach>
+std::vector<Point<T>> filtered_hull(ForEach&& for_each) {
+    bool any = false;
+    std::array<Point<T>, 8> extremes;
+    for_each([&](const Point<T>& p) {
+        if (!any) {
+            extremes.fill(p);
+            any = true;
+            return;
+        }
+        auto update = [&](std::size_t index, auto key, bool maximum) {
+            if (maximum ? key(p) > key(extremes[index]) : key(p) < key(extremes[index])) {
+                extremes[index] = p;
+            }
+        };
+        auto x = [](const Point<T>& q) { return q.get_x(); };
+        auto y = [](const Point<T>& q) { return q.get_y(); };
+        auto sum = [](const Point<T>& q) { return q.get_x() + q.get_y(); };
+        auto difference = [](const Point<T>& q) { return q.get_x() - q.get_y(); };
+        update(0, x, false);
+        update(1, x, true);
+        update(2, y, false);
+        update(3, y, true);
+        update(4, sum, false);
+        update(5, sum, true);
+        update(6, difference, false);
+        update(7, difference, true);
+    });
+    if (!any) {
+        return {};
+    }
+    std::vector<Point<T>> corners(extremes.begin(), extremes.end());
+    std::vector<Point<T>> region = monotone_chain(corners);
+    std::vector<Point<T>> candidates(region);
+    const std::size_t m = region.size();
+    for_each([&](const Point<T>& p) {
+        if (m < 3) {
+            candidates.push_back(p);
+            return;
+        }
+        for (std::size_t i = 0; i < m; ++i) {
+            if (cross(region[i + 1 < m ? i + 1 : 0] - region[i], p - region[i]) <= 0) {
+                candidates.push_back(p);
+                return;
+            }
+        }
+    });
+    return monotone_chain(candidates);
+}
+
+// Параллельная выпуклая оболочка count элементов: элементы делятся на части по grain, оболочка каждой части
+// строится задачей пула (filtered_hull), затем оболочки частей объединяются ещё одним проходом monotone chain.
+// for_each_in_range(lo, hi, visit) вызывает visit(point) для всех точек элементов [lo, hi).
+template<Scalar T, class ForEachInRange>
+std::vector<Point<T>> parallel_convex_hull(ThreadPool& pool, std::size_t count, std::size_t grain, ForEachInRange&& for_each_in_range) {
+    std::vector<Point<T>> merged = pool.parallel_reduce(0, count, grain, std::vector<Point<T>>{},
+        [&](std::size_t lo, std::size_t hi) {
+            return filtered_hull<T>([&](auto&& visit) { for_each_in_range(lo, hi, visit); });
+        },
+        [](std::vector<Point<T>> a, std::vector<Point<T>> b) {
+            a.insert(a.end(), b.begin(), b.end());
+            return a;
+        });
+    return monotone_chain(merged);
+}
+
+// Параллельная выпуклая оболочка массива точек.
+template<Scalar T>
+std::vector<Point<T>> parallel_convex_hull(ThreadPool& pool, std::span<const Point<T>> points, std::size_t grain) {
+    return parallel_convex_hull<T>(pool, points.size(), grain, [points](std::size_t lo, std::size_t hi, auto&& visit) {
+        for (std::size_t i = lo; i < hi; ++i) {
+            visit(points[i]);
+        }
+    });
+}
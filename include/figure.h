@@ -1,10 +1,37 @@
 #pragma once
 #include <iostream>
 #include "point.h"
+#include "boundingbox.h"
+#include "affine.h"
+#include "containment.h"
+#include "instrumentation.h"
 #include <memory>
 #include <string_view>
 #include <string>
 #include <ostream>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// Вид фигуры. Хранится в каждой фигуре вместо строки с описанием и позволяет
+// выбирать обработку по виду фигуры за O(1) без dynamic_cast.
+enum class FigureKind : std::uint8_t {
+    Unknown,
+    Rhombus,
+    Pentagon,
+    Hexagon,
+    Count
+};
+
+// Количество видов фигур (размер таблиц, индексируемых FigureKind).
+inline constexpr std::size_t FIGURE_KIND_COUNT = static_cast<std::size_t>(FigureKind::Count);
+
+// Название вида фигуры (общая статическая таблица, строки не копируются в объекты).
+constexpr std::string_view figure_kind_name(FigureKind kind) {
+    constexpr std::string_view NAMES[FIGURE_KIND_COUNT] = {"Figure", "rhombus", "pentagon", "hexagon"};
+    auto index = static_cast<std::size_t>(kind);
+    return index < FIGURE_KIND_COUNT ? NAMES[index] : NAMES[0];
+}
 
 template<Scalar T> 
 class Figure {
@@ -14,7 +41,7 @@ class Figure {
     // Figure fig;
     // std::cout << fig << std::endl;
     friend std::ostream& operator<<(std::ostream& os, const Figure& figure) {
-        os << figure.description << ":\n";
+        os << figure.get_description() << ":\n";
         figure.print(os);
         return os;
     }
@@ -28,9 +55,33 @@ class Figure {
         // Конструкторы защищены, чтобы нельзя было создать объект базового класса напрямую.
         // Это абстрактный класс.
         // Конструктор по умолчанию.
-        Figure() = default;
-        // Конструктор с параметром описания фигуры.
-        Figure(std::string_view descrip) : description(descrip) {};
+        Figure() {
+            FIGURES_COUNT(Constructed);
+        };
+        // Конструктор с видом фигуры и необязательным пользовательским описанием.
+        // Описание сохраняется, только если оно задано и отличается от названия вида,
+        // поэтому фигуры без своего описания не тратят память на строку.
+        Figure(FigureKind figure_kind, std::string_view descrip = {}) : kind(figure_kind) {
+            if (!descrip.empty() && descrip != figure_kind_name(figure_kind)) {
+                description = std::make_unique<const std::string>(descrip);
+            }
+            FIGURES_COUNT(Constructed);
+        };
+
+        // Копирование и перемещение для наследников: вид и пользовательское описание сохраняются.
+        Figure(const Figure& other)
+            : kind(other.kind), description(other.description ? std::make_unique<const std::string>(*other.description) : nullptr) {
+            FIGURES_COUNT(Constructed);
+        };
+        Figure(Figure&& other) noexcept = default;
+        Figure& operator=(const Figure& other) {
+            if (this != &other) {
+                kind = other.kind;
+                description = other.description ? std::make_unique<const std::string>(*other.description) : nullptr;
+            }
+            return *this;
+        };
+        Figure& operator=(Figure&& other) noexcept = default;
 
         // Функции для реализации логики операторов ввода/вывода в наследниках.
 
@@ -50,13 +101,63 @@ class Figure {
         virtual double perimeter() const = 0;
 
         virtual std::shared_ptr<Figure<T>> clone() const = 0;
+        // Клонирование в единоличное владение (используется ArrayOfFigures с политикой UniqueOwnership).
+        virtual std::unique_ptr<Figure<T>> clone_unique() const = 0;
+
+        // Проверка, что вершины фигуры удовлетворяют условиям её конструктора.
+        virtual bool is_valid() const = 0;
 
         virtual operator double() const = 0;
 
+        // Количество вершин фигуры.
+        virtual std::size_t vertex_count() const = 0;
+        // Вершина фигуры по индексу (в порядке обхода). Индекс должен быть меньше vertex_count().
+        virtual Point<T> vertex(std::size_t index) const = 0;
+        // Все вершины фигуры (в порядке обхода), лежащие в памяти подряд.
+        virtual std::span<const Point<T>> vertices() const = 0;
+
+        // Применение преобразования подобия ко всем вершинам фигуры. Другие аффинные преобразования
+        // (растяжение вдоль оси, сдвиг) не сохраняют вид фигуры, поэтому для них бросается std::invalid_argument.
+        // Сохранённые площадь и периметр пересчитываются аналитически, без обхода вершин.
+        void transform(const Affine2D& matrix) {
+            matrix.require_similarity();
+            transform_unchecked(matrix);
+        };
+        // То же без проверки матрицы (вызывающий уже проверил, что это преобразование подобия).
+        virtual void transform_unchecked(const Affine2D& matrix) = 0;
+
+        // Ограничивающий прямоугольник фигуры (по вершинам).
+        BoundingBox<T> bounding_box() const {
+            BoundingBox<T> box;
+            for (const auto& point : vertices()) {
+                box.expand(point);
+            }
+            return box;
+        };
+
+        // Пакетная проверка принадлежности точек фигуре: out[i] = 1, если points[i] лежит внутри фигуры
+        // или на её границе, иначе 0. Все фигуры выпуклые, поэтому проверка - пересечение полуплоскостей сторон;
+        // ядро выбирается по количеству вершин (см. contains_convex). Размер out должен совпадать с points.
+        void contains_batch(std::span<const Point<T>> points, std::span<std::uint8_t> out) const {
+            contains_convex(vertices(), points, out);
+        };
+
+        // Вид фигуры.
+        FigureKind get_kind() const {
+            return kind;
+        };
+
+        // Получение описания фигуры: пользовательское описание, если оно задано, иначе название вида.
+        std::string_view get_description() const {
+            return description ? std::string_view(*description) : figure_kind_name(kind);
+        };
+
     
     
     private:
-        std::string description = "Figure";
+        FigureKind kind = FigureKind::Unknown;
+        // Пользовательское описание (nullptr, если используется название вида).
+        std::unique_ptr<const std::string> description;
 
 
 };
\ No newline at end of file
@@ -0,0 +1,210 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include "point.h"
+#include "figure.h"
+#include "boundingbox.h"
+#include "affine.h"
+
+// Компенсированная сумма (алгоритм Ноймайера).
+// Ошибка округления каждого сложения накапливается отдельно, поэтому длинная серия добавлений и вычитаний
+// не приводит к дрейфу суммы, как при обычном сложении double.
+struct CompensatedSum {
+    double sum{0.0};
+    double compensation{0.0};
+
+    void add(double value) {
+        double t = sum + value;
+        if (std::fabs(sum) >= std::fabs(value)) {
+            compensation += (sum - t) + value;
+        } else {
+            compensation += (value - t) + sum;
+        }
+        sum = t;
+    };
+
+    double value() const {
+        return sum + compensation;
+    };
+
+    // Умножение суммы на число (вместе с накопленной ошибкой).
+    void scale(double factor) {
+        sum *= factor;
+        compensation *= factor;
+    };
+};
+
+// Вклад одной фигуры в агрегаты коллекции.
+struct FigureContribution {
+    // false - пустая ячейка (nullptr), ничего не вносит.
+    bool present{false};
+    FigureKind kind{FigureKind::Unknown};
+    double area{0.0};
+    double perimeter{0.0};
+    double center_x{0.0};
+    double center_y{0.0};
+    BoundingBox<double> box;
+
+    template<Scalar T>
+    static FigureContribution of(const Figure<T>& figure) {
+        FigureContribution result;
+        result.present = true;
+        result.kind = figure.get_kind();
+        result.area = figure.square();
+        result.perimeter = figure.perimeter();
+        auto center = figure.geometric_center();
+        result.center_x = static_cast<double>(center->get_x());
+        result.center_y = static_cast<double>(center->get_y());
+        result.box = box_of(figure);
+        return result;
+    };
+
+    // Ограничивающий прямоугольник фигуры в координатах double.
+    template<Scalar T>
+    static BoundingBox<double> box_of(const Figure<T>& figure) {
+        auto figure_box = figure.bounding_box();
+        BoundingBox<double> result;
+        if (!figure_box.is_empty()) {
+            result.expand(static_cast<double>(figure_box.min_x), static_cast<double>(figure_box.min_y));
+            result.expand(static_cast<double>(figure_box.max_x), static_cast<double>(figure_box.max_y));
+        }
+        return result;
+    };
+};
+
+// Агрегаты коллекции фигур: количество фигур каждого вида, суммарные площадь и периметр,
+// сумма геометрических центров и общий ограничивающий прямоугольник.
+// Добавление и удаление фигуры выполняются за O(1). Общий прямоугольник при удалении фигуры,
+// касающейся его границы, нельзя уменьшить без просмотра остальных фигур, поэтому он помечается
+// недействительным и пересчитывается владельцем коллекции при следующем обращении.
+class FigureAggregates {
+    public:
+        void add(const FigureContribution& figure) {
+            if (!figure.present) {
+                return;
+            }
+            ++count;
+            ++counts[static_cast<std::size_t>(figure.kind)];
+            area.add(figure.area);
+            perimeter.add(figure.perimeter);
+            center_x.add(figure.center_x);
+            center_y.add(figure.center_y);
+            if (box_valid) {
+                box.expand(figure.box);
+            }
+        };
+
+        void remove(const FigureContribution& figure) {
+            if (!figure.present) {
+                return;
+            }
+            --count;
+            --counts[static_cast<std::size_t>(figure.kind)];
+            if (count == 0) {
+                // Коллекция опустела: сбрасываем суммы точно в ноль, без остатков округления.
+                clear();
+                return;
+            }
+            area.add(-figure.area);
+            perimeter.add(-figure.perimeter);
+            center_x.add(-figure.center_x);
+            center_y.add(-figure.center_y);
+            if (box_valid && !figure.box.is_empty() && box.touches_boundary_from_inside(figure.box)) {
+                box_valid = false;
+            }
+        };
+
+        void clear() {
+            *this = FigureAggregates{};
+        };
+
+        // Количество фигур (без пустых ячеек).
+        std::size_t get_count() const {
+            return count;
+        };
+
+        std::size_t get_count(FigureKind kind) const {
+            return counts[static_cast<std::size_t>(kind)];
+        };
+
+        const std::array<std::size_t, FIGURE_KIND_COUNT>& get_counts_by_kind() const {
+            return counts;
+        };
+
+        double get_total_area() const {
+            return area.value();
+        };
+
+        double get_total_perimeter() const {
+            return perimeter.value();
+        };
+
+        // Сумма геометрических центров фигур.
+        Point<double> get_centroid_sum() const {
+            return Point<double>(center_x.value(), center_y.value());
+        };
+
+        // Среднее геометрических центров фигур (начало координат для пустой коллекции).
+        Point<double> get_mean_centroid() const {
+            if (count == 0) {
+                return Point<double>(0.0, 0.0);
+            }
+            return Point<double>(center_x.value() / static_cast<double>(count), center_y.value() / static_cast<double>(count));
+        };
+
+        // Общий ограничивающий прямоугольник. Имеет смысл, только если has_valid_bounding_box().
+        const BoundingBox<double>& get_bounding_box() const {
+            return box;
+        };
+
+        bool has_valid_bounding_box() const {
+            return box_valid;
+        };
+
+        // Пересчёт агрегатов после применения преобразования подобия matrix ко всем фигурам:
+        // площади умножаются на |det|, периметры - на sqrt(|det|), сумма центров отображается линейной частью
+        // матрицы плюс count сдвигов. Прямоугольник без поворота переносится по углам, иначе помечается недействительным.
+        void transform(const Affine2D& matrix) {
+            if (count == 0) {
+                return;
+            }
+            area.scale(std::fabs(matrix.determinant()));
+            perimeter.scale(matrix.length_scale());
+            double sum_x = center_x.value();
+            double sum_y = center_y.value();
+            double n = static_cast<double>(count);
+            center_x = CompensatedSum{};
+            center_x.add(matrix.a * sum_x);
+            center_x.add(matrix.b * sum_y);
+            center_x.add(n * matrix.tx);
+            center_y = CompensatedSum{};
+            center_y.add(matrix.c * sum_x);
+            center_y.add(matrix.d * sum_y);
+            center_y.add(n * matrix.ty);
+            if (box_valid && matrix.is_axis_aligned() && !box.is_empty()) {
+                BoundingBox<double> moved;
+                moved.expand(matrix.apply(Point<double>(box.min_x, box.min_y)));
+                moved.expand(matrix.apply(Point<double>(box.max_x, box.max_y)));
+                box = moved;
+            } else if (!box.is_empty()) {
+                box_valid = false;
+            }
+        };
+
+        // Установка пересчитанного владельцем коллекции прямоугольника.
+        void set_bounding_box(const BoundingBox<double>& recomputed) {
+            box = recomputed;
+            box_valid = true;
+        };
+
+    private:
+        std::size_t count{0};
+        std::array<std::size_t, FIGURE_KIND_COUNT> counts{};
+        CompensatedSum area;
+        CompensatedSum perimeter;
+        CompensatedSum center_x;
+        CompensatedSum center_y;
+        BoundingBox<double> box;
+        bool box_valid{true};
+};
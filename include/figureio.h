@@ -0,0 +1,303 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "point.h"
+#include "figure.h"
+#include "rhombus.h"
+#include "pentagon.h"
+#include "hexagon.h"
+#include "validation.h"
+#include "ownership.h"
+#include "arrayoffigures.h"
+
+// Форматы файлов с фигурами.
+// Text   - одна фигура на строку: "<название> (x, y) (x, y) ...", например "rhombus (0, 1) (-1, 0) (0, -1) (1, 0)".
+// Binary - заголовок BinaryFigureHeader, за которым идут записи FigureRecord фиксированного размера.
+enum class FigureFileFormat {
+    Text,
+    Binary
+};
+
+// Максимальное количество вершин среди поддерживаемых фигур (шестиугольник).
+inline constexpr std::size_t MAX_FIGURE_VERTICES = 6;
+
+// Запись о фигуре - только вершины, без виртуальных функций и динамической памяти.
+// Используется для обмена данными между потоками чтения и обработки и как формат записи в двоичном файле,
+// поэтому тип обязан быть тривиально копируемым и иметь фиксированный размер.
+// Вид фигуры однозначно определяется количеством вершин: 4 - ромб, 5 - пятиугольник, 6 - шестиугольник.
+template<Scalar T>
+struct FigureRecord {
+    std::uint32_t vertex_count{0};
+    // Зарезервировано, всегда 0. Явное поле вместо неявного выравнивания, чтобы в файл не попадал мусор.
+    std::uint32_t reserved{0};
+    std::array<Point<T>, MAX_FIGURE_VERTICES> vertices{};
+};
+
+static_assert(std::is_trivially_copyable_v<FigureRecord<double>>);
+static_assert(std::is_standard_layout_v<FigureRecord<double>>);
+
+// Заголовок двоичного файла с фигурами.
+// Версия хранится в виде uint16_t, поэтому файл, записанный на машине с другим порядком байт,
+// будет отвергнут как файл неизвестной версии.
+struct BinaryFigureHeader {
+    char magic[4]{'F', 'I', 'G', 'S'};
+    std::uint16_t version{1};
+    // Размер скалярного типа координат и признак типа с плавающей точкой.
+    std::uint8_t scalar_size{0};
+    std::uint8_t scalar_is_floating{0};
+    // Количество записей. 0 означает "неизвестно" - читать до конца файла.
+    std::uint64_t count{0};
+};
+
+static_assert(sizeof(BinaryFigureHeader) == 16);
+
+inline constexpr std::uint16_t BINARY_FIGURE_FORMAT_VERSION = 1;
+
+// Получение записи из фигуры.
+template<Scalar T>
+FigureRecord<T> to_record(const Figure<T>& figure) {
+    FigureRecord<T> record;
+    record.vertex_count = static_cast<std::uint32_t>(figure.vertex_count());
+    if (record.vertex_count > MAX_FIGURE_VERTICES) {
+        throw std::invalid_argument("Figure has too many vertices for FigureRecord.");
+    }
+    for (std::size_t i = 0; i < record.vertex_count; ++i) {
+        record.vertices[i] = figure.vertex(i);
+    }
+    return record;
+}
+
+// Количество вершин фигуры данного вида (0 - неизвестный вид).
+constexpr std::uint32_t vertex_count_by_kind(FigureKind kind) {
+    switch (kind) {
+        case FigureKind::Rhombus: return 4;
+        case FigureKind::Pentagon: return 5;
+        case FigureKind::Hexagon: return 6;
+        default: return 0;
+    }
+}
+
+// Вид фигуры по количеству вершин (FigureKind::Unknown - неподдерживаемое количество).
+constexpr FigureKind figure_kind_by_vertex_count(std::uint32_t vertex_count) {
+    switch (vertex_count) {
+        case 4: return FigureKind::Rhombus;
+        case 5: return FigureKind::Pentagon;
+        case 6: return FigureKind::Hexagon;
+        default: return FigureKind::Unknown;
+    }
+}
+
+// Создание фигуры по записи без исключений: при некорректных данных возвращается причина отказа.
+// Указатель на фигуру создаётся политикой владения Ownership (см. ownership.h).
+template<class Ownership = SharedOwnership, Scalar T>
+std::expected<typename Ownership::template pointer<Figure<T>>, ValidationError> try_make_figure(const FigureRecord<T>& record) {
+    const auto& v = record.vertices;
+    auto wrap = [](auto&& created) -> std::expected<typename Ownership::template pointer<Figure<T>>, ValidationError> {
+        if (!created) {
+            return std::unexpected(created.error());
+        }
+        using Kind = typename std::remove_cvref_t<decltype(created)>::value_type;
+        return Ownership::template make<Kind>(std::move(*created));
+    };
+    switch (figure_kind_by_vertex_count(record.vertex_count)) {
+        case FigureKind::Rhombus:
+            return wrap(Rhombus<T>::try_create(v[0], v[1], v[2], v[3]));
+        case FigureKind::Pentagon:
+            return wrap(Pentagon<T>::try_create(v[0], v[1], v[2], v[3], v[4]));
+        case FigureKind::Hexagon:
+            return wrap(Hexagon<T>::try_create(v[0], v[1], v[2], v[3], v[4], v[5]));
+        default:
+            return std::unexpected(ValidationError::UnsupportedVertexCount);
+    }
+}
+
+// Создание фигуры по записи. Выполняются все проверки конструкторов фигур,
+// поэтому при некорректных данных выбрасывается std::invalid_argument (FigureValidationError).
+template<Scalar T>
+std::shared_ptr<Figure<T>> make_figure(const FigureRecord<T>& record) {
+    auto figure = try_make_figure(record);
+    if (!figure) {
+        throw FigureValidationError(figure.error());
+    }
+    return std::move(*figure);
+}
+
+// Отклонённая запись: её индекс во входных данных и причина отказа.
+struct FigureRejection {
+    std::size_t index{0};
+    ValidationError error{ValidationError::None};
+};
+
+// Построение фигур по набору записей за один проход без исключений.
+// Корректные фигуры добавляются в конец figures (ёмкость резервируется один раз),
+// некорректные записи - в rejected. Возвращает количество добавленных фигур.
+template<Scalar T, class Ownership>
+std::size_t try_build(std::span<const FigureRecord<T>> records, ArrayOfFigures<Figure<T>, Ownership>& figures,
+                      std::vector<FigureRejection>& rejected) {
+    figures.reserve(figures.get_size() + records.size());
+    std::size_t built = 0;
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        auto figure = try_make_figure<Ownership>(records[i]);
+        if (figure) {
+            figures.add_figure(std::move(*figure));
+            ++built;
+        } else {
+            rejected.push_back(FigureRejection{i, figure.error()});
+        }
+    }
+    return built;
+}
+
+// Количество вершин фигуры по её названию в текстовом формате (0 - неизвестная фигура).
+// Названия берутся из общей таблицы видов фигур.
+inline std::uint32_t vertex_count_by_name(std::string_view name) {
+    for (std::size_t i = 1; i < FIGURE_KIND_COUNT; ++i) {
+        auto kind = static_cast<FigureKind>(i);
+        if (name == figure_kind_name(kind)) {
+            return vertex_count_by_kind(kind);
+        }
+    }
+    return 0;
+}
+
+// Название фигуры в текстовом формате по количеству вершин.
+inline std::string_view name_by_vertex_count(std::uint32_t vertex_count) {
+    FigureKind kind = figure_kind_by_vertex_count(vertex_count);
+    return kind == FigureKind::Unknown ? std::string_view("unknown") : figure_kind_name(kind);
+}
+
+// Разбор одной строки текстового формата.
+// Строка, которую не удалось разобрать, превращается в запись с vertex_count == 0 -
+// такая запись будет отвергнута make_figure.
+template<Scalar T>
+void parse_text_record(const std::string& line, FigureRecord<T>& record) {
+    record = FigureRecord<T>{};
+    std::istringstream line_stream(line);
+    std::string name;
+    line_stream >> name;
+    std::uint32_t count = vertex_count_by_name(name);
+    Point<T> point;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        if (!(line_stream >> point)) {
+            count = 0;
+            break;
+        }
+        record.vertices[i] = point;
+    }
+    record.vertex_count = count;
+}
+
+// Чтение следующей непустой строки текстового формата. Возвращает false, если поток закончился.
+inline bool read_text_line(std::istream& is, std::string& line) {
+    while (std::getline(is, line)) {
+        if (line.find_first_not_of(" \t\r") != std::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Чтение одной записи из текстового потока. Возвращает false, если поток закончился.
+// Пустые строки пропускаются.
+template<Scalar T>
+bool read_text_record(std::istream& is, FigureRecord<T>& record) {
+    std::string line;
+    if (!read_text_line(is, line)) {
+        return false;
+    }
+    parse_text_record(line, record);
+    return true;
+}
+
+// Запись одной фигуры в текстовый поток.
+template<Scalar T>
+void write_text_record(std::ostream& os, const FigureRecord<T>& record) {
+    os << name_by_vertex_count(record.vertex_count);
+    for (std::uint32_t i = 0; i < record.vertex_count; ++i) {
+        os << ' ' << record.vertices[i];
+    }
+    os << '\n';
+}
+
+// Запись заголовка двоичного файла.
+template<Scalar T>
+void write_binary_header(std::ostream& os, std::uint64_t count = 0) {
+    BinaryFigureHeader header;
+    header.version = BINARY_FIGURE_FORMAT_VERSION;
+    header.scalar_size = sizeof(T);
+    header.scalar_is_floating = std::is_floating_point_v<T> ? 1 : 0;
+    header.count = count;
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+// Проверка заголовка двоичного файла на совместимость с типом координат T.
+// При несовпадении сигнатуры, версии или типа координат выбрасывается std::runtime_error.
+template<Scalar T>
+void check_binary_header(const BinaryFigureHeader& header) {
+    if (std::memcmp(header.magic, "FIGS", 4) != 0) {
+        throw std::runtime_error("Invalid figure file: bad signature.");
+    }
+    if (header.version != BINARY_FIGURE_FORMAT_VERSION) {
+        throw std::runtime_error("Invalid figure file: unsupported format version.");
+    }
+    if (header.scalar_size != sizeof(T) || header.scalar_is_floating != (std::is_floating_point_v<T> ? 1 : 0)) {
+        throw std::runtime_error("Invalid figure file: coordinate type mismatch.");
+    }
+}
+
+// Чтение и проверка заголовка двоичного файла.
+template<Scalar T>
+BinaryFigureHeader read_binary_header(std::istream& is) {
+    BinaryFigureHeader header;
+    if (!is.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        throw std::runtime_error("Invalid figure file: header is truncated.");
+    }
+    check_binary_header<T>(header);
+    return header;
+}
+
+// Чтение одной записи из двоичного потока. Возвращает false, если поток закончился ровно на границе записи;
+// если прочитана только часть записи, выбрасывается std::runtime_error (файл обрезан).
+template<Scalar T>
+bool read_binary_record(std::istream& is, FigureRecord<T>& record) {
+    if (is.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+        return true;
+    }
+    if (is.gcount() != 0) {
+        throw std::runtime_error("Invalid figure file: records are truncated.");
+    }
+    return false;
+}
+
+// Количество записей, которое нужно прочитать после заголовка: header.count или «до конца потока», если 0.
+// Записи после header.count не читаются (так же их не видит MappedFigures).
+inline std::uint64_t binary_records_expected(const BinaryFigureHeader& header) {
+    return header.count == 0 ? std::numeric_limits<std::uint64_t>::max() : header.count;
+}
+
+// Проверка, что поток не закончился раньше, чем записано в заголовке (read - количество прочитанных записей).
+inline void check_binary_record_count(const BinaryFigureHeader& header, std::uint64_t read) {
+    if (header.count != 0 && read < header.count) {
+        throw std::runtime_error("Invalid figure file: records are truncated.");
+    }
+}
+
+// Запись одной фигуры в двоичный поток.
+template<Scalar T>
+void write_binary_record(std::ostream& os, const FigureRecord<T>& record) {
+    os.write(reinterpret_cast<const char*>(&record), sizeof(record));
+}
@@ -0,0 +1,280 @@
+#pragma once
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "point.h"
+#include "figure.h"
+#include "figureio.h"
+
+// Потоковая обработка файлов с фигурами, которые не помещаются в память.
+// Фигуры читаются блоками фиксированного размера, поэтому расход памяти не зависит от размера файла:
+// одновременно в памяти находятся не более двух блоков (двойная буферизация).
+
+// Чтение записей о фигурах из потока блоками.
+template<Scalar T>
+class FigureChunkReader {
+    public:
+        FigureChunkReader(std::istream& input, FigureFileFormat file_format, std::size_t chunk)
+            : is(input), format(file_format), chunk_size(chunk == 0 ? 1 : chunk) {
+            if (format == FigureFileFormat::Binary) {
+                header = read_binary_header<T>(is);
+                remaining = binary_records_expected(header);
+            }
+        };
+
+        // Заполнение блока записями (не более chunk_size). Предыдущее содержимое блока удаляется,
+        // но выделенная память переиспользуется. Возвращает false, если записей больше нет.
+        bool next_chunk(std::vector<FigureRecord<T>>& chunk) {
+            chunk.clear();
+            chunk.reserve(chunk_size);
+            FigureRecord<T> record;
+            while (chunk.size() < chunk_size && read_record(record)) {
+                chunk.push_back(record);
+            }
+            return !chunk.empty();
+        };
+
+        std::size_t get_chunk_size() const {
+            return chunk_size;
+        };
+
+    private:
+        std::istream& is;
+        FigureFileFormat format;
+        std::size_t chunk_size;
+        BinaryFigureHeader header;
+        // Сколько двоичных записей ещё ожидается по заголовку.
+        std::uint64_t remaining{0};
+        std::uint64_t read_count{0};
+
+        bool read_record(FigureRecord<T>& record) {
+            if (format == FigureFileFormat::Binary) {
+                if (remaining == 0 || !read_binary_record(is, record)) {
+                    check_binary_record_count(header, read_count);
+                    return false;
+                }
+                --remaining;
+                ++read_count;
+                return true;
+            }
+            return read_text_record(is, record);
+        };
+};
+
+// Накопленные результаты потоковой обработки.
+struct StreamTotals {
+    // Количество прочитанных записей.
+    std::size_t read{0};
+    // Количество записей, не прошедших проверку конструкторами фигур.
+    std::size_t rejected{0};
+    // Количество фигур, отброшенных фильтрами.
+    std::size_t filtered{0};
+    // Количество фигур, прошедших все стадии.
+    std::size_t accepted{0};
+    // Суммарные площадь и периметр принятых фигур.
+    double total_square{0.0};
+    double total_perimeter{0.0};
+    // Количество обработанных блоков.
+    std::size_t chunks{0};
+};
+
+// Конвейер потоковой обработки фигур.
+// Стадии: чтение и проверка (валидация конструкторами фигур) -> фильтры и преобразования в порядке добавления
+// -> накопление площади и периметра -> приёмник (sink).
+// Чтение и проверка блока k + 1 выполняются в отдельном потоке (одном на весь запуск), пока блок k проходит остальные стадии.
+//
+// Пример использования:
+// FigureStreamPipeline<double> pipeline(4096);
+// pipeline.filter([](const Figure<double>& f) { return f.square() > 1.0; })
+//         .sink([](const Figure<double>& f) { std::cout << f; });
+// StreamTotals totals = pipeline.run(file, FigureFileFormat::Text);
+template<Scalar T>
+class FigureStreamPipeline {
+    public:
+        using FigurePtr = std::shared_ptr<Figure<T>>;
+        // Стадия конвейера: принимает фигуру и возвращает её (или другую фигуру), nullptr - отбросить фигуру.
+        using Stage = std::function<FigurePtr(FigurePtr)>;
+
+        explicit FigureStreamPipeline(std::size_t chunk = 4096) : chunk_size(chunk == 0 ? 1 : chunk) {};
+
+        // Добавление фильтра: фигуры, для которых предикат вернул false, отбрасываются.
+        FigureStreamPipeline& filter(std::function<bool(const Figure<T>&)> predicate) {
+            stages.push_back([predicate = std::move(predicate)](FigurePtr figure) -> FigurePtr {
+                return predicate(*figure) ? figure : nullptr;
+            });
+            return *this;
+        };
+
+        // Добавление преобразования фигуры.
+        FigureStreamPipeline& transform(Stage stage) {
+            stages.push_back(std::move(stage));
+            return *this;
+        };
+
+        // Приёмник для каждой принятой фигуры. Вызывается по мере обработки, в порядке чтения.
+        FigureStreamPipeline& sink(std::function<void(const Figure<T>&)> consumer) {
+            figure_sink = std::move(consumer);
+            return *this;
+        };
+
+        // Обработчик, вызываемый после каждого блока с промежуточными итогами.
+        FigureStreamPipeline& on_chunk(std::function<void(const StreamTotals&)> callback) {
+            chunk_callback = std::move(callback);
+            return *this;
+        };
+
+        std::size_t get_chunk_size() const {
+            return chunk_size;
+        };
+
+        // Запуск конвейера над потоком. Возвращает итоговые результаты.
+        // Ошибка чтения пробрасывается после обработки блоков, прочитанных до неё.
+        StreamTotals run(std::istream& is, FigureFileFormat format) const {
+            FigureChunkReader<T> reader(is, format, chunk_size);
+            StreamTotals totals;
+
+            // Два буфера: пока вызывающий поток обрабатывает блок k, поток чтения заполняет блок k + 1.
+            // Поток чтения один на весь запуск; блок k всегда лежит в буфере k % 2, и поток чтения
+            // берёт буфер только после того, как обработан блок, лежавший в нём раньше.
+            std::array<ParsedChunk, 2> buffers;
+            std::mutex mutex;
+            std::condition_variable changed;
+            std::size_t produced = 0;
+            std::size_t consumed = 0;
+            bool finished = false;
+            bool stopping = false;
+            std::exception_ptr error;
+
+            std::thread parser([&]() {
+                try {
+                    for (std::size_t k = 0;; ++k) {
+                        {
+                            std::unique_lock<std::mutex> lock(mutex);
+                            changed.wait(lock, [&]() { return stopping || k < consumed + buffers.size(); });
+                            if (stopping) {
+                                break;
+                            }
+                        }
+                        if (!parse_chunk(reader, buffers[k % buffers.size()])) {
+                            break;
+                        }
+                        {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            produced = k + 1;
+                        }
+                        changed.notify_all();
+                    }
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    error = std::current_exception();
+                }
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    finished = true;
+                }
+                changed.notify_all();
+            });
+
+            try {
+                for (std::size_t k = 0;; ++k) {
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        changed.wait(lock, [&]() { return k < produced || finished; });
+                        if (k >= produced) {
+                            break;
+                        }
+                    }
+                    process_chunk(buffers[k % buffers.size()], totals);
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        consumed = k + 1;
+                    }
+                    changed.notify_all();
+                }
+            } catch (...) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    stopping = true;
+                }
+                changed.notify_all();
+                parser.join();
+                throw;
+            }
+            parser.join();
+            if (error) {
+                std::rethrow_exception(error);
+            }
+            return totals;
+        };
+
+    private:
+        // Блок после чтения и проверки: фигуры, прошедшие проверку, и количество отвергнутых записей.
+        struct ParsedChunk {
+            std::vector<FigureRecord<T>> records;
+            std::vector<FigurePtr> figures;
+            std::size_t rejected{0};
+        };
+
+        std::size_t chunk_size;
+        std::vector<Stage> stages;
+        std::function<void(const Figure<T>&)> figure_sink;
+        std::function<void(const StreamTotals&)> chunk_callback;
+
+        // Чтение блока и построение фигур. Выполняется в потоке чтения.
+        static bool parse_chunk(FigureChunkReader<T>& reader, ParsedChunk& chunk) {
+            chunk.figures.clear();
+            chunk.rejected = 0;
+            if (!reader.next_chunk(chunk.records)) {
+                return false;
+            }
+            chunk.figures.reserve(chunk.records.size());
+            for (const auto& record : chunk.records) {
+                if (auto figure = try_make_figure(record)) {
+                    chunk.figures.push_back(std::move(*figure));
+                } else {
+                    ++chunk.rejected;
+                }
+            }
+            return true;
+        };
+
+        // Прохождение блока через стадии конвейера. Фигуры блока освобождаются по мере обработки.
+        void process_chunk(ParsedChunk& chunk, StreamTotals& totals) const {
+            totals.read += chunk.records.size();
+            totals.rejected += chunk.rejected;
+            for (auto& figure : chunk.figures) {
+                FigurePtr current = std::move(figure);
+                for (const auto& stage : stages) {
+                    current = stage(std::move(current));
+                    if (!current) {
+                        break;
+                    }
+                }
+                if (!current) {
+                    ++totals.filtered;
+                    continue;
+                }
+                ++totals.accepted;
+                totals.total_square += current->square();
+                totals.total_perimeter += current->perimeter();
+                if (figure_sink) {
+                    figure_sink(*current);
+                }
+            }
+            chunk.figures.clear();
+            ++totals.chunks;
+            if (chunk_callback) {
+                chunk_callback(totals);
+            }
+        };
+};
@@ -0,0 +1,138 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include "point.h"
+#include "figure.h"
+
+// Что считается дубликатом фигуры.
+enum class DeduplicationMode : std::uint8_t {
+    // Та же фигура на том же месте: совпадают вершины (с любой начальной вершиной и в любом направлении обхода).
+    Identical,
+    // Конгруэнтная фигура: совпадает с точностью до сдвига, поворота и отражения.
+    Congruent
+};
+
+// Каноническая геометрическая сигнатура фигуры: вид, количество вершин и квантованные величины,
+// не зависящие от выбора начальной вершины и направления обхода.
+// Identical - квантованные координаты вершин; Congruent - для каждой вершины длина стороны и косинус
+// и модуль синуса угла со следующей стороной (фигуры выпуклые, поэтому этого достаточно).
+// Из нескольких вариантов последовательности (все начальные вершины, оба направления) выбирается
+// лексикографически наименьший. Величины округляются до кратных quantum, поэтому фигуры, отличающиеся
+// меньше чем на quantum, как правило имеют одну сигнатуру (кроме значений у самой границы округления).
+struct GeometricSignature {
+    // Максимальное количество вершин фигуры, для которой строится сигнатура.
+    static constexpr std::size_t MAX_VERTICES = 8;
+    // Количество величин на вершину.
+    static constexpr std::size_t VALUES_PER_VERTEX = 3;
+
+    FigureKind kind{FigureKind::Unknown};
+    DeduplicationMode mode{DeduplicationMode::Identical};
+    std::uint8_t vertex_count{0};
+    std::array<std::int64_t, MAX_VERTICES * VALUES_PER_VERTEX> values{};
+
+    bool operator==(const GeometricSignature& other) const = default;
+
+    template<Scalar T>
+    static GeometricSignature of(const Figure<T>& figure, DeduplicationMode mode = DeduplicationMode::Identical, double quantum = 1e-6) {
+        if (!(quantum > 0.0)) {
+            throw std::invalid_argument("Signature quantum must be positive.");
+        }
+        auto vertices = figure.vertices();
+        const std::size_t n = vertices.size();
+        if (n > MAX_VERTICES) {
+            throw std::invalid_argument("Too many vertices for a geometric signature.");
+        }
+        GeometricSignature result;
+        result.kind = figure.get_kind();
+        result.mode = mode;
+        result.vertex_count = static_cast<std::uint8_t>(n);
+        if (n == 0) {
+            return result;
+        }
+
+        // Точки в порядке обхода и в обратном порядке.
+        std::array<Point<double>, MAX_VERTICES> forward;
+        std::array<Point<double>, MAX_VERTICES> backward;
+        for (std::size_t i = 0; i < n; ++i) {
+            forward[i] = Point<double>(static_cast<double>(vertices[i].get_x()), static_cast<double>(vertices[i].get_y()));
+            backward[n - 1 - i] = forward[i];
+        }
+        auto quantize = [quantum](double value) {
+            return static_cast<std::int64_t>(std::llround(value / quantum));
+        };
+        // Величины одной вершины для выбранного направления обхода.
+        using Entry = std::array<std::int64_t, VALUES_PER_VERTEX>;
+        auto entries = [&](const std::array<Point<double>, MAX_VERTICES>& points) {
+            std::array<Entry, MAX_VERTICES> out{};
+            for (std::size_t i = 0; i < n; ++i) {
+                if (mode == DeduplicationMode::Identical) {
+                    out[i] = Entry{quantize(points[i].get_x()), quantize(points[i].get_y()), 0};
+                } else {
+                    Point<double> edge = points[(i + 1) % n] - points[i];
+                    Point<double> next = points[(i + 2) % n] - points[(i + 1) % n];
+                    double length = std::sqrt(squared_norm(edge));
+                    double norms = length * std::sqrt(squared_norm(next));
+                    double cosine = norms > 0.0 ? dot(edge, next) / norms : 0.0;
+                    double sine = norms > 0.0 ? std::fabs(cross(edge, next)) / norms : 0.0;
+                    out[i] = Entry{quantize(length), quantize(cosine), quantize(sine)};
+                }
+            }
+            return out;
+        };
+
+        const std::array<std::array<Entry, MAX_VERTICES>, 2> sequences = {entries(forward), entries(backward)};
+        const std::array<Entry, MAX_VERTICES>* best = &sequences[0];
+        std::size_t best_start = 0;
+        auto less = [n](const std::array<Entry, MAX_VERTICES>& a, std::size_t start_a,
+                        const std::array<Entry, MAX_VERTICES>& b, std::size_t start_b) {
+            for (std::size_t k = 0; k < n; ++k) {
+                const Entry& x = a[(start_a + k) % n];
+                const Entry& y = b[(start_b + k) % n];
+                if (x != y) {
+                    return x < y;
+                }
+            }
+            return false;
+        };
+        for (const auto& sequence : sequences) {
+            for (std::size_t start = 0; start < n; ++start) {
+                if (less(sequence, start, *best, best_start)) {
+                    best = &sequence;
+                    best_start = start;
+                }
+            }
+        }
+        for (std::size_t k = 0; k < n; ++k) {
+            const Entry& entry = (*best)[(best_start + k) % n];
+            std::copy(entry.begin(), entry.end(), result.values.begin() + k * VALUES_PER_VERTEX);
+        }
+        return result;
+    };
+};
+
+// Хеш сигнатуры для std::unordered_set / std::unordered_map.
+template<>
+struct std::hash<GeometricSignature> {
+    std::size_t operator()(const GeometricSignature& signature) const noexcept {
+        // Перемешивание в стиле splitmix64 для каждой величины.
+        auto mix = [](std::uint64_t h, std::uint64_t value) {
+            h ^= value + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+            h ^= h >> 30;
+            h *= 0xBF58476D1CE4E5B9ull;
+            h ^= h >> 27;
+            return h;
+        };
+        std::uint64_t h = mix(static_cast<std::uint64_t>(signature.kind),
+                              (static_cast<std::uint64_t>(signature.mode) << 8) | signature.vertex_count);
+        const std::size_t used = signature.vertex_count * GeometricSignature::VALUES_PER_VERTEX;
+        for (std::size_t i = 0; i < used; ++i) {
+            h = mix(h, static_cast<std::uint64_t>(signature.values[i]));
+        }
+        return static_cast<std::size_t>(h);
+    };
+};
@@ -1,8 +1,15 @@
 #pragma once
 #include <memory>
 #include <string>
+#include <string_view>
 #include "point.h"
 #include "figure.h"
+#include "validation.h"
+#include <expected>
+#include "regularpolygon.h"
+#include <array>
+#include <span>
+#include <concepts>
 #include <cmath>
 #include <stdexcept>
 #include <iostream>
@@ -12,75 +19,56 @@ template<Scalar T>
 class Hexagon : public Figure<T> {
     public:
         // Конструктор по умолчанию.
-        Hexagon() : Figure<T>("hexagon") {};
+        Hexagon() : Figure<T>(FigureKind::Hexagon) {};
         // Конструктор точками.
-        Hexagon(const Point<T>& p1, const Point<T>& p2, const Point<T>& p3, const Point<T>& p4, const Point<T>& p5, const Point<T>& p6, std::string description = "hexagon")
-            : Figure<T>(description) {
-                // Координаты векторов сторон шестиугольника.
-                Point AB = Point(p1.get_x() - p2.get_x(), p1.get_y() - p2.get_y());
-                Point BC = Point(p2.get_x() - p3.get_x(), p2.get_y() - p3.get_y());
-                Point CD = Point(p3.get_x() - p4.get_x(), p3.get_y() - p4.get_y());
-                Point DE = Point(p4.get_x() - p5.get_x(), p4.get_y() - p5.get_y());
-                Point EF = Point(p5.get_x() - p6.get_x(), p5.get_y() - p6.get_y());
-                Point FA = Point(p6.get_x() - p1.get_x(), p6.get_y() - p1.get_y());
-                // Проверка, что все стороны равны (с учётом небольшой погрешности)
-                const double SIDE_EPS = 1e-6;
-                if (std::fabs(distance(p1, p2) - distance(p2, p3)) > SIDE_EPS ||
-                    std::fabs(distance(p2, p3) - distance(p3, p4)) > SIDE_EPS ||
-                    std::fabs(distance(p3, p4) - distance(p4, p5)) > SIDE_EPS ||
-                    std::fabs(distance(p4, p5) - distance(p5, p6)) > SIDE_EPS ||
-                    std::fabs(distance(p5, p6) - distance(p6, p1)) > SIDE_EPS) {
-                    throw std::invalid_argument("Invalid hexagon points: all sides must be equal.");
-                }
-                // Проверка, что мы можем вписать правильный шестиугольник в окружность
-                Point<T> center = Point<T>((p1.get_x() + p2.get_x() + p3.get_x() + p4.get_x() + p5.get_x() + p6.get_x()) / 6.0,
-                                                   (p1.get_y() + p2.get_y() + p3.get_y() + p4.get_y() + p5.get_y() + p6.get_y()) / 6.0);
-                double radius = distance(center, p1);
-                const double CONCYCLIC_EPS = 1e-6;
-                for (const auto& point : {p1, p2, p3, p4, p5, p6}) {
-                    if (std::fabs(distance(center, point) - radius) > CONCYCLIC_EPS) {
-                        throw std::invalid_argument("Invalid hexagon points: points must be concyclic.");
-                    }
+        Hexagon(const Point<T>& p1, const Point<T>& p2, const Point<T>& p3, const Point<T>& p4, const Point<T>& p5, const Point<T>& p6, std::string_view description = {})
+            : Figure<T>(FigureKind::Hexagon, description) {
+                if (ValidationError error = validation_error(p1, p2, p3, p4, p5, p6); error != ValidationError::None) {
+                    FIGURES_VALIDATION_FAILURE(validation_error_message(error));
+                    throw FigureValidationError(error);
                 }
                 // Если проверки пройдены, сохраняем точки.
-                points[0] = std::make_unique<Point<T>>(p1);
-                points[1] = std::make_unique<Point<T>>(p2);
-                points[2] = std::make_unique<Point<T>>(p3);
-                points[3] = std::make_unique<Point<T>>(p4);
-                points[4] = std::make_unique<Point<T>>(p5);
-                points[5] = std::make_unique<Point<T>>(p6);
+                points = {p1, p2, p3, p4, p5, p6};
         };
 
-        // Перегрузка операторов = копирования и перемещения.
-        // Конструктор копирования.
-        Hexagon(const Hexagon& other){
-            for (int i = 0; i < 6; ++i) {
-                points[i] = std::make_unique<Point<T>>(*other.points[i]);
+        // Правильный шестиугольник с центром center и радиусом описанной окружности radius,
+        // первая вершина повёрнута на angle радиан. Вершины строятся по таблице единичной окружности,
+        // поэтому проверка конструктора не нужна, а площадь и периметр сохраняются в замкнутой форме.
+        static Hexagon regular(const Point<T>& center, T radius, double angle = 0.0, std::string_view description = {})
+        requires std::floating_point<T> {
+            return Hexagon(regular_polygon_vertices<6>(center, radius, angle), MeasureCache::regular<6>(radius), description);
+        };
+
+        // Создание фигуры без исключений: при некорректных точках возвращается причина отказа.
+        // Предназначено для массовой проверки недоверенных данных, где отказы - обычный случай.
+        static std::expected<Hexagon, ValidationError> try_create(const Point<T>& p1, const Point<T>& p2, const Point<T>& p3, const Point<T>& p4, const Point<T>& p5, const Point<T>& p6, std::string_view description = {}) {
+            if (ValidationError error = validation_error(p1, p2, p3, p4, p5, p6); error != ValidationError::None) {
+                FIGURES_VALIDATION_FAILURE(validation_error_message(error));
+                return std::unexpected(error);
             }
+            return Hexagon(std::array<Point<T>, 6>{p1, p2, p3, p4, p5, p6}, MeasureCache{}, description);
         };
+
+        // Перегрузка операторов = копирования и перемещения.
+        // Конструктор копирования.
+        Hexagon(const Hexagon& other) : Figure<T>(other), points(other.points), measures(other.measures) {};
         // Перегрузка копирования.
         Hexagon& operator=(const Hexagon& other) {
             if (this != &other) {
-                for (int i = 0; i < 6; ++i) {
-                    points[i] = std::make_unique<Point<T>>(*other.points[i]);
-                }
+                Figure<T>::operator=(other);
+                measures = other.measures;
+                points = other.points;
             }
             return *this;
         };
         // Конструктор перемещения.
-        Hexagon(Hexagon&& other) noexcept {
-            if (this != &other) {
-                for (int i = 0; i < 6; ++i) {
-                    points[i] = std::move(other.points[i]);
-                }
-            }
-        };
+        Hexagon(Hexagon&& other) noexcept : Figure<T>(std::move(other)), points(other.points), measures(other.measures) {};
         // Перегрузка перемещения.
         Hexagon& operator=(Hexagon&& other) noexcept {
             if (this != &other) {
-                for (int i = 0; i < 6; ++i) {
-                    points[i] = std::move(other.points[i]);
-                }
+                Figure<T>::operator=(std::move(other));
+                measures = other.measures;
+                points = other.points;
             }
             return *this;
         };
@@ -97,9 +85,11 @@ class Hexagon : public Figure<T> {
 
         // Переопределение виртуальных методов базового класса.
         std::unique_ptr<Point<T>> geometric_center() const override {
-            double center_x = (points[0]->get_x() + points[2]->get_x() + points[1]->get_x() + points[3]->get_x() + points[4]->get_x() + points[5]->get_x()) / 6.0;
-            double center_y = (points[0]->get_y() + points[2]->get_y() + points[1]->get_y() + points[3]->get_y() + points[4]->get_y() + points[5]->get_y()) / 6.0;
-            return std::make_unique<Point<T>>(center_x, center_y);
+            Point<T> sum = points[0];
+            for (std::size_t i = 1; i < 6; ++i) {
+                sum += points[i];
+            }
+            return std::make_unique<Point<T>>(sum.get_x() / 6.0, sum.get_y() / 6.0);
         };
         // Вычисление площади трапеции с помощью формулы площади многоугольника.
         /*
@@ -110,19 +100,24 @@ class Hexagon : public Figure<T> {
         Для 4 точек A→B→C→D→A: S = 1/2 · |x_A y_B + x_B y_C + x_C y_D + x_D y_A − (y_A x_B + y_B x_C + y_C x_D + y_D x_A)|
         */
         double square() const override {
-            double sum = 0.0;
-            for (int i = 0; i < 6; ++i) {
-                int next = (i + 1) % 6;
-                sum += (points[i]->get_x() * points[next]->get_y() - 
-                        points[i]->get_y() * points[next]->get_x());
+            if (measures.has_area()) {
+                return measures.area;
+            }
+            // Последнее слагаемое вынесено из цикла, чтобы в цикле не было взятия по модулю.
+            double sum = cross(points[5], points[0]);
+            for (std::size_t i = 0; i + 1 < 6; ++i) {
+                sum += cross(points[i], points[i + 1]);
             }
             return std::fabs(sum) / 2.0;
         };
         // Вычисление периметра шестиугольника.
         double perimeter() const override{
-            double res = 0;
-            for (int i = 0; i < 6; ++i) {
-                res += distance(*points[i], *points[(i + 1) % 6]);
+            if (measures.has_perimeter()) {
+                return measures.perimeter;
+            }
+            double res = std::sqrt(static_cast<double>(squared_norm(points[0] - points[5])));
+            for (std::size_t i = 0; i + 1 < 6; ++i) {
+                res += std::sqrt(static_cast<double>(squared_norm(points[i + 1] - points[i])));
             }
             return res;
         };
@@ -134,26 +129,77 @@ class Hexagon : public Figure<T> {
             return this->square();
         };
 
+        // Проверка точек фигуры. Используется конструктором и is_valid().
+        // Возвращает причину отказа или ValidationError::None, если точки образуют правильный шестиугольник.
+        static ValidationError validation_error(const Point<T>& p1, const Point<T>& p2, const Point<T>& p3, const Point<T>& p4, const Point<T>& p5, const Point<T>& p6) {
+            switch (check_regular_polygon<6>(std::array<Point<T>, 6>{p1, p2, p3, p4, p5, p6})) {
+                case RegularityCheck::UnequalSides:
+                    return ValidationError::HexagonUnequalSides;
+                case RegularityCheck::NotConcyclic:
+                    return ValidationError::HexagonNotConcyclic;
+                default:
+                    return ValidationError::None;
+            }
+        };
+
+        // Проверка, что фигура по-прежнему корректна (например, после чтения из потока).
+        bool is_valid() const override {
+            return validation_error(points[0], points[1], points[2], points[3], points[4], points[5]) == ValidationError::None;
+        };
+
+        // Доступ к вершинам фигуры.
+        std::size_t vertex_count() const override {
+            return 6;
+        };
+        Point<T> vertex(std::size_t index) const override {
+            return points[index];
+        };
+        std::span<const Point<T>> vertices() const override {
+            return points;
+        };
+
+        // Преобразование вершин (один проход по массиву, лежащему внутри объекта).
+        void transform_unchecked(const Affine2D& matrix) override {
+            for (auto& point : points) {
+                point = matrix.apply(point);
+            }
+            measures.transform(matrix);
+        };
+
         // Перегрузка операторов ввода/вывода.
         void print(std::ostream& os) const override{
             for (const auto& point : points) {
-                os << *point << std::endl;
+                os << point << std::endl;
             }
         };
         void read(std::istream& is) override{
+            measures = MeasureCache{};
             Point<T> temp;
             for (auto& point : points) {
                 is >> temp;
-                point = std::make_unique<Point<T>>(temp);
+                point = temp;
             }
         };
 
         // Функция для клонирования фигуры.
         std::shared_ptr<Figure<T>> clone() const override{
-            return std::make_shared<Hexagon<T>>(*points[0], *points[1], *points[2], *points[3], *points[4], *points[5]);
+            FIGURES_COUNT(Cloned);
+            return std::make_shared<Hexagon>(*this);
+        };
+        std::unique_ptr<Figure<T>> clone_unique() const override{
+            FIGURES_COUNT(Cloned);
+            return std::make_unique<Hexagon>(*this);
         };
 
     private:
-        std::unique_ptr<Point<T>> points[6];
+        // Конструктор для вершин, корректных по построению или уже проверенных (без проверки).
+        Hexagon(const std::array<Point<T>, 6>& checked_points, MeasureCache cache, std::string_view description)
+            : Figure<T>(FigureKind::Hexagon, description), points(checked_points), measures(cache) {};
+
+        // Вершины хранятся внутри объекта подряд (без отдельных выделений памяти),
+        // выравнивание позволяет загружать точку double одной инструкцией.
+        alignas(2 * sizeof(T)) std::array<Point<T>, 6> points{};
+        // Сохранённые площадь и периметр (заполнены только у фигур, созданных через regular()).
+        MeasureCache measures;
 
 };
\ No newline at end of file
@@ -0,0 +1,366 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "point.h"
+#include "figure.h"
+#include "figureio.h"
+#include "boundedqueue.h"
+#include "arrayoffigures.h"
+
+// Многопоточная загрузка фигур в ArrayOfFigures.
+// Стадии соединены ограниченными неблокирующими очередями:
+// поток чтения -> [входная очередь] -> рабочие потоки (разбор и проверка) -> [выходная очередь] -> приёмник (add_figure).
+// Если очередь заполнена, производитель ждёт (обратное давление), поэтому расход памяти ограничен ёмкостью очередей.
+
+// Настройки конвейера загрузки.
+struct IngestOptions {
+    // Количество рабочих потоков разбора и проверки.
+    unsigned workers{std::max(1u, std::thread::hardware_concurrency())};
+    // Ёмкость каждой из очередей (округляется вверх до степени двойки).
+    std::size_t queue_capacity{1024};
+    // Сохранять ли порядок фигур из входного потока.
+    bool ordered{true};
+};
+
+// Статистика одной стадии конвейера.
+struct StageStats {
+    // Количество обработанных стадией элементов.
+    std::size_t items{0};
+    // Количество потоков стадии.
+    unsigned threads{1};
+    // Время работы стадии от запуска до завершения.
+    double wall_seconds{0.0};
+    // Ожидания на очередях (суммарно по всем потокам стадии).
+    QueueWaitStats waits;
+
+    // Пропускная способность стадии (элементов в секунду).
+    double throughput() const {
+        return wall_seconds > 0.0 ? static_cast<double>(items) / wall_seconds : 0.0;
+    };
+
+    // Доля времени, которую потоки стадии были заняты работой, а не ожиданием на очередях.
+    double utilization() const {
+        double total = wall_seconds * threads;
+        return total > 0.0 ? std::clamp(1.0 - waits.wait_seconds / total, 0.0, 1.0) : 0.0;
+    };
+};
+
+// Статистика заполненности очереди. Глубина измеряется после каждого добавления элемента.
+struct QueueDepthStats {
+    std::size_t capacity{0};
+    std::size_t max_depth{0};
+    double mean_depth{0.0};
+};
+
+// Итоговая статистика загрузки.
+// Как читать: если рабочие потоки загружены почти полностью, а входная очередь обычно заполнена -
+// рабочих потоков не хватает; если входная очередь обычно пуста - узким местом является чтение.
+struct IngestStats {
+    StageStats reader;
+    StageStats workers;
+    StageStats sink;
+    QueueDepthStats input_queue;
+    QueueDepthStats output_queue;
+    std::size_t accepted{0};
+    std::size_t rejected{0};
+    double elapsed_seconds{0.0};
+
+    friend std::ostream& operator<<(std::ostream& os, const IngestStats& stats) {
+        auto print_stage = [&os](const char* name, const StageStats& stage) {
+            os << name << ": items=" << stage.items << " threads=" << stage.threads
+               << " throughput=" << stage.throughput() << "/s utilization=" << stage.utilization()
+               << " full_waits=" << stage.waits.full_waits << " empty_waits=" << stage.waits.empty_waits << "\n";
+        };
+        auto print_queue = [&os](const char* name, const QueueDepthStats& queue) {
+            os << name << ": capacity=" << queue.capacity << " max_depth=" << queue.max_depth
+               << " mean_depth=" << queue.mean_depth << "\n";
+        };
+        print_stage("reader", stats.reader);
+        print_stage("workers", stats.workers);
+        print_stage("sink", stats.sink);
+        print_queue("input_queue", stats.input_queue);
+        print_queue("output_queue", stats.output_queue);
+        os << "accepted=" << stats.accepted << " rejected=" << stats.rejected
+           << " elapsed=" << stats.elapsed_seconds << "s\n";
+        return os;
+    }
+};
+
+// Конвейер многопоточной загрузки фигур.
+//
+// Пример использования:
+// ArrayOfFigures<Figure<double>> figures;
+// FigureIngestPipeline<double> pipeline({.workers = 4, .queue_capacity = 4096, .ordered = false});
+// IngestStats stats = pipeline.run(file, FigureFileFormat::Text, figures);
+// std::cout << stats;
+template<Scalar T>
+class FigureIngestPipeline {
+    public:
+        using FigurePtr = std::shared_ptr<Figure<T>>;
+
+        explicit FigureIngestPipeline(IngestOptions opts = {}) : options(opts) {
+            if (options.workers == 0) {
+                options.workers = 1;
+            }
+            if (options.queue_capacity == 0) {
+                options.queue_capacity = 1;
+            }
+        };
+
+        const IngestOptions& get_options() const {
+            return options;
+        };
+
+        // Загрузка фигур из потока в массив. Некорректные записи пропускаются и учитываются в статистике.
+        // Приёмник работает в вызывающем потоке, поэтому массив не требует синхронизации.
+        IngestStats run(std::istream& is, FigureFileFormat format, ArrayOfFigures<Figure<T>>& target) const {
+            BinaryFigureHeader header;
+            if (format == FigureFileFormat::Binary) {
+                header = read_binary_header<T>(is);
+            }
+            const std::uint64_t expected = format == FigureFileFormat::Binary ? binary_records_expected(header)
+                                                                              : std::numeric_limits<std::uint64_t>::max();
+
+            auto run_start = std::chrono::steady_clock::now();
+            BoundedQueue<RawItem> input(options.queue_capacity);
+            BoundedQueue<ParsedItem> output(options.queue_capacity);
+
+            // Окно переупорядочивания: поток чтения не может опередить приёмник больше чем на window элементов,
+            // поэтому буфер переупорядочивания фиксированного размера никогда не переполняется.
+            const std::size_t window = input.get_capacity() + output.get_capacity() + options.workers;
+            std::atomic<std::size_t> sink_next{0};
+            std::atomic<bool> aborted{false};
+            std::atomic<unsigned> workers_left{options.workers};
+            std::mutex error_mutex;
+            std::exception_ptr error;
+
+            auto fail = [&](std::exception_ptr e) {
+                {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (!error) {
+                        error = e;
+                    }
+                }
+                aborted.store(true, std::memory_order_release);
+                input.close();
+                output.close();
+            };
+
+            IngestStats stats;
+            stats.workers.threads = options.workers;
+            stats.input_queue.capacity = input.get_capacity();
+            stats.output_queue.capacity = output.get_capacity();
+            DepthSampler input_depth;
+            std::vector<WorkerResult> worker_results(options.workers);
+
+            // Поток чтения.
+            std::thread reader([&]() {
+                auto start = std::chrono::steady_clock::now();
+                try {
+                    RawItem item;
+                    std::size_t seq = 0;
+                    while (!aborted.load(std::memory_order_acquire)) {
+                        if (seq == expected || !read_raw(is, format, item)) {
+                            if (format == FigureFileFormat::Binary) {
+                                check_binary_record_count(header, seq);
+                            }
+                            break;
+                        }
+                        if (options.ordered) {
+                            wait_for_window(seq, window, sink_next, aborted, stats.reader.waits);
+                        }
+                        item.seq = seq++;
+                        if (!input.push(item, stats.reader.waits)) {
+                            break;
+                        }
+                        input_depth.sample(input.approx_size());
+                    }
+                    stats.reader.items = seq;
+                } catch (...) {
+                    fail(std::current_exception());
+                }
+                input.close();
+                stats.reader.wall_seconds = seconds_since(start);
+            });
+
+            // Рабочие потоки: разбор и проверка.
+            std::vector<std::thread> workers;
+            workers.reserve(options.workers);
+            for (unsigned w = 0; w < options.workers; ++w) {
+                workers.emplace_back([&, w]() {
+                    WorkerResult& result = worker_results[w];
+                    auto start = std::chrono::steady_clock::now();
+                    try {
+                        RawItem raw;
+                        ParsedItem parsed;
+                        while (input.pop(raw, result.waits)) {
+                            parsed.seq = raw.seq;
+                            parsed.figure = parse(raw, format);
+                            ++result.items;
+                            if (!output.push(parsed, result.waits)) {
+                                break;
+                            }
+                            result.depth.sample(output.approx_size());
+                        }
+                    } catch (...) {
+                        fail(std::current_exception());
+                    }
+                    result.wall_seconds = seconds_since(start);
+                    if (workers_left.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        output.close();
+                    }
+                });
+            }
+
+            // Приёмник в вызывающем потоке.
+            auto sink_start = std::chrono::steady_clock::now();
+            try {
+                std::vector<std::optional<FigurePtr>> pending(options.ordered ? window : 0);
+                std::size_t next = 0;
+                ParsedItem parsed;
+                while (output.pop(parsed, stats.sink.waits)) {
+                    ++stats.sink.items;
+                    if (!options.ordered) {
+                        store(std::move(parsed.figure), target, stats);
+                        continue;
+                    }
+                    pending[parsed.seq % window] = std::move(parsed.figure);
+                    while (pending[next % window].has_value()) {
+                        store(std::move(*pending[next % window]), target, stats);
+                        pending[next % window].reset();
+                        ++next;
+                    }
+                    sink_next.store(next, std::memory_order_release);
+                }
+            } catch (...) {
+                fail(std::current_exception());
+            }
+            stats.sink.wall_seconds = seconds_since(sink_start);
+
+            reader.join();
+            for (auto& worker : workers) {
+                worker.join();
+            }
+            if (error) {
+                std::rethrow_exception(error);
+            }
+
+            // Сведение статистики рабочих потоков.
+            DepthSampler output_depth;
+            for (const auto& result : worker_results) {
+                stats.workers.items += result.items;
+                stats.workers.wall_seconds = std::max(stats.workers.wall_seconds, result.wall_seconds);
+                stats.workers.waits.full_waits += result.waits.full_waits;
+                stats.workers.waits.empty_waits += result.waits.empty_waits;
+                stats.workers.waits.wait_seconds += result.waits.wait_seconds;
+                output_depth.merge(result.depth);
+            }
+            input_depth.export_to(stats.input_queue);
+            output_depth.export_to(stats.output_queue);
+            stats.elapsed_seconds = seconds_since(run_start);
+            return stats;
+        };
+
+    private:
+        // Элемент входной очереди: строка текстового формата или запись двоичного формата.
+        struct RawItem {
+            std::size_t seq{0};
+            std::string line;
+            FigureRecord<T> record;
+        };
+
+        // Элемент выходной очереди: построенная фигура или nullptr, если запись отвергнута.
+        struct ParsedItem {
+            std::size_t seq{0};
+            FigurePtr figure;
+        };
+
+        // Накопление глубины очереди.
+        struct DepthSampler {
+            std::size_t samples{0};
+            std::size_t sum{0};
+            std::size_t max{0};
+
+            void sample(std::size_t depth) {
+                ++samples;
+                sum += depth;
+                max = std::max(max, depth);
+            };
+            void merge(const DepthSampler& other) {
+                samples += other.samples;
+                sum += other.sum;
+                max = std::max(max, other.max);
+            };
+            void export_to(QueueDepthStats& stats) const {
+                stats.max_depth = max;
+                stats.mean_depth = samples ? static_cast<double>(sum) / samples : 0.0;
+            };
+        };
+
+        // Результаты одного рабочего потока (сводятся после завершения, чтобы потоки не делили счётчики).
+        struct alignas(CACHE_LINE_SIZE) WorkerResult {
+            std::size_t items{0};
+            double wall_seconds{0.0};
+            QueueWaitStats waits;
+            DepthSampler depth;
+        };
+
+        IngestOptions options;
+
+        static double seconds_since(std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        static bool read_raw(std::istream& is, FigureFileFormat format, RawItem& item) {
+            if (format == FigureFileFormat::Binary) {
+                return read_binary_record(is, item.record);
+            }
+            return read_text_line(is, item.line);
+        };
+
+        static FigurePtr parse(RawItem& raw, FigureFileFormat format) {
+            if (format == FigureFileFormat::Text) {
+                parse_text_record(raw.line, raw.record);
+            }
+            auto figure = try_make_figure(raw.record);
+            return figure ? std::move(*figure) : nullptr;
+        };
+
+        // Ожидание, пока приёмник не освободит место в окне переупорядочивания.
+        static void wait_for_window(std::size_t seq, std::size_t window, const std::atomic<std::size_t>& sink_next,
+                                    const std::atomic<bool>& aborted, QueueWaitStats& waits) {
+            if (seq < sink_next.load(std::memory_order_acquire) + window) {
+                return;
+            }
+            ++waits.full_waits;
+            auto start = std::chrono::steady_clock::now();
+            while (seq >= sink_next.load(std::memory_order_acquire) + window && !aborted.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            waits.wait_seconds += seconds_since(start);
+        };
+
+        static void store(FigurePtr figure, ArrayOfFigures<Figure<T>>& target, IngestStats& stats) {
+            if (figure) {
+                target.add_figure(std::move(figure));
+                ++stats.accepted;
+            } else {
+                ++stats.rejected;
+            }
+        };
+};
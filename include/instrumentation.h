@@ -0,0 +1,286 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Инструментирование горячих путей библиотеки фигур: счётчики событий и гистограммы задержек.
+// Включается при компиляции макросом FIGURES_INSTRUMENTATION=1 (опция CMake LAB4_INSTRUMENTATION).
+// В выключенном состоянии макросы FIGURES_* раскрываются в пустые выражения, поэтому накладных расходов нет.
+// Счётчики ведутся отдельно для каждого потока (без атомарных read-modify-write операций и без разделения строк кэша)
+// и суммируются только при снятии снимка.
+#ifndef FIGURES_INSTRUMENTATION
+#define FIGURES_INSTRUMENTATION 0
+#endif
+
+// Счётчики событий.
+enum class FigureCounter : std::size_t {
+    // Созданные объекты фигур (любым конструктором).
+    Constructed,
+    // Вызовы clone().
+    Cloned,
+    // Отказы проверки в конструкторах фигур (по причинам - см. InstrumentationSnapshot::validation_failures).
+    ValidationFailures,
+    // Увеличения ёмкости ArrayOfFigures.
+    ArrayResizes,
+    // Байты, выделенные под буферы ArrayOfFigures.
+    BytesAllocated,
+    Count
+};
+
+// Операции, для которых строятся гистограммы задержек.
+enum class FigureLatency : std::size_t {
+    TotalSquare,
+    ParallelTotalSquare,
+    PrintFigures,
+    Count
+};
+
+// Гистограмма задержек: корзина k содержит измерения длительностью [2^k, 2^(k+1)) наносекунд.
+struct LatencyHistogram {
+    static constexpr std::size_t BUCKETS = 48;
+    std::array<std::uint64_t, BUCKETS> buckets{};
+    std::uint64_t count{0};
+    std::uint64_t total_ns{0};
+
+    // Оценка квантиля (0..1) по верхней границе корзины, в наносекундах.
+    std::uint64_t quantile_ns(double q) const {
+        if (count == 0) {
+            return 0;
+        }
+        auto target = static_cast<std::uint64_t>(q * static_cast<double>(count));
+        std::uint64_t seen = 0;
+        for (std::size_t k = 0; k < BUCKETS; ++k) {
+            seen += buckets[k];
+            if (seen > target) {
+                return std::uint64_t{1} << (k + 1);
+            }
+        }
+        return std::uint64_t{1} << BUCKETS;
+    };
+
+    double mean_ns() const {
+        return count ? static_cast<double>(total_ns) / static_cast<double>(count) : 0.0;
+    };
+};
+
+// Снимок всех счётчиков, просуммированных по потокам (включая завершившиеся).
+struct InstrumentationSnapshot {
+    std::array<std::uint64_t, static_cast<std::size_t>(FigureCounter::Count)> counters{};
+    std::array<LatencyHistogram, static_cast<std::size_t>(FigureLatency::Count)> latencies{};
+    // Отказы проверки по причинам (текст причины - сообщение исключения конструктора).
+    std::vector<std::pair<std::string, std::uint64_t>> validation_failures;
+
+    std::uint64_t get(FigureCounter counter) const {
+        return counters[static_cast<std::size_t>(counter)];
+    };
+
+    const LatencyHistogram& get(FigureLatency latency) const {
+        return latencies[static_cast<std::size_t>(latency)];
+    };
+
+    // Текстовый дамп снимка.
+    friend std::ostream& operator<<(std::ostream& os, const InstrumentationSnapshot& snapshot) {
+        static constexpr const char* COUNTER_NAMES[] = {"constructed", "cloned", "validation_failures", "array_resizes", "bytes_allocated"};
+        static constexpr const char* LATENCY_NAMES[] = {"total_square", "parallel_total_square", "print_figures"};
+        for (std::size_t i = 0; i < snapshot.counters.size(); ++i) {
+            os << COUNTER_NAMES[i] << " = " << snapshot.counters[i] << "\n";
+        }
+        for (const auto& [reason, count] : snapshot.validation_failures) {
+            os << "  rejected: " << reason << " = " << count << "\n";
+        }
+        for (std::size_t i = 0; i < snapshot.latencies.size(); ++i) {
+            const auto& histogram = snapshot.latencies[i];
+            os << LATENCY_NAMES[i] << ": count = " << histogram.count << ", mean = " << histogram.mean_ns()
+               << " ns, p50 <= " << histogram.quantile_ns(0.5) << " ns, p99 <= " << histogram.quantile_ns(0.99) << " ns\n";
+        }
+        return os;
+    }
+};
+
+// Хранилище счётчиков. Класс используется как пространство имён для статических функций.
+class Instrumentation {
+    public:
+        // Включено ли инструментирование в этой сборке.
+        static constexpr bool enabled() {
+            return FIGURES_INSTRUMENTATION != 0;
+        };
+
+        static void add(FigureCounter counter, std::uint64_t value = 1) {
+            auto& cell = local().counters[static_cast<std::size_t>(counter)];
+            cell.store(cell.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        };
+
+        static void record_latency(FigureLatency latency, std::uint64_t nanoseconds) {
+            auto& histogram = local().latencies[static_cast<std::size_t>(latency)];
+            std::size_t bucket = nanoseconds == 0 ? 0 : static_cast<std::size_t>(std::bit_width(nanoseconds) - 1);
+            if (bucket >= LatencyHistogram::BUCKETS) {
+                bucket = LatencyHistogram::BUCKETS - 1;
+            }
+            auto bump = [](std::atomic<std::uint64_t>& cell, std::uint64_t value) {
+                cell.store(cell.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+            };
+            bump(histogram.buckets[bucket], 1);
+            bump(histogram.count, 1);
+            bump(histogram.total_ns, nanoseconds);
+        };
+
+        // Отказ проверки. Путь холодный, поэтому причины хранятся в списке под мьютексом потока.
+        static void validation_failure(std::string_view reason) {
+            add(FigureCounter::ValidationFailures);
+            ThreadCounters& counters = local();
+            std::lock_guard<std::mutex> lock(counters.failures_mutex);
+            accumulate_failure(counters.failures, reason, 1);
+        };
+
+        // Снимок счётчиков всех потоков.
+        static InstrumentationSnapshot snapshot() {
+            Registry& registry = get_registry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            InstrumentationSnapshot result = registry.retired;
+            for (ThreadCounters* counters : registry.threads) {
+                counters->add_to(result);
+            }
+            return result;
+        };
+
+        // Обнуление счётчиков. Приращения, выполняемые одновременно со сбросом, могут быть потеряны.
+        static void reset() {
+            Registry& registry = get_registry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            registry.retired = InstrumentationSnapshot{};
+            for (ThreadCounters* counters : registry.threads) {
+                counters->clear();
+            }
+        };
+
+    private:
+        // Гистограмма, в которую пишет только поток-владелец; атомарность нужна лишь для чтения при снятии снимка.
+        struct AtomicHistogram {
+            std::array<std::atomic<std::uint64_t>, LatencyHistogram::BUCKETS> buckets{};
+            std::atomic<std::uint64_t> count{0};
+            std::atomic<std::uint64_t> total_ns{0};
+        };
+
+        struct ThreadCounters {
+            std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(FigureCounter::Count)> counters{};
+            std::array<AtomicHistogram, static_cast<std::size_t>(FigureLatency::Count)> latencies{};
+            std::mutex failures_mutex;
+            std::vector<std::pair<std::string, std::uint64_t>> failures;
+
+            ThreadCounters() {
+                Registry& registry = get_registry();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                registry.threads.push_back(this);
+            };
+
+            // При завершении потока его счётчики переносятся в общий итог.
+            ~ThreadCounters() {
+                Registry& registry = get_registry();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                add_to(registry.retired);
+                std::erase(registry.threads, this);
+            };
+
+            void add_to(InstrumentationSnapshot& result) {
+                for (std::size_t i = 0; i < counters.size(); ++i) {
+                    result.counters[i] += counters[i].load(std::memory_order_relaxed);
+                }
+                for (std::size_t i = 0; i < latencies.size(); ++i) {
+                    for (std::size_t k = 0; k < LatencyHistogram::BUCKETS; ++k) {
+                        result.latencies[i].buckets[k] += latencies[i].buckets[k].load(std::memory_order_relaxed);
+                    }
+                    result.latencies[i].count += latencies[i].count.load(std::memory_order_relaxed);
+                    result.latencies[i].total_ns += latencies[i].total_ns.load(std::memory_order_relaxed);
+                }
+                std::lock_guard<std::mutex> lock(failures_mutex);
+                for (const auto& [reason, count] : failures) {
+                    accumulate_failure(result.validation_failures, reason, count);
+                }
+            };
+
+            void clear() {
+                for (auto& counter : counters) {
+                    counter.store(0, std::memory_order_relaxed);
+                }
+                for (auto& histogram : latencies) {
+                    for (auto& bucket : histogram.buckets) {
+                        bucket.store(0, std::memory_order_relaxed);
+                    }
+                    histogram.count.store(0, std::memory_order_relaxed);
+                    histogram.total_ns.store(0, std::memory_order_relaxed);
+                }
+                std::lock_guard<std::mutex> lock(failures_mutex);
+                failures.clear();
+            };
+        };
+
+        struct Registry {
+            std::mutex mutex;
+            std::vector<ThreadCounters*> threads;
+            InstrumentationSnapshot retired;
+        };
+
+        // Реестр создаётся один раз и не уничтожается: счётчики потоков пула (в том числе ThreadPool::global(),
+        // который может быть создан раньше реестра) переносятся в него при завершении потоков во время статической деструкции.
+        static Registry& get_registry() {
+            static Registry& registry = *new Registry;
+            return registry;
+        };
+
+        static ThreadCounters& local() {
+            thread_local ThreadCounters counters;
+            return counters;
+        };
+
+        static void accumulate_failure(std::vector<std::pair<std::string, std::uint64_t>>& failures,
+                                       std::string_view reason, std::uint64_t count) {
+            for (auto& [known, value] : failures) {
+                if (known == reason) {
+                    value += count;
+                    return;
+                }
+            }
+            failures.emplace_back(std::string(reason), count);
+        };
+};
+
+// Замер длительности области видимости.
+class ScopedLatency {
+    public:
+        explicit ScopedLatency(FigureLatency measured) : latency(measured), start(std::chrono::steady_clock::now()) {};
+        ScopedLatency(const ScopedLatency&) = delete;
+        ScopedLatency& operator=(const ScopedLatency&) = delete;
+        ~ScopedLatency() {
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+            Instrumentation::record_latency(latency, static_cast<std::uint64_t>(elapsed.count()));
+        };
+
+    private:
+        FigureLatency latency;
+        std::chrono::steady_clock::time_point start;
+};
+
+#define FIGURES_INSTRUMENTATION_CONCAT_IMPL(a, b) a##b
+#define FIGURES_INSTRUMENTATION_CONCAT(a, b) FIGURES_INSTRUMENTATION_CONCAT_IMPL(a, b)
+
+#if FIGURES_INSTRUMENTATION
+#define FIGURES_COUNT(counter) Instrumentation::add(FigureCounter::counter)
+#define FIGURES_COUNT_N(counter, value) Instrumentation::add(FigureCounter::counter, static_cast<std::uint64_t>(value))
+#define FIGURES_VALIDATION_FAILURE(reason) Instrumentation::validation_failure(reason)
+#define FIGURES_MEASURE_LATENCY(latency) \
+    ScopedLatency FIGURES_INSTRUMENTATION_CONCAT(figures_latency_, __LINE__)(FigureLatency::latency)
+#else
+#define FIGURES_COUNT(counter) ((void)0)
+#define FIGURES_COUNT_N(counter, value) ((void)0)
+#define FIGURES_VALIDATION_FAILURE(reason) ((void)0)
+#define FIGURES_MEASURE_LATENCY(latency) ((void)0)
+#endif
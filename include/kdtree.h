@@ -0,0 +1,262 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <optional>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "point.h"
+#include "threadpool.h"
+
+// Сосед точки: номер точки и расстояние до неё. Отсутствующий сосед (точек меньше k) -
+// номер Neighbour::NONE и бесконечное расстояние.
+struct Neighbour {
+    static constexpr std::size_t NONE = std::numeric_limits<std::size_t>::max();
+
+    std::size_t index{NONE};
+    double distance{std::numeric_limits<double>::infinity()};
+
+    bool operator==(const Neighbour& other) const = default;
+};
+
+// Ближайшая пара точек (first < second) и расстояние между ними.
+struct ClosestPair {
+    std::size_t first{0};
+    std::size_t second{0};
+    double distance{0.0};
+
+    bool operator==(const ClosestPair& other) const = default;
+};
+
+// k-d дерево над точками плоскости в неявной раскладке: точки хранятся одним массивом, узел поддерева
+// над отрезком [lo, hi) - точка с номером mid = lo + (hi - lo) / 2, левое поддерево - [lo, mid), правое - [mid + 1, hi).
+// Указателей нет, соседние узлы лежат в памяти рядом; отрезки не длиннее LEAF_SIZE - листья, они просматриваются подряд.
+// Ось разбиения узла - ось с большим разбросом точек отрезка, медиана выбирается std::nth_element.
+// Построение идёт по уровням: все отрезки уровня независимы и разбиваются задачами пула.
+// Результаты запросов не зависят от количества потоков: равные расстояния упорядочиваются по номеру точки.
+class KdTree {
+    public:
+        static constexpr std::size_t LEAF_SIZE = 8;
+
+        // Номера точек в запросах - позиции в points.
+        KdTree(std::span<const Point<double>> points, ThreadPool& pool) : entries(points.size()), axes(points.size(), 0) {
+            for (std::size_t i = 0; i < points.size(); ++i) {
+                entries[i] = Entry{points[i].get_x(), points[i].get_y(), i};
+            }
+            std::vector<std::pair<std::size_t, std::size_t>> level;
+            if (entries.size() > LEAF_SIZE) {
+                level.emplace_back(0, entries.size());
+            }
+            while (!level.empty()) {
+                pool.parallel_for(0, level.size(), 1, [&](std::size_t first, std::size_t last) {
+                    for (std::size_t r = first; r < last; ++r) {
+                        split(level[r].first, level[r].second);
+                    }
+                });
+                std::vector<std::pair<std::size_t, std::size_t>> next;
+                next.reserve(level.size() * 2);
+                for (auto [lo, hi] : level) {
+                    const std::size_t mid = lo + (hi - lo) / 2;
+                    if (mid - lo > LEAF_SIZE) {
+                        next.emplace_back(lo, mid);
+                    }
+                    if (hi - mid - 1 > LEAF_SIZE) {
+                        next.emplace_back(mid + 1, hi);
+                    }
+                }
+                level = std::move(next);
+            }
+        };
+
+        std::size_t size() const {
+            return entries.size();
+        };
+
+        // k ближайших к query точек (кроме точки с номером exclude) по возрастанию расстояния.
+        // Записывается min(k, доступные точки) соседей в начало out (размер out - не меньше k); возвращается их количество.
+        std::size_t nearest(const Point<double>& query, std::size_t k, std::span<Neighbour> out, std::size_t exclude = Neighbour::NONE) const {
+            if (out.size() < k) {
+                throw std::invalid_argument("Output is smaller than the number of neighbours.");
+            }
+            if (k == 0 || entries.empty()) {
+                return 0;
+            }
+            Candidates best{out.first(k), 0};
+            search(0, entries.size(), query.get_x(), query.get_y(), exclude, best);
+            for (std::size_t j = 0; j < best.count; ++j) {
+                out[j].distance = std::sqrt(out[j].distance);
+            }
+            std::fill(out.begin() + static_cast<std::ptrdiff_t>(best.count), out.begin() + static_cast<std::ptrdiff_t>(k), Neighbour{});
+            return best.count;
+        };
+
+        // k ближайших соседей каждой точки дерева (сама точка не считается соседом). Строка i результата -
+        // элементы [i * k, (i + 1) * k) - соседи точки i; недостающие соседи - Neighbour{}.
+        // Запросы идут в порядке раскладки дерева, поэтому соседние запросы обходят одни и те же узлы.
+        std::vector<Neighbour> all_nearest(std::size_t k, ThreadPool& pool, std::size_t grain) const {
+            std::vector<Neighbour> result(entries.size() * k);
+            if (k == 0) {
+                return result;
+            }
+            pool.parallel_for(0, entries.size(), grain, [&](std::size_t lo, std::size_t hi) {
+                for (std::size_t position = lo; position < hi; ++position) {
+                    const Entry& entry = entries[position];
+                    std::span<Neighbour> row(result.data() + entry.index * k, k);
+                    nearest(Point<double>(entry.x, entry.y), k, row, entry.index);
+                }
+            });
+            return result;
+        };
+
+    private:
+        struct Entry {
+            double x;
+            double y;
+            std::size_t index;
+        };
+
+        // Лучшие найденные кандидаты: отсортированы по (квадрат расстояния, номер).
+        struct Candidates {
+            std::span<Neighbour> items;
+            std::size_t count;
+
+            double worst() const {
+                return count < items.size() ? std::numeric_limits<double>::infinity() : items[count - 1].distance;
+            };
+
+            void offer(std::size_t index, double squared) {
+                auto before = [](const Neighbour& a, const Neighbour& b) {
+                    return a.distance < b.distance || (a.distance == b.distance && a.index < b.index);
+                };
+                const Neighbour candidate{index, squared};
+                if (count == items.size() && !before(candidate, items[count - 1])) {
+                    return;
+                }
+                std::size_t j = count < items.size() ? count++ : count - 1;
+                while (j > 0 && before(candidate, items[j - 1])) {
+                    items[j] = items[j - 1];
+                    --j;
+                }
+                items[j] = candidate;
+            };
+        };
+
+        void split(std::size_t lo, std::size_t hi) {
+            double min_x = entries[lo].x;
+            double max_x = min_x;
+            double min_y = entries[lo].y;
+            double max_y = min_y;
+            for (std::size_t i = lo + 1; i < hi; ++i) {
+                min_x = std::min(min_x, entries[i].x);
+                max_x = std::max(max_x, entries[i].x);
+                min_y = std::min(min_y, entries[i].y);
+                max_y = std::max(max_y, entries[i].y);
+            }
+            const std::uint8_t axis = max_y - min_y > max_x - min_x ? 1 : 0;
+            const std::size_t mid = lo + (hi - lo) / 2;
+            auto begin = entries.begin();
+            std::nth_element(begin + static_cast<std::ptrdiff_t>(lo), begin + static_cast<std::ptrdiff_t>(mid), begin + static_cast<std::ptrdiff_t>(hi),
+                             [axis](const Entry& a, const Entry& b) {
+                                 return axis == 0 ? a.x < b.x : a.y < b.y;
+                             });
+            axes[mid] = axis;
+        };
+
+        void consider(const Entry& entry, double qx, double qy, std::size_t exclude, Candidates& best) const {
+            if (entry.index != exclude) {
+                const double dx = entry.x - qx;
+                const double dy = entry.y - qy;
+                best.offer(entry.index, dx * dx + dy * dy);
+            }
+        };
+
+        void search(std::size_t lo, std::size_t hi, double qx, double qy, std::size_t exclude, Candidates& best) const {
+            if (hi - lo <= LEAF_SIZE) {
+                for (std::size_t i = lo; i < hi; ++i) {
+                    consider(entries[i], qx, qy, exclude, best);
+                }
+                return;
+            }
+            const std::size_t mid = lo + (hi - lo) / 2;
+            const Entry& node = entries[mid];
+            consider(node, qx, qy, exclude, best);
+            const double difference = axes[mid] == 0 ? qx - node.x : qy - node.y;
+            if (difference < 0.0) {
+                search(lo, mid, qx, qy, exclude, best);
+                if (difference * difference <= best.worst()) {
+                    search(mid + 1, hi, qx, qy, exclude, best);
+                }
+            } else {
+                search(mid + 1, hi, qx, qy, exclude, best);
+                if (difference * difference <= best.worst()) {
+                    search(lo, mid, qx, qy, exclude, best);
+                }
+            }
+        };
+
+        std::vector<Entry> entries;
+        std::vector<std::uint8_t> axes;
+};
+
+// Ближайшая пара точек за O(n log n): заметание по X с упорядоченным по Y множеством точек полосы шириной
+// в текущее лучшее расстояние. Из пар на одинаковом расстоянии выбирается первая в порядке (first, second).
+// std::nullopt, если точек меньше двух.
+inline std::optional<ClosestPair> closest_pair(std::span<const Point<double>> points) {
+    const std::size_t n = points.size();
+    if (n < 2) {
+        return std::nullopt;
+    }
+    // Совпадающие точки (расстояние 0) ищутся заранее по точным координатам: иначе при нулевом лучшем расстоянии
+    // полоса заметания содержит все совпадающие точки, и каждая новая точка сравнивается со всеми ними (O(n^2)).
+    std::map<std::pair<double, double>, std::size_t> first_at;
+    std::optional<ClosestPair> coincident;
+    for (std::size_t i = 0; i < n; ++i) {
+        auto [it, inserted] = first_at.try_emplace(std::pair(points[i].get_x(), points[i].get_y()), i);
+        if (!inserted && (!coincident || it->second < coincident->first)) {
+            coincident = ClosestPair{it->second, i, 0.0};
+        }
+    }
+    if (coincident) {
+        return coincident;
+    }
+    std::vector<std::size_t> order(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return points[a].get_x() < points[b].get_x() || (points[a].get_x() == points[b].get_x() && a < b);
+    });
+    ClosestPair best{0, 0, std::numeric_limits<double>::infinity()};
+    auto improve = [&](std::size_t a, std::size_t b, double distance) {
+        ClosestPair candidate{std::min(a, b), std::max(a, b), distance};
+        if (candidate.distance < best.distance ||
+            (candidate.distance == best.distance && std::pair(candidate.first, candidate.second) < std::pair(best.first, best.second))) {
+            best = candidate;
+        }
+    };
+    // Точки полосы: (y, номер).
+    std::set<std::pair<double, std::size_t>> strip;
+    std::size_t left = 0;
+    for (std::size_t i : order) {
+        const double x = points[i].get_x();
+        const double y = points[i].get_y();
+        while (x - points[order[left]].get_x() > best.distance) {
+            strip.erase({points[order[left]].get_y(), order[left]});
+            ++left;
+        }
+        auto first = best.distance == std::numeric_limits<double>::infinity() ? strip.begin() : strip.lower_bound({y - best.distance, 0});
+        for (auto it = first; it != strip.end() && it->first <= y + best.distance; ++it) {
+            const double dx = points[it->second].get_x() - x;
+            const double dy = it->first - y;
+            improve(it->second, i, std::sqrt(dx * dx + dy * dy));
+        }
+        strip.insert({y, i});
+    }
+    return best;
+}
@@ -0,0 +1,363 @@
+#pragma once
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "point.h"
+#include "figure.h"
+#include "boundingbox.h"
+#include "validation.h"
+#include "ownership.h"
+#include "threadpool.h"
+#include "arrayoffigures.h"
+#include "figureio.h"
+
+// Режим отображения файла: только чтение или чтение и добавление фигур.
+enum class MapMode {
+    ReadOnly,
+    ReadWrite
+};
+
+// Коллекция фигур в двоичном файле (BinaryFigureHeader и записи FigureRecord, см. figureio.h),
+// отображённом в память. При открытии проверяются только заголовок и размер файла: записи не читаются
+// и фигуры не создаются, страницы подгружаются системой при первом обращении. Поэтому открытие файла любого
+// размера занимает микросекунды, а площади, ограничивающие прямоугольники и вершины для индексов и запросов
+// вычисляются прямо по записям в отображённой памяти.
+//
+// Записи проверяются при добавлении (append), поэтому файл, созданный этим классом, содержит только
+// корректные фигуры. Количество записей в заголовке обновляется после копирования записей; файл растёт
+// с запасом, лишнее место отрезается при закрытии. Заголовок со счётчиком 0 (файл записан потоком
+// без известного количества) означает «все записи до конца файла».
+//
+// Span и ссылки на записи действительны до ближайшего добавления (отображение может быть перемещено).
+template<Scalar T>
+class MappedFigures {
+    public:
+        // Наименьшее приращение ёмкости файла в записях.
+        static constexpr std::size_t MIN_GROWTH = 1024;
+
+        // Открытие существующего файла. std::runtime_error - при несовпадении сигнатуры, версии формата
+        // или типа координат и при обрезанном файле; std::system_error - при ошибках системы.
+        explicit MappedFigures(const std::string& path, MapMode mode = MapMode::ReadOnly) : writable(mode == MapMode::ReadWrite) {
+            descriptor = ::open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+            if (descriptor < 0) {
+                throw std::system_error(errno, std::generic_category(), "Cannot open figure file " + path);
+            }
+            try {
+                open_mapping();
+            } catch (...) {
+                release();
+                throw;
+            }
+        };
+
+        // Создание пустого файла (существующий файл перезаписывается), открытого для добавления.
+        static MappedFigures create(const std::string& path) {
+            {
+                std::ofstream os(path, std::ios::binary | std::ios::trunc);
+                write_binary_header<T>(os);
+                if (!os) {
+                    throw std::runtime_error("Cannot create figure file " + path);
+                }
+            }
+            return MappedFigures(path, MapMode::ReadWrite);
+        };
+
+        MappedFigures(MappedFigures&& other) noexcept {
+            swap(other);
+        };
+
+        MappedFigures& operator=(MappedFigures&& other) noexcept {
+            if (this != &other) {
+                MappedFigures moved(std::move(other));
+                swap(moved);
+            }
+            return *this;
+        };
+
+        MappedFigures(const MappedFigures&) = delete;
+        MappedFigures& operator=(const MappedFigures&) = delete;
+
+        ~MappedFigures() {
+            release();
+        };
+
+        std::size_t size() const {
+            return count;
+        };
+
+        bool empty() const {
+            return count == 0;
+        };
+
+        // Все записи файла - без копирования, прямо в отображённой памяти.
+        std::span<const FigureRecord<T>> records() const {
+            return std::span<const FigureRecord<T>>(first_record(), count);
+        };
+
+        const FigureRecord<T>& record(std::size_t index) const {
+            if (index >= count) {
+                throw std::out_of_range("Index out of range");
+            }
+            return first_record()[index];
+        };
+
+        // Вершины фигуры index. Количество ограничено MAX_FIGURE_VERTICES, даже если файл повреждён.
+        std::span<const Point<T>> vertices(std::size_t index) const {
+            const FigureRecord<T>& value = record(index);
+            return std::span<const Point<T>>(value.vertices.data(), std::min<std::size_t>(value.vertex_count, MAX_FIGURE_VERTICES));
+        };
+
+        // Фигура index, созданная проверяющим конструктором (FigureValidationError - запись некорректна).
+        std::shared_ptr<Figure<T>> figure(std::size_t index) const {
+            return make_figure(record(index));
+        };
+
+        // Площадь фигуры index по формуле площади многоугольника (для ромба и правильных многоугольников
+        // совпадает с Figure::square() с точностью до округления).
+        double square(std::size_t index) const {
+            return polygon_square(record(index));
+        };
+
+        // Общая площадь. Записи обрабатываются частями по grain задачами пула; результат не зависит от количества потоков.
+        double total_square(ThreadPool& pool = ThreadPool::global(), std::size_t grain = 4096) const {
+            const FigureRecord<T>* data = first_record();
+            return pool.parallel_reduce(0, count, grain, 0.0,
+                [data](std::size_t lo, std::size_t hi) {
+                    double total = 0.0;
+                    for (std::size_t i = lo; i < hi; ++i) {
+                        total += polygon_square(data[i]);
+                    }
+                    return total;
+                },
+                [](double a, double b) { return a + b; });
+        };
+
+        // Ограничивающие прямоугольники фигур - для пространственных индексов, растеризации и отсечения.
+        std::vector<BoundingBox<double>> bounding_boxes(ThreadPool& pool = ThreadPool::global(), std::size_t grain = 4096) const {
+            std::vector<BoundingBox<double>> result(count);
+            pool.parallel_for(0, count, grain, [&](std::size_t lo, std::size_t hi) {
+                for (std::size_t i = lo; i < hi; ++i) {
+                    for (const auto& vertex : vertices(i)) {
+                        result[i].expand(static_cast<double>(vertex.get_x()), static_cast<double>(vertex.get_y()));
+                    }
+                }
+            });
+            return result;
+        };
+
+        // Геометрические центры фигур (среднее вершин, как Figure::geometric_center()) - например, для KdTree.
+        std::vector<Point<double>> centroids(ThreadPool& pool = ThreadPool::global(), std::size_t grain = 4096) const {
+            std::vector<Point<double>> result(count);
+            pool.parallel_for(0, count, grain, [&](std::size_t lo, std::size_t hi) {
+                for (std::size_t i = lo; i < hi; ++i) {
+                    auto polygon = vertices(i);
+                    double x = 0.0;
+                    double y = 0.0;
+                    for (const auto& vertex : polygon) {
+                        x += static_cast<double>(vertex.get_x());
+                        y += static_cast<double>(vertex.get_y());
+                    }
+                    const double n = static_cast<double>(std::max<std::size_t>(polygon.size(), 1));
+                    result[i] = Point<double>(x / n, y / n);
+                }
+            });
+            return result;
+        };
+
+        // Создание объектов фигур для всего файла (некорректные записи попадают в rejected, см. try_build).
+        template<class Ownership = SharedOwnership>
+        ArrayOfFigures<Figure<T>, Ownership> load(std::vector<FigureRejection>& rejected) const {
+            ArrayOfFigures<Figure<T>, Ownership> result;
+            try_build(records(), result, rejected);
+            return result;
+        };
+
+        // Добавление записей в конец файла. Все записи проверяются до изменения файла:
+        // при некорректной записи выбрасывается FigureValidationError и файл не меняется.
+        void append(std::span<const FigureRecord<T>> added) {
+            require_writable();
+            for (const auto& value : added) {
+                if (auto created = try_make_figure(value); !created) {
+                    throw FigureValidationError(created.error());
+                }
+            }
+            append_unchecked(added);
+        };
+
+        void append(const Figure<T>& figure) {
+            require_writable();
+            const FigureRecord<T> value = to_record(figure);
+            append_unchecked(std::span<const FigureRecord<T>>(&value, 1));
+        };
+
+        // Добавление всех фигур коллекции (пустые ячейки пропускаются).
+        template<class Ownership>
+        void append(const ArrayOfFigures<Figure<T>, Ownership>& figures) {
+            require_writable();
+            std::vector<FigureRecord<T>> added;
+            added.reserve(figures.get_size());
+            for (const auto& figure : figures) {
+                if (figure) {
+                    added.push_back(to_record(*figure));
+                }
+            }
+            append_unchecked(added);
+        };
+
+        // Резервирование места в файле не меньше чем для new_capacity записей.
+        void reserve(std::size_t new_capacity) {
+            require_writable();
+            if (new_capacity > capacity) {
+                remap(new_capacity);
+            }
+        };
+
+        // Сброс изменённых страниц на диск.
+        void flush() const {
+            if (base != nullptr && ::msync(base, mapped_bytes, MS_SYNC) != 0) {
+                throw std::system_error(errno, std::generic_category(), "Cannot flush figure file");
+            }
+        };
+
+    private:
+        static double polygon_square(const FigureRecord<T>& value) {
+            const std::size_t n = std::min<std::size_t>(value.vertex_count, MAX_FIGURE_VERTICES);
+            if (n < 3) {
+                return 0.0;
+            }
+            // Координаты приводятся к double до умножения: для целочисленных T произведения не переполняются.
+            auto at = [&value](std::size_t i) {
+                return Point<double>(static_cast<double>(value.vertices[i].get_x()), static_cast<double>(value.vertices[i].get_y()));
+            };
+            double sum = cross(at(n - 1), at(0));
+            for (std::size_t i = 0; i + 1 < n; ++i) {
+                sum += cross(at(i), at(i + 1));
+            }
+            return std::fabs(sum) / 2.0;
+        };
+
+        BinaryFigureHeader& header() const {
+            return *reinterpret_cast<BinaryFigureHeader*>(base);
+        };
+
+        FigureRecord<T>* first_record() const {
+            return reinterpret_cast<FigureRecord<T>*>(static_cast<char*>(base) + sizeof(BinaryFigureHeader));
+        };
+
+        void require_writable() const {
+            if (!writable) {
+                throw std::runtime_error("Figure file is opened read-only.");
+            }
+        };
+
+        // Новое отображение создаётся до снятия старого: при ошибке коллекция остаётся в прежнем состоянии.
+        void map(std::size_t bytes) {
+            void* address = ::mmap(nullptr, bytes, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, descriptor, 0);
+            if (address == MAP_FAILED) {
+                throw std::system_error(errno, std::generic_category(), "Cannot map figure file");
+            }
+            unmap();
+            base = address;
+            mapped_bytes = bytes;
+        };
+
+        void unmap() {
+            if (base != nullptr) {
+                ::munmap(base, mapped_bytes);
+                base = nullptr;
+                mapped_bytes = 0;
+            }
+        };
+
+        void open_mapping() {
+            struct stat info;
+            if (::fstat(descriptor, &info) != 0) {
+                throw std::system_error(errno, std::generic_category(), "Cannot stat figure file");
+            }
+            const std::size_t bytes = static_cast<std::size_t>(info.st_size);
+            if (bytes < sizeof(BinaryFigureHeader)) {
+                throw std::runtime_error("Invalid figure file: header is truncated.");
+            }
+            map(bytes);
+            check_binary_header<T>(header());
+            const std::size_t payload = bytes - sizeof(BinaryFigureHeader);
+            capacity = payload / sizeof(FigureRecord<T>);
+            if (header().count == 0) {
+                if (payload % sizeof(FigureRecord<T>) != 0) {
+                    throw std::runtime_error("Invalid figure file: records are truncated.");
+                }
+                count = capacity;
+            } else if (header().count > capacity) {
+                throw std::runtime_error("Invalid figure file: records are truncated.");
+            } else {
+                count = static_cast<std::size_t>(header().count);
+            }
+        };
+
+        // Рост файла и повторное отображение: ёмкость увеличивается не меньше чем вдвое.
+        void remap(std::size_t needed) {
+            const std::size_t grown = std::max({needed, capacity * 2, MIN_GROWTH});
+            const std::size_t bytes = sizeof(BinaryFigureHeader) + grown * sizeof(FigureRecord<T>);
+            if (::ftruncate(descriptor, static_cast<off_t>(bytes)) != 0) {
+                throw std::system_error(errno, std::generic_category(), "Cannot grow figure file");
+            }
+            map(bytes);
+            capacity = grown;
+        };
+
+        void append_unchecked(std::span<const FigureRecord<T>> added) {
+            if (added.empty()) {
+                return;
+            }
+            if (count + added.size() > capacity) {
+                remap(count + added.size());
+            }
+            std::memcpy(first_record() + count, added.data(), added.size_bytes());
+            count += added.size();
+            header().count = count;
+        };
+
+        // Отображение снимается, лишняя ёмкость отрезается, файл закрывается.
+        void release() noexcept {
+            const bool trim = writable && base != nullptr && capacity > count;
+            unmap();
+            if (descriptor >= 0) {
+                if (trim) {
+                    [[maybe_unused]] int ignored = ::ftruncate(descriptor, static_cast<off_t>(sizeof(BinaryFigureHeader) + count * sizeof(FigureRecord<T>)));
+                }
+                ::close(descriptor);
+                descriptor = -1;
+            }
+        };
+
+        void swap(MappedFigures& other) noexcept {
+            std::swap(descriptor, other.descriptor);
+            std::swap(writable, other.writable);
+            std::swap(base, other.base);
+            std::swap(mapped_bytes, other.mapped_bytes);
+            std::swap(count, other.count);
+            std::swap(capacity, other.capacity);
+        };
+
+        int descriptor{-1};
+        bool writable{false};
+        void* base{nullptr};
+        std::size_t mapped_bytes{0};
+        std::size_t count{0};
+        std::size_t capacity{0};
+};
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+// Политики владения фигурами для ArrayOfFigures.
+// Политика задаёт тип указателя на фигуру, тип буфера указателей и способ глубокого копирования фигуры.
+
+// Совместное владение (по умолчанию): фигуры хранятся в std::shared_ptr и могут разделяться
+// между массивом и внешним кодом. Каждое копирование указателя - атомарная операция со счётчиком ссылок.
+struct SharedOwnership {
+    template<class F>
+    using pointer = std::shared_ptr<F>;
+
+    template<class F>
+    using buffer = std::shared_ptr<pointer<F>[]>;
+
+    template<class F>
+    static buffer<F> allocate(std::size_t count) {
+        return std::make_shared<pointer<F>[]>(count);
+    }
+
+    // Создание фигуры вида Kind одним выделением памяти (объект и счётчик ссылок в одном блоке).
+    template<class Kind, class... Args>
+    static pointer<Kind> make(Args&&... args) {
+        return std::make_shared<Kind>(std::forward<Args>(args)...);
+    }
+
+    // clone() возвращает указатель на базовый класс, поэтому для массивов наследников нужно приведение вниз.
+    template<class F>
+    static pointer<F> clone(const F& figure) {
+        return std::static_pointer_cast<F>(figure.clone());
+    }
+};
+
+// Единоличное владение: фигуры хранятся в std::unique_ptr, буфер также принадлежит только массиву.
+// Ни одна операция массива (добавление, доступ, удаление, увеличение ёмкости) не выполняет атомарных операций.
+// Фигуры нельзя разделять с внешним кодом: add_figure принимает std::unique_ptr по значению (через std::move),
+// а operator[] возвращает ссылку на указатель внутри массива.
+struct UniqueOwnership {
+    template<class F>
+    using pointer = std::unique_ptr<F>;
+
+    template<class F>
+    using buffer = std::unique_ptr<pointer<F>[]>;
+
+    template<class F>
+    static buffer<F> allocate(std::size_t count) {
+        return std::make_unique<pointer<F>[]>(count);
+    }
+
+    template<class Kind, class... Args>
+    static pointer<Kind> make(Args&&... args) {
+        return std::make_unique<Kind>(std::forward<Args>(args)...);
+    }
+
+    template<class F>
+    static pointer<F> clone(const F& figure) {
+        auto copy = figure.clone_unique();
+        return pointer<F>(static_cast<F*>(copy.release()));
+    }
+};
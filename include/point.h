@@ -2,6 +2,7 @@
 #include <iostream>
 #include <iterator>
 #include <cmath>
+#include <type_traits>
 
 // Концепт для проверки, что тип является скалярным (числовым).
 template<typename T>
@@ -62,8 +63,90 @@ class Point {
             point_y = new_y;
         };
 
+        // Арифметика точек как двумерных векторов.
+        // Все операции поэлементные над парой координат без ветвлений, поэтому в циклах по массивам вершин
+        // компилятор размещает точку double в одном 128-битном регистре (две точки float - в одном регистре из 4 полос).
+        Point& operator+=(const Point& other) {
+            point_x += other.point_x;
+            point_y += other.point_y;
+            return *this;
+        };
+
+        Point& operator-=(const Point& other) {
+            point_x -= other.point_x;
+            point_y -= other.point_y;
+            return *this;
+        };
+
+        Point& operator*=(T factor) {
+            point_x *= factor;
+            point_y *= factor;
+            return *this;
+        };
+
+        friend Point operator+(Point a, const Point& b) {
+            return a += b;
+        }
+
+        friend Point operator-(Point a, const Point& b) {
+            return a -= b;
+        }
+
+        friend Point operator-(const Point& a) {
+            return Point(-a.point_x, -a.point_y);
+        }
+
+        friend Point operator*(Point a, T factor) {
+            return a *= factor;
+        }
+
+        friend Point operator*(T factor, Point a) {
+            return a *= factor;
+        }
+
+        friend bool operator==(const Point& a, const Point& b) {
+            return a.point_x == b.point_x && a.point_y == b.point_y;
+        }
+
+        // Произведения координат считаются в double (long double - для long double), как в distance():
+        // для целочисленных координат это исключает переполнение, для float - потерю точности.
+        using Product = std::common_type_t<T, double>;
+
+        // Скалярное произведение.
+        friend Product dot(const Point& a, const Point& b) {
+            return static_cast<Product>(a.point_x) * static_cast<Product>(b.point_x) +
+                   static_cast<Product>(a.point_y) * static_cast<Product>(b.point_y);
+        }
+
+        // Псевдоскалярное (векторное) произведение: z-компонента a x b.
+        // Положительно, если поворот от a к b - против часовой стрелки.
+        friend Product cross(const Point& a, const Point& b) {
+            return static_cast<Product>(a.point_x) * static_cast<Product>(b.point_y) -
+                   static_cast<Product>(a.point_y) * static_cast<Product>(b.point_x);
+        }
+
+        // Квадрат длины вектора (без извлечения корня).
+        friend Product squared_norm(const Point& a) {
+            return dot(a, a);
+        }
+
+        // Линейная интерполяция: a при t = 0, b при t = 1. Считается в Product; целочисленные координаты
+        // округляются к ближайшему целому.
+        friend Point lerp(const Point& a, const Point& b, Product t) {
+            return Point(interpolate(a.point_x, b.point_x, t), interpolate(a.point_y, b.point_y, t));
+        }
+
 
     private:
+        static T interpolate(T from, T to, Product t) {
+            const Product value = static_cast<Product>(from) + (static_cast<Product>(to) - static_cast<Product>(from)) * t;
+            if constexpr (std::is_integral_v<T>) {
+                return static_cast<T>(std::llround(value));
+            } else {
+                return static_cast<T>(value);
+            }
+        }
+
         // Координаты точки.
         T point_x{0};
         T point_y{0};
@@ -0,0 +1,187 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+#include "point.h"
+#include "figure.h"
+#include "boundingbox.h"
+#include "collision.h"
+
+// Глубина взаимного проникновения двух пересекающихся выпуклых фигур и направление (единичный вектор),
+// в котором вторую фигуру нужно сдвинуть на depth, чтобы фигуры только касались.
+struct Penetration {
+    double depth{0.0};
+    Point<double> normal{0.0, 0.0};
+};
+
+// Квадрат расстояния от точки p до отрезка [a, b].
+inline double squared_distance_to_segment(const Point<double>& p, const Point<double>& a, const Point<double>& b) {
+    Point<double> d = b - a;
+    double length = squared_norm(d);
+    double t = length > 0.0 ? std::clamp(dot(p - a, d) / length, 0.0, 1.0) : 0.0;
+    return squared_norm(p - (a + d * t));
+}
+
+// Выпуклая фигура, подготовленная для многократных запросов к другим фигурам: вершины в double,
+// единичные нормали сторон, проекции фигуры на каждую свою нормаль и ограничивающий прямоугольник
+// вычисляются один раз, поэтому пакетная проверка одной фигуры против многих не повторяет эту работу.
+// Запросы - пересечение (SAT), минимальное расстояние и глубина проникновения - точные для выпуклых
+// многоугольников; для фигур из нескольких вершин перебор пар сторон дешевле итераций GJK/EPA.
+template<Scalar T>
+class ConvexProbe {
+    public:
+        explicit ConvexProbe(std::span<const Point<T>> vertices) {
+            const std::size_t n = vertices.size();
+            points.reserve(n);
+            for (const auto& vertex : vertices) {
+                Point<double> p(static_cast<double>(vertex.get_x()), static_cast<double>(vertex.get_y()));
+                points.push_back(p);
+                box.expand(p);
+            }
+            normals.reserve(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                Point<double> edge = points[next(i)] - points[i];
+                double length = std::sqrt(squared_norm(edge));
+                if (length == 0.0) {
+                    continue;
+                }
+                Point<double> normal(edge.get_y() / length, -edge.get_x() / length);
+                auto [low, high] = project(std::span<const Point<double>>(points), normal);
+                normals.push_back(normal);
+                extents.push_back(Extent{low, high});
+            }
+        };
+
+        explicit ConvexProbe(const Figure<T>& figure) : ConvexProbe(figure.vertices()) {};
+
+        const BoundingBox<double>& get_bounding_box() const {
+            return box;
+        };
+
+        // Пересекается ли фигура с выпуклым многоугольником other (касание считается пересечением).
+        bool intersects(std::span<const Point<T>> other) const {
+            return penetration_or_gap(other) >= 0.0;
+        };
+
+        // Минимальное расстояние до выпуклого многоугольника other (0, если фигуры пересекаются).
+        double distance(std::span<const Point<T>> other) const {
+            if (intersects(other)) {
+                return 0.0;
+            }
+            double best = std::numeric_limits<double>::infinity();
+            const std::size_t m = other.size();
+            // Многоугольники не пересекаются, поэтому расстояние между сторонами достигается на конце одной из них.
+            for (std::size_t i = 0; i < points.size(); ++i) {
+                for (std::size_t j = 0; j < m; ++j) {
+                    const Point<double> c = as_double(other[j]);
+                    const Point<double> d = as_double(other[j + 1 < m ? j + 1 : 0]);
+                    best = std::min(best, squared_distance_to_segment(points[i], c, d));
+                    best = std::min(best, squared_distance_to_segment(c, points[i], points[next(i)]));
+                }
+            }
+            return std::sqrt(best);
+        };
+
+        // Глубина проникновения: наименьшее перекрытие проекций по нормалям сторон обеих фигур
+        // (std::nullopt, если фигуры не пересекаются).
+        std::optional<Penetration> penetration(std::span<const Point<T>> other) const {
+            Penetration result;
+            if (penetration_or_gap(other, &result) < 0.0) {
+                return std::nullopt;
+            }
+            return result;
+        };
+
+    private:
+        struct Extent {
+            double low;
+            double high;
+        };
+
+        std::size_t next(std::size_t i) const {
+            return i + 1 < points.size() ? i + 1 : 0;
+        };
+
+        static Point<double> as_double(const Point<T>& point) {
+            return Point<double>(static_cast<double>(point.get_x()), static_cast<double>(point.get_y()));
+        };
+
+        template<Scalar U>
+        static Extent project(std::span<const Point<U>> polygon, const Point<double>& axis) {
+            Extent extent{std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()};
+            for (const auto& point : polygon) {
+                double projection = static_cast<double>(point.get_x()) * axis.get_x() + static_cast<double>(point.get_y()) * axis.get_y();
+                extent.low = std::min(extent.low, projection);
+                extent.high = std::max(extent.high, projection);
+            }
+            return extent;
+        };
+
+        // Наименьшее перекрытие проекций по осям (отрицательное - найдена разделяющая ось, остальные не проверяются).
+        // Если result задан и фигуры пересекаются, в него записываются глубина и направление сдвига other.
+        double penetration_or_gap(std::span<const Point<T>> other, Penetration* result = nullptr) const {
+            double best = std::numeric_limits<double>::infinity();
+            Point<double> best_normal(0.0, 0.0);
+            auto consider = [&](const Point<double>& axis, Extent mine, Extent their) {
+                double forward = mine.high - their.low;
+                double backward = their.high - mine.low;
+                double overlap = std::min(forward, backward);
+                if (overlap < best) {
+                    best = overlap;
+                    best_normal = forward <= backward ? axis : -axis;
+                }
+                return overlap >= 0.0;
+            };
+            for (std::size_t i = 0; i < normals.size(); ++i) {
+                if (!consider(normals[i], extents[i], project(other, normals[i]))) {
+                    return best;
+                }
+            }
+            const std::size_t m = other.size();
+            for (std::size_t j = 0; j < m; ++j) {
+                Point<double> edge = as_double(other[j + 1 < m ? j + 1 : 0]) - as_double(other[j]);
+                double length = std::sqrt(squared_norm(edge));
+                if (length == 0.0) {
+                    continue;
+                }
+                Point<double> axis(edge.get_y() / length, -edge.get_x() / length);
+                if (!consider(axis, project(std::span<const Point<double>>(points), axis), project(other, axis))) {
+                    return best;
+                }
+            }
+            if (result && std::isfinite(best)) {
+                *result = Penetration{best, best_normal};
+            }
+            return best;
+        };
+
+        std::vector<Point<double>> points;
+        std::vector<Point<double>> normals;
+        std::vector<Extent> extents;
+        BoundingBox<double> box;
+};
+
+// Запросы между двумя фигурами.
+
+// Пересекаются ли выпуклые фигуры (касание считается пересечением).
+template<Scalar T>
+bool figures_overlap(const Figure<T>& a, const Figure<T>& b) {
+    return convex_polygons_intersect(a.vertices(), b.vertices());
+}
+
+// Минимальное расстояние между выпуклыми фигурами (0 для пересекающихся).
+template<Scalar T>
+double figure_distance(const Figure<T>& a, const Figure<T>& b) {
+    return ConvexProbe<T>(a).distance(b.vertices());
+}
+
+// Глубина проникновения фигуры b в фигуру a и направление, в котором нужно сдвинуть b
+// (std::nullopt, если фигуры не пересекаются).
+template<Scalar T>
+std::optional<Penetration> penetration_depth(const Figure<T>& a, const Figure<T>& b) {
+    return ConvexProbe<T>(a).penetration(b.vertices());
+}
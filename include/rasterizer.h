@@ -0,0 +1,345 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "point.h"
+#include "boundingbox.h"
+#include "clipping.h"
+#include "threadpool.h"
+
+// Что записывается в ячейку сетки при растеризации.
+enum class RasterMode : std::uint8_t {
+    // 1 в каждой ячейке, центр которой лежит в фигуре.
+    Binary,
+    // +1 за каждую фигуру, в которой лежит центр ячейки (количество фигур над ячейкой).
+    Count,
+    // + доля площади ячейки, покрытая фигурой (сглаженное покрытие; только для сеток с плавающей точкой).
+    Area
+};
+
+// Двумерная сетка поверх памяти пользователя: width x height ячеек по строкам, строка 0 - нижняя.
+// Сетка накрывает прямоугольник window: ячейка (column, row) - это
+// [min_x + column * cell_width, min_x + (column + 1) * cell_width) x [min_y + row * cell_height, ...).
+template<class Cell>
+requires std::is_arithmetic_v<Cell>
+class RasterGrid {
+    public:
+        RasterGrid(std::span<Cell> cells, std::size_t width, std::size_t height, const BoundingBox<double>& window)
+            : cells(cells), columns(width), rows(height), area(window) {
+            if (width == 0 || height == 0 || cells.size() != width * height) {
+                throw std::invalid_argument("Raster grid size does not match its storage.");
+            }
+            if (!(window.width() > 0.0) || !(window.height() > 0.0)) {
+                throw std::invalid_argument("Raster window must have a positive area.");
+            }
+        };
+
+        std::size_t width() const {
+            return columns;
+        };
+
+        std::size_t height() const {
+            return rows;
+        };
+
+        const BoundingBox<double>& window() const {
+            return area;
+        };
+
+        double cell_width() const {
+            return area.width() / static_cast<double>(columns);
+        };
+
+        double cell_height() const {
+            return area.height() / static_cast<double>(rows);
+        };
+
+        std::span<Cell> row(std::size_t index) const {
+            return cells.subspan(index * columns, columns);
+        };
+
+        Cell& at(std::size_t column, std::size_t row) const {
+            return cells[row * columns + column];
+        };
+
+    private:
+        std::span<Cell> cells;
+        std::size_t columns;
+        std::size_t rows;
+        BoundingBox<double> area;
+};
+
+// Растеризатор выпуклых многоугольников в строки сетки. Рабочие буферы живут в объекте и переиспользуются,
+// поэтому отрисовка многих фигур не выделяет память на каждую фигуру.
+// Binary и Count: для каждой строки пересечение фигуры с горизонталью через центры ячеек даёт отрезок [left, right),
+// и заполняются ячейки, центр которых лежит в нём (непрерывный цикл по строке, векторизуемый компилятором).
+// Смежные фигуры с общей стороной не закрашивают одну ячейку дважды.
+// Area: фигура отсекается полосой строки (Сазерленд-Ходжман); ячейки между крайними точками левой и правой
+// границы на обеих сторонах полосы покрыты полностью, для остальных доля - разность площадей частей среза
+// левее сторон столбца.
+template<class Cell>
+class PolygonRasterizer {
+    public:
+        PolygonRasterizer(const RasterGrid<Cell>& grid, RasterMode mode) : grid(grid), mode(mode) {
+            if constexpr (!std::is_floating_point_v<Cell>) {
+                if (mode == RasterMode::Area) {
+                    throw std::invalid_argument("Area coverage requires a floating-point raster grid.");
+                }
+            }
+        };
+
+        // Отрисовка многоугольника только в строки [row_begin, row_end).
+        template<Scalar T>
+        void draw(std::span<const Point<T>> polygon, std::size_t row_begin, std::size_t row_end) {
+            if (polygon.size() < 3) {
+                return;
+            }
+            points.clear();
+            BoundingBox<double> box;
+            for (const auto& vertex : polygon) {
+                points.emplace_back(static_cast<double>(vertex.get_x()), static_cast<double>(vertex.get_y()));
+                box.expand(points.back());
+            }
+            auto [first, last] = rows_of(box.min_y, box.max_y);
+            first = std::max(first, row_begin);
+            last = std::min(last, row_end);
+            for (std::size_t r = first; r < last; ++r) {
+                if (mode == RasterMode::Area) {
+                    cover_row(r);
+                } else {
+                    fill_row(r);
+                }
+            }
+        };
+
+    private:
+        // Строки, которые задевает отрезок [low, high] по Y: [first, last).
+        std::pair<std::size_t, std::size_t> rows_of(double low, double high) const {
+            const double y0 = grid.window().min_y;
+            const double dy = grid.cell_height();
+            const double first = std::floor((low - y0) / dy);
+            const double last = std::floor((high - y0) / dy) + 1.0;
+            return {clamp_index(first, grid.height()), clamp_index(last, grid.height())};
+        };
+
+        static std::size_t clamp_index(double value, std::size_t limit) {
+            return static_cast<std::size_t>(std::clamp(value, 0.0, static_cast<double>(limit)));
+        };
+
+        // Закраска ячеек строки r по центрам.
+        void fill_row(std::size_t r) {
+            const double y = grid.window().min_y + (static_cast<double>(r) + 0.5) * grid.cell_height();
+            double left = 0.0;
+            double right = 0.0;
+            bool crossed = false;
+            const std::size_t n = points.size();
+            for (std::size_t i = 0; i < n; ++i) {
+                const Point<double>& a = points[i];
+                const Point<double>& b = points[i + 1 < n ? i + 1 : 0];
+                if ((a.get_y() <= y) == (b.get_y() <= y)) {
+                    continue;
+                }
+                double x = a.get_x() + (y - a.get_y()) * (b.get_x() - a.get_x()) / (b.get_y() - a.get_y());
+                left = crossed ? std::min(left, x) : x;
+                right = crossed ? std::max(right, x) : x;
+                crossed = true;
+            }
+            if (!crossed) {
+                return;
+            }
+            const double x0 = grid.window().min_x;
+            const double dx = grid.cell_width();
+            // Центр столбца c: x0 + (c + 0.5) dx, закрашиваются столбцы с центром в [left, right).
+            const std::size_t begin = clamp_index(std::ceil((left - x0) / dx - 0.5), grid.width());
+            const std::size_t end = clamp_index(std::ceil((right - x0) / dx - 0.5), grid.width());
+            if (begin >= end) {
+                return;
+            }
+            Cell* span = grid.row(r).data();
+            if (mode == RasterMode::Binary) {
+                std::fill(span + begin, span + end, Cell(1));
+            } else {
+                for (std::size_t c = begin; c < end; ++c) {
+                    span[c] += Cell(1);
+                }
+            }
+        };
+
+        // Накопление доли покрытой площади в ячейках строки r.
+        void cover_row(std::size_t r) {
+            const auto& window = grid.window();
+            const double dx = grid.cell_width();
+            const double dy = grid.cell_height();
+            BoundingBox<double> band;
+            band.expand(window.min_x, window.min_y + static_cast<double>(r) * dy);
+            band.expand(window.max_x, window.min_y + static_cast<double>(r + 1) * dy);
+            sutherland_hodgman(std::span<const Point<double>>(points), band, slice, scratch);
+            if (slice.size() < 3) {
+                return;
+            }
+
+            // Границы среза на нижней и верхней стороне полосы (точки отсечения лежат на них точно).
+            constexpr double infinity = std::numeric_limits<double>::infinity();
+            double min_x = slice[0].get_x();
+            double max_x = min_x;
+            bool on_bottom = false;
+            bool on_top = false;
+            double bottom_left = infinity;
+            double bottom_right = -infinity;
+            double top_left = infinity;
+            double top_right = -infinity;
+            for (const auto& p : slice) {
+                min_x = std::min(min_x, p.get_x());
+                max_x = std::max(max_x, p.get_x());
+                if (p.get_y() == band.min_y) {
+                    on_bottom = true;
+                    bottom_left = std::min(bottom_left, p.get_x());
+                    bottom_right = std::max(bottom_right, p.get_x());
+                }
+                if (p.get_y() == band.max_y) {
+                    on_top = true;
+                    top_left = std::min(top_left, p.get_x());
+                    top_right = std::max(top_right, p.get_x());
+                }
+            }
+            // Левая граница выпуклого среза выпукла, правая вогнута, поэтому полностью покрытый участок
+            // строки ограничен их значениями на сторонах полосы.
+            std::size_t full_begin = 0;
+            std::size_t full_end = 0;
+            if (on_bottom && on_top) {
+                const double inner_left = std::max(bottom_left, top_left);
+                const double inner_right = std::min(bottom_right, top_right);
+                full_begin = clamp_index(std::ceil((inner_left - window.min_x) / dx), grid.width());
+                full_end = clamp_index(std::floor((inner_right - window.min_x) / dx), grid.width());
+                full_end = std::max(full_end, full_begin);
+            }
+            const std::size_t begin = clamp_index(std::floor((min_x - window.min_x) / dx), grid.width());
+            const std::size_t end = clamp_index(std::floor((max_x - window.min_x) / dx) + 1.0, grid.width());
+            Cell* span = grid.row(r).data();
+            for (std::size_t c = full_begin; c < full_end; ++c) {
+                span[c] += Cell(1);
+            }
+            // Доля площади столбца c - разность площадей частей среза левее его правой и левой сторон.
+            // Столбцы частично покрытых участков идут подряд, поэтому площадь на левой стороне берётся с прошлого шага.
+            const double doubled_cell_area = 2.0 * dx * dy;
+            std::size_t previous = end;
+            double previous_area = 0.0;
+            for (std::size_t c = begin; c < end; ++c) {
+                if (c >= full_begin && c < full_end) {
+                    continue;
+                }
+                double left_area = previous == c ? previous_area : doubled_area_left_of(window.min_x + static_cast<double>(c) * dx);
+                double right_area = doubled_area_left_of(window.min_x + static_cast<double>(c + 1) * dx);
+                span[c] += static_cast<Cell>(std::fabs(right_area - left_area) / doubled_cell_area);
+                previous = c + 1;
+                previous_area = right_area;
+            }
+        };
+
+        // Удвоенная ориентированная площадь части среза левее вертикали x: один проход отсечения
+        // полуплоскостью, точки результата не сохраняются, а сразу идут в формулу Гаусса
+        // (относительно первой вершины среза, чтобы не терять точность на больших координатах).
+        double doubled_area_left_of(double x) const {
+            const Point<double> origin = slice[0];
+            const std::size_t n = slice.size();
+            double doubled = 0.0;
+            bool any = false;
+            Point<double> first;
+            Point<double> last;
+            auto emit = [&](const Point<double>& p) {
+                const Point<double> local = p - origin;
+                if (any) {
+                    doubled += cross(last, local);
+                } else {
+                    first = local;
+                    any = true;
+                }
+                last = local;
+            };
+            for (std::size_t i = 0; i < n; ++i) {
+                const Point<double>& a = slice[i];
+                const Point<double>& b = slice[i + 1 < n ? i + 1 : 0];
+                const bool a_inside = a.get_x() <= x;
+                if (a_inside) {
+                    emit(a);
+                }
+                if (a_inside != (b.get_x() <= x)) {
+                    double t = (x - a.get_x()) / (b.get_x() - a.get_x());
+                    emit(Point<double>(x, a.get_y() + t * (b.get_y() - a.get_y())));
+                }
+            }
+            if (any) {
+                doubled += cross(last, first);
+            }
+            return doubled;
+        };
+
+        const RasterGrid<Cell>& grid;
+        RasterMode mode;
+        std::vector<Point<double>> points;
+        std::vector<Point<double>> slice;
+        std::vector<Point<double>> scratch;
+};
+
+// Растеризация набора выпуклых многоугольников параллельными полосами строк.
+// boxes[i] - ограничивающий прямоугольник многоугольника i (пустой - многоугольник пропускается),
+// polygon_of(i) - его вершины. Многоугольники раскладываются по полосам из band_rows строк,
+// каждая полоса рисуется одной задачей пула в свои строки (без блокировок), многоугольники - по возрастанию
+// номера, поэтому результат не зависит от количества потоков. Сетка не очищается: значения добавляются
+// к уже записанным (в режиме Binary - закрашенные ячейки становятся 1).
+template<class Cell, class PolygonOf>
+void rasterize_polygons(ThreadPool& pool, const RasterGrid<Cell>& grid, RasterMode mode,
+                        std::span<const BoundingBox<double>> boxes, PolygonOf&& polygon_of, std::size_t band_rows = 16) {
+    // Проверка сочетания режима и типа ячейки до раскладки (бросает исключение в вызывающем потоке).
+    PolygonRasterizer<Cell> check(grid, mode);
+    band_rows = std::max<std::size_t>(band_rows, 1);
+    const std::size_t bands = (grid.height() + band_rows - 1) / band_rows;
+    const double y0 = grid.window().min_y;
+    const double dy = grid.cell_height() * static_cast<double>(band_rows);
+    auto band_of = [&](double y) {
+        return static_cast<std::size_t>(std::clamp(std::floor((y - y0) / dy), 0.0, static_cast<double>(bands - 1)));
+    };
+    auto visible = [&](const BoundingBox<double>& box) {
+        return !box.is_empty() && box.intersects(grid.window());
+    };
+
+    // Раскладка номеров многоугольников по полосам (подсчёт, префиксные суммы, заполнение).
+    std::vector<std::size_t> starts(bands + 1, 0);
+    for (const auto& box : boxes) {
+        if (visible(box)) {
+            for (std::size_t b = band_of(box.min_y); b <= band_of(box.max_y); ++b) {
+                ++starts[b + 1];
+            }
+        }
+    }
+    for (std::size_t b = 0; b < bands; ++b) {
+        starts[b + 1] += starts[b];
+    }
+    std::vector<std::size_t> by_band(starts.back());
+    std::vector<std::size_t> fill(starts.begin(), starts.end() - 1);
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+        if (visible(boxes[i])) {
+            for (std::size_t b = band_of(boxes[i].min_y); b <= band_of(boxes[i].max_y); ++b) {
+                by_band[fill[b]++] = i;
+            }
+        }
+    }
+
+    pool.parallel_for(0, bands, 1, [&](std::size_t first, std::size_t last) {
+        PolygonRasterizer<Cell> rasterizer(grid, mode);
+        for (std::size_t b = first; b < last; ++b) {
+            const std::size_t row_begin = b * band_rows;
+            const std::size_t row_end = std::min(grid.height(), row_begin + band_rows);
+            for (std::size_t k = starts[b]; k < starts[b + 1]; ++k) {
+                rasterizer.draw(polygon_of(by_band[k]), row_begin, row_end);
+            }
+        }
+    });
+}
@@ -0,0 +1,130 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+#include "point.h"
+#include "affine.h"
+
+// Таблица единичной окружности для правильного N-угольника: cos и sin углов 2*pi*i/N
+// и площадь и периметр N-угольника, вписанного в окружность радиуса 1.
+// Вычисляется один раз на N при первом обращении.
+template<std::size_t N>
+requires (N >= 3)
+struct UnitCircleTable {
+    std::array<double, N> cos{};
+    std::array<double, N> sin{};
+    double area_factor{0.0};
+    double perimeter_factor{0.0};
+
+    static const UnitCircleTable& get() {
+        static const UnitCircleTable table;
+        return table;
+    };
+
+    private:
+        UnitCircleTable() {
+            for (std::size_t i = 0; i < N; ++i) {
+                double angle = 2.0 * std::numbers::pi * static_cast<double>(i) / static_cast<double>(N);
+                cos[i] = std::cos(angle);
+                sin[i] = std::sin(angle);
+            }
+            area_factor = 0.5 * static_cast<double>(N) * std::sin(2.0 * std::numbers::pi / static_cast<double>(N));
+            perimeter_factor = 2.0 * static_cast<double>(N) * std::sin(std::numbers::pi / static_cast<double>(N));
+        };
+};
+
+// Вершины правильного N-угольника с центром center, радиусом описанной окружности radius,
+// первая вершина повёрнута на angle радиан от оси X. Обход против часовой стрелки.
+// Поворот таблицы требует одного вычисления sin/cos на фигуру вместо N.
+template<std::size_t N, std::floating_point T>
+std::array<Point<T>, N> regular_polygon_vertices(const Point<T>& center, T radius, double angle = 0.0) {
+    if (!(radius > 0) || !std::isfinite(radius)) {
+        throw std::invalid_argument("Invalid regular polygon: radius must be positive and finite.");
+    }
+    const auto& table = UnitCircleTable<N>::get();
+    const double rc = static_cast<double>(radius) * std::cos(angle);
+    const double rs = static_cast<double>(radius) * std::sin(angle);
+    std::array<Point<T>, N> vertices;
+    for (std::size_t i = 0; i < N; ++i) {
+        vertices[i] = Point<T>(static_cast<T>(center.get_x() + rc * table.cos[i] - rs * table.sin[i]),
+                               static_cast<T>(center.get_y() + rs * table.cos[i] + rc * table.sin[i]));
+    }
+    return vertices;
+}
+
+// Площадь и периметр правильного N-угольника по радиусу описанной окружности (в замкнутой форме).
+template<std::size_t N>
+double regular_polygon_area(double radius) {
+    return UnitCircleTable<N>::get().area_factor * radius * radius;
+}
+
+template<std::size_t N>
+double regular_polygon_perimeter(double radius) {
+    return UnitCircleTable<N>::get().perimeter_factor * radius;
+}
+
+// Результат проверки правильного многоугольника.
+enum class RegularityCheck {
+    Regular,
+    UnequalSides,
+    NotConcyclic
+};
+
+// Проверка, что вершины (в порядке обхода) образуют правильный N-угольник:
+// все стороны равны и все вершины равноудалены от центра (с погрешностью eps).
+// Длина каждой стороны вычисляется один раз.
+template<std::size_t N, Scalar T>
+RegularityCheck check_regular_polygon(const std::array<Point<T>, N>& points, double eps = 1e-6) {
+    std::array<double, N> sides;
+    Point<T> sum = points[0];
+    for (std::size_t i = 0; i < N; ++i) {
+        sides[i] = std::sqrt(static_cast<double>(squared_norm(points[(i + 1) % N] - points[i])));
+        if (i > 0) {
+            sum += points[i];
+        }
+    }
+    for (std::size_t i = 0; i + 1 < N; ++i) {
+        if (std::fabs(sides[i] - sides[i + 1]) > eps) {
+            return RegularityCheck::UnequalSides;
+        }
+    }
+    Point<T> center(sum.get_x() / static_cast<double>(N), sum.get_y() / static_cast<double>(N));
+    double radius = distance(center, points[0]);
+    for (const auto& point : points) {
+        if (std::fabs(distance(center, point) - radius) > eps) {
+            return RegularityCheck::NotConcyclic;
+        }
+    }
+    return RegularityCheck::Regular;
+}
+
+// Сохранённые площадь и периметр фигуры (NaN - значение не сохранено и вычисляется по вершинам).
+// Заполняется фабриками правильных многоугольников и сбрасывается при изменении вершин.
+struct MeasureCache {
+    double area{std::numeric_limits<double>::quiet_NaN()};
+    double perimeter{std::numeric_limits<double>::quiet_NaN()};
+
+    bool has_area() const {
+        return !std::isnan(area);
+    };
+
+    bool has_perimeter() const {
+        return !std::isnan(perimeter);
+    };
+
+    // Пересчёт после преобразования подобия: площадь умножается на |det|, периметр - на sqrt(|det|).
+    // Несохранённые значения (NaN) остаются NaN.
+    void transform(const Affine2D& matrix) {
+        area *= std::fabs(matrix.determinant());
+        perimeter *= matrix.length_scale();
+    };
+
+    template<std::size_t N>
+    static MeasureCache regular(double radius) {
+        return MeasureCache{regular_polygon_area<N>(radius), regular_polygon_perimeter<N>(radius)};
+    };
+};
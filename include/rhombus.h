@@ -1,8 +1,13 @@
 #pragma once
 #include <memory>
 #include <string>
+#include <string_view>
 #include "point.h"
 #include "figure.h"
+#include "validation.h"
+#include <expected>
+#include <array>
+#include <span>
 #include <compare>
 #include <cmath>
 #include <stdexcept>
@@ -12,71 +17,47 @@ template<Scalar T>
 class Rhombus : public Figure<T> {
     public:
         // Конструктор по умолчанию.
-        Rhombus() : Figure<T>("rhombus") {};
+        Rhombus() : Figure<T>(FigureKind::Rhombus) {};
         // Конструктор точками.
-        Rhombus(const Point<T>& p1, const Point<T>& p2, const Point<T>& p3, const Point<T>& p4, std::string description = "rhombus")
-        : Figure<T>(description) {
-            // Координаты векторов сторон ромба.
-            Point<T> AB = Point<T>(p1.get_x() - p2.get_x(), p1.get_y() - p2.get_y());
-            Point<T> BC = Point<T>(p2.get_x() - p3.get_x(), p2.get_y() - p3.get_y());
-            Point<T> CD = Point<T>(p3.get_x() - p4.get_x(), p3.get_y() - p4.get_y());
-            Point<T> DA = Point<T>(p4.get_x() - p1.get_x(), p4.get_y() - p1.get_y());
-            // Проверка, что все стороны равны.
-            if (distance(p1, p2) != distance(p2, p3) ||
-                distance(p2, p3) != distance(p3, p4) ||
-                distance(p3, p4) != distance(p4, p1)) {
-                throw std::invalid_argument("Invalid rhombus points: all sides must be of equal length.");
-            }
-            // Проверка, что соседние стороны параллельны. Если косинус угла между векторами равен 1, то векторы параллельны. Вариант с косинусом:
-            /*
-            else if (!(((fabs(AB.get_x() * CD.get_x() + AB.get_y() * CD.get_y()) / (distance(p1, p2) * distance(p3, p4))) - 1 < 1e-9) &&
-                    ((fabs(DA.get_x() * BC.get_x() + DA.get_y() * BC.get_y()) / (distance(p2, p3) * distance(p4, p1))) - 1 < 1e-9))) {
-                throw std::invalid_argument("Invalid rhombus points: adjacent sides must be non-parallel.");
-            }
-            */
-            // Через векторное произведение для проверки порядка точек и непараллельности соседних сторон:
-            else if (!(std::fabs((AB.get_x() * BC.get_y() - AB.get_y() * BC.get_x())) > 1e-10 &&
-                    std::fabs((BC.get_x() * CD.get_y() - BC.get_y() * CD.get_x())) > 1e-10 &&
-                    std::fabs((CD.get_x() * DA.get_y() - CD.get_y() * DA.get_x())) > 1e-10 &&
-                    std::fabs((DA.get_x() * AB.get_y() - DA.get_y() * AB.get_x())) > 1e-10)) {
-                throw std::invalid_argument("Invalid rhombus points: adjacent sides must be non-parallel and ordered correctly.");
+        Rhombus(const Point<T>& p1, const Point<T>& p2, const Point<T>& p3, const Point<T>& p4, std::string_view description = {})
+        : Figure<T>(FigureKind::Rhombus, description) {
+            if (ValidationError error = validation_error(p1, p2, p3, p4); error != ValidationError::None) {
+                FIGURES_VALIDATION_FAILURE(validation_error_message(error));
+                throw FigureValidationError(error);
             }
             // Если проверки пройдены, сохраняем точки.
-            points[0] = std::make_unique<Point<T>>(p1);
-            points[1] = std::make_unique<Point<T>>(p2);
-            points[2] = std::make_unique<Point<T>>(p3);
-            points[3] = std::make_unique<Point<T>>(p4);
+            points = {p1, p2, p3, p4};
         };
 
-        // Перегрузка операторов = копирования и перемещения.
-        // Конструктор копирования.
-        Rhombus(const Rhombus& other) {
-            for (int i = 0; i < 4; ++i) {
-                points[i] = std::make_unique<Point<T>>(*other.points[i]);
+        // Создание фигуры без исключений: при некорректных точках возвращается причина отказа.
+        // Предназначено для массовой проверки недоверенных данных, где отказы - обычный случай.
+        static std::expected<Rhombus, ValidationError> try_create(const Point<T>& p1, const Point<T>& p2, const Point<T>& p3, const Point<T>& p4, std::string_view description = {}) {
+            if (ValidationError error = validation_error(p1, p2, p3, p4); error != ValidationError::None) {
+                FIGURES_VALIDATION_FAILURE(validation_error_message(error));
+                return std::unexpected(error);
             }
+            return Rhombus(std::array<Point<T>, 4>{p1, p2, p3, p4}, description);
         };
 
+        // Перегрузка операторов = копирования и перемещения.
+        // Конструктор копирования.
+        Rhombus(const Rhombus& other) : Figure<T>(other), points(other.points) {};
+
         // Перегрузка копирования.
         Rhombus& operator=(const Rhombus& other) {
             if (this != &other) {
-                for (int i = 0; i < 4; ++i) {
-                    points[i] = std::make_unique<Point<T>>(*other.points[i]);
-                }
+                Figure<T>::operator=(other);
+                points = other.points;
             }
             return *this;
         };
         // Конструктор перемещения.
-        Rhombus(Rhombus&& other) noexcept {
-            for (int i = 0; i < 4; ++i) {
-                points[i] = std::move(other.points[i]);
-            }
-        };
+        Rhombus(Rhombus&& other) noexcept : Figure<T>(std::move(other)), points(other.points) {};
         // Перегрузка перемещения.
         Rhombus& operator=(Rhombus&& other) noexcept {
             if (this != &other) {
-                for (int i = 0; i < 4; ++i) {
-                    points[i] = std::move(other.points[i]);
-                }
+                Figure<T>::operator=(std::move(other));
+                points = other.points;
             }
             return *this;
         };
@@ -94,18 +75,18 @@ class Rhombus : public Figure<T> {
 
         // Переопределение виртуальных методов базового класса.
         std::unique_ptr<Point<T>> geometric_center() const override{
-            double center_x = (points[0]->get_x() + points[2]->get_x() + points[1]->get_x() + points[3]->get_x()) / 4.0;
-            double center_y = (points[0]->get_y() + points[2]->get_y() + points[1]->get_y() + points[3]->get_y()) / 4.0;
-            return std::make_unique<Point<T>>(center_x, center_y);
+            Point<T> sum = (points[0] + points[2]) + (points[1] + points[3]);
+            return std::make_unique<Point<T>>(sum.get_x() / 4.0, sum.get_y() / 4.0);
         };
+        // Площадь ромба - половина произведения диагоналей.
         double square() const override{
-            double diagonal1 = distance(*points[0], *points[2]);
-            double diagonal2 = distance(*points[1], *points[3]);
-            return (diagonal1 * diagonal2) / 2.0;
+            double diagonal1 = squared_norm(points[2] - points[0]);
+            double diagonal2 = squared_norm(points[3] - points[1]);
+            return std::sqrt(diagonal1 * diagonal2) / 2.0;
         };
         double perimeter() const override{
-            double length = distance(*points[0], *points[1]);
-            double width = distance(*points[0], *points[3]);
+            double length = std::sqrt(static_cast<double>(squared_norm(points[1] - points[0])));
+            double width = std::sqrt(static_cast<double>(squared_norm(points[3] - points[0])));
             return 2 * (length + width);
         };
 
@@ -113,26 +94,91 @@ class Rhombus : public Figure<T> {
             return this->square();
         };
 
+        // Проверка точек фигуры. Используется конструктором и is_valid().
+        // Возвращает причину отказа или ValidationError::None, если точки образуют ромб.
+        static ValidationError validation_error(const Point<T>& p1, const Point<T>& p2, const Point<T>& p3, const Point<T>& p4) {
+            // Векторы сторон ромба.
+            Point<T> AB = p1 - p2;
+            Point<T> BC = p2 - p3;
+            Point<T> CD = p3 - p4;
+            Point<T> DA = p4 - p1;
+            // Проверка, что все стороны равны.
+            if (distance(p1, p2) != distance(p2, p3) ||
+                distance(p2, p3) != distance(p3, p4) ||
+                distance(p3, p4) != distance(p4, p1)) {
+                return ValidationError::RhombusUnequalSides;
+            }
+            // Проверка, что соседние стороны параллельны. Если косинус угла между векторами равен 1, то векторы параллельны. Вариант с косинусом:
+            /*
+            else if (!(((fabs(AB.get_x() * CD.get_x() + AB.get_y() * CD.get_y()) / (distance(p1, p2) * distance(p3, p4))) - 1 < 1e-9) &&
+                    ((fabs(DA.get_x() * BC.get_x() + DA.get_y() * BC.get_y()) / (distance(p2, p3) * distance(p4, p1))) - 1 < 1e-9))) {
+                return "Invalid rhombus points: adjacent sides must be non-parallel.";
+            }
+            */
+            // Через векторное произведение для проверки порядка точек и непараллельности соседних сторон:
+            else if (!(std::fabs(cross(AB, BC)) > 1e-10 &&
+                    std::fabs(cross(BC, CD)) > 1e-10 &&
+                    std::fabs(cross(CD, DA)) > 1e-10 &&
+                    std::fabs(cross(DA, AB)) > 1e-10)) {
+                return ValidationError::RhombusDegenerateOrUnordered;
+            }
+            return ValidationError::None;
+        };
+
+        // Проверка, что фигура по-прежнему корректна (например, после чтения из потока).
+        bool is_valid() const override {
+            return validation_error(points[0], points[1], points[2], points[3]) == ValidationError::None;
+        };
+
+        // Доступ к вершинам фигуры.
+        std::size_t vertex_count() const override {
+            return 4;
+        };
+        Point<T> vertex(std::size_t index) const override {
+            return points[index];
+        };
+        std::span<const Point<T>> vertices() const override {
+            return points;
+        };
+
+        // Преобразование вершин (один проход по массиву, лежащему внутри объекта).
+        void transform_unchecked(const Affine2D& matrix) override {
+            for (auto& point : points) {
+                point = matrix.apply(point);
+            }
+        };
+
         // Перегрузка операторов ввода/вывода.
         void print(std::ostream& os) const override{
             for (const auto& point : points) {
-                os << *point << std::endl;
+                os << point << std::endl;
             }
         };
         void read(std::istream& is) override{
             Point<T> temp;
             for (auto& point : points) {
                 is >> temp;
-                point = std::make_unique<Point<T>>(temp);
+                point = temp;
             }
         };
 
         // Функция для клонирования фигуры.
         std::shared_ptr<Figure<T>> clone() const override{
-            return std::make_shared<Rhombus>(*points[0], *points[1], *points[2], *points[3]);
+            FIGURES_COUNT(Cloned);
+            return std::make_shared<Rhombus>(*this);
+        };
+        std::unique_ptr<Figure<T>> clone_unique() const override{
+            FIGURES_COUNT(Cloned);
+            return std::make_unique<Rhombus>(*this);
         };
 
     private:
-        std::unique_ptr<Point<T>> points[4];
+        // Конструктор для уже проверенных вершин.
+        Rhombus(const std::array<Point<T>, 4>& checked_points, std::string_view description)
+            : Figure<T>(FigureKind::Rhombus, description), points(checked_points) {};
+
+        // Вершины хранятся внутри объекта подряд (без отдельных выделений памяти),
+        // выравнивание позволяет загружать точку double одной инструкцией.
+        alignas(2 * sizeof(T)) std::array<Point<T>, 4> points{};
 
 };
\ No newline at end of file
@@ -0,0 +1,122 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "threadpool.h"
+
+// Кривая, заполняющая плоскость, по которой упорядочиваются фигуры.
+// Близкие по ключу точки близки на плоскости, поэтому проход по фигурам в порядке ключа
+// обращается к соседним фигурам подряд.
+enum class SpaceFillingCurve : std::uint8_t {
+    // Z-порядок: чередование битов координат. Вычисляется быстрее.
+    Morton,
+    // Кривая Гильберта: соседние ключи всегда соответствуют соседним ячейкам, локальность лучше.
+    Hilbert
+};
+
+// Количество бит на координату: ячейки сетки 65536 x 65536, ключ помещается в 32 бита.
+inline constexpr unsigned SPATIAL_KEY_BITS = 16;
+inline constexpr std::uint32_t SPATIAL_GRID_MAX = (1u << SPATIAL_KEY_BITS) - 1;
+
+// Разнесение 16 бит числа по чётным позициям 32-битного слова.
+constexpr std::uint32_t spread_bits(std::uint32_t v) {
+    v &= 0x0000FFFFu;
+    v = (v | (v << 8)) & 0x00FF00FFu;
+    v = (v | (v << 4)) & 0x0F0F0F0Fu;
+    v = (v | (v << 2)) & 0x33333333u;
+    v = (v | (v << 1)) & 0x55555555u;
+    return v;
+}
+
+// Ключ Мортона ячейки (x, y): биты x на чётных позициях, биты y - на нечётных.
+constexpr std::uint32_t morton_key(std::uint32_t x, std::uint32_t y) {
+    return spread_bits(x) | (spread_bits(y) << 1);
+}
+
+// Номер ячейки (x, y) вдоль кривой Гильберта на сетке 2^16 x 2^16.
+constexpr std::uint32_t hilbert_key(std::uint32_t x, std::uint32_t y) {
+    x &= SPATIAL_GRID_MAX;
+    y &= SPATIAL_GRID_MAX;
+    std::uint32_t key = 0;
+    for (std::uint32_t s = 1u << (SPATIAL_KEY_BITS - 1); s > 0; s >>= 1) {
+        std::uint32_t rx = (x & s) ? 1u : 0u;
+        std::uint32_t ry = (y & s) ? 1u : 0u;
+        key += s * s * ((3u * rx) ^ ry);
+        // Поворот четверти, чтобы следующий уровень начинался в правильном углу.
+        if (ry == 0) {
+            if (rx == 1) {
+                x = SPATIAL_GRID_MAX - x;
+                y = SPATIAL_GRID_MAX - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return key;
+}
+
+constexpr std::uint32_t space_filling_key(SpaceFillingCurve curve, std::uint32_t x, std::uint32_t y) {
+    return curve == SpaceFillingCurve::Hilbert ? hilbert_key(x, y) : morton_key(x, y);
+}
+
+// Ключ сортировки и исходная позиция элемента.
+struct SpatialKey {
+    std::uint32_t key{0};
+    std::size_t index{0};
+};
+
+// Параллельная поразрядная (LSD) сортировка по 32-битным ключам, 4 прохода по 8 бит.
+// Каждый проход: гистограммы частей по grain элементов строятся параллельно, смещения считаются
+// последовательно (по цифре, затем по части), раскладка по смещениям снова параллельна.
+// Сортировка устойчива: элементы с равными ключами сохраняют исходный порядок.
+// Проход пропускается, если все элементы имеют одну и ту же цифру.
+inline void parallel_radix_sort(ThreadPool& pool, std::vector<SpatialKey>& items, std::size_t grain) {
+    constexpr std::size_t RADIX = 256;
+    const std::size_t n = items.size();
+    if (n < 2) {
+        return;
+    }
+    grain = grain == 0 ? 1 : grain;
+    const std::size_t blocks = (n + grain - 1) / grain;
+    std::vector<std::array<std::size_t, RADIX>> offsets(blocks);
+    std::vector<SpatialKey> buffer(n);
+    for (unsigned shift = 0; shift < 32; shift += 8) {
+        pool.parallel_for(0, blocks, 1, [&](std::size_t first, std::size_t last) {
+            for (std::size_t block = first; block < last; ++block) {
+                auto& counts = offsets[block];
+                counts.fill(0);
+                std::size_t hi = std::min(n, (block + 1) * grain);
+                for (std::size_t i = block * grain; i < hi; ++i) {
+                    ++counts[(items[i].key >> shift) & (RADIX - 1)];
+                }
+            }
+        });
+        std::size_t offset = 0;
+        bool single_digit = false;
+        for (std::size_t digit = 0; digit < RADIX; ++digit) {
+            std::size_t digit_total = 0;
+            for (auto& counts : offsets) {
+                std::size_t count = counts[digit];
+                counts[digit] = offset + digit_total;
+                digit_total += count;
+            }
+            single_digit = single_digit || digit_total == n;
+            offset += digit_total;
+        }
+        if (single_digit) {
+            continue;
+        }
+        pool.parallel_for(0, blocks, 1, [&](std::size_t first, std::size_t last) {
+            for (std::size_t block = first; block < last; ++block) {
+                auto& positions = offsets[block];
+                std::size_t hi = std::min(n, (block + 1) * grain);
+                for (std::size_t i = block * grain; i < hi; ++i) {
+                    buffer[positions[(items[i].key >> shift) & (RADIX - 1)]++] = items[i];
+                }
+            }
+        });
+        items.swap(buffer);
+    }
+}
@@ -0,0 +1,236 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Пул потоков с перехватом задач (work stealing).
+// У каждого рабочего потока своя очередь задач: владелец кладёт и забирает задачи с конца (LIFO - горячие данные в кэше),
+// остальные потоки крадут задачи с начала (FIFO - самые крупные части диапазона).
+// Параллельный цикл делит диапазон пополам, пока части больше grain: одна половина остаётся в работе,
+// другая кладётся в очередь и может быть украдена свободным потоком. Поэтому неравномерная нагрузка
+// (например, смесь фигур разной сложности) автоматически перераспределяется между потоками.
+class ThreadPool {
+    public:
+        explicit ThreadPool(unsigned thread_count = std::max(1u, std::thread::hardware_concurrency())) {
+            if (thread_count == 0) {
+                thread_count = 1;
+            }
+            // Последняя очередь - общая, в неё кладут задачи потоки, не принадлежащие пулу.
+            for (unsigned i = 0; i <= thread_count; ++i) {
+                queues.push_back(std::make_unique<WorkerQueue>());
+            }
+            threads.reserve(thread_count);
+            for (unsigned i = 0; i < thread_count; ++i) {
+                threads.emplace_back([this, i]() { worker_loop(i); });
+            }
+        };
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(sleep_mutex);
+                stopping = true;
+            }
+            sleep_cv.notify_all();
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        };
+
+        // Количество рабочих потоков.
+        unsigned get_thread_count() const {
+            return static_cast<unsigned>(threads.size());
+        };
+
+        // Общий пул на всё приложение (создаётся при первом обращении).
+        static ThreadPool& global() {
+            static ThreadPool pool;
+            return pool;
+        };
+
+        // Параллельный цикл по диапазону [begin, end).
+        // body(lo, hi) вызывается для непересекающихся частей диапазона размером не больше grain
+        // и должен быть безопасен для одновременного вызова из нескольких потоков.
+        // Вызывающий поток участвует в работе и возвращается после обработки всего диапазона.
+        // Первое исключение из body пробрасывается вызывающему после завершения остальных частей.
+        template<class F>
+        void parallel_for(std::size_t begin, std::size_t end, std::size_t grain, F&& body) {
+            if (begin >= end) {
+                return;
+            }
+            grain = std::max<std::size_t>(grain, 1);
+            if (end - begin <= grain) {
+                body(begin, end);
+                return;
+            }
+            RangeState<F> state(std::forward<F>(body), grain, end - begin);
+            run_range(state, begin, end);
+            wait_until_done(state.remaining);
+            if (state.error) {
+                std::rethrow_exception(state.error);
+            }
+        };
+
+        // Параллельная свёртка диапазона [begin, end).
+        // map(lo, hi) вычисляет частичный результат для части диапазона, reduce объединяет частичные результаты.
+        // Диапазон делится на фиксированные части размером grain, а частичные результаты объединяются по порядку,
+        // поэтому результат не зависит от количества потоков и порядка выполнения (важно для сумм double).
+        template<class R, class Map, class Reduce>
+        R parallel_reduce(std::size_t begin, std::size_t end, std::size_t grain, R init, Map&& map, Reduce&& reduce) {
+            if (begin >= end) {
+                return init;
+            }
+            grain = std::max<std::size_t>(grain, 1);
+            const std::size_t blocks = (end - begin + grain - 1) / grain;
+            std::vector<R> partial(blocks, init);
+            parallel_for(0, blocks, 1, [&](std::size_t first, std::size_t last) {
+                for (std::size_t b = first; b < last; ++b) {
+                    std::size_t lo = begin + b * grain;
+                    partial[b] = map(lo, std::min(end, lo + grain));
+                }
+            });
+            R result = std::move(init);
+            for (auto& value : partial) {
+                result = reduce(std::move(result), std::move(value));
+            }
+            return result;
+        };
+
+    private:
+        using Task = std::function<void()>;
+
+        struct WorkerQueue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        // Состояние одного параллельного цикла. Живёт на стеке вызывающего потока до завершения всех частей.
+        template<class F>
+        struct RangeState {
+            RangeState(F&& b, std::size_t g, std::size_t n) : body(std::forward<F>(b)), grain(g), remaining(n) {};
+
+            F body;
+            std::size_t grain;
+            std::atomic<std::size_t> remaining;
+            std::mutex error_mutex;
+            std::exception_ptr error;
+        };
+
+        std::vector<std::unique_ptr<WorkerQueue>> queues;
+        std::vector<std::thread> threads;
+        std::mutex sleep_mutex;
+        std::condition_variable sleep_cv;
+        std::atomic<std::size_t> queued{0};
+        bool stopping{false};
+
+        // Пул и номер очереди текущего потока (для потоков вне пула - пусто).
+        struct CurrentWorker {
+            const ThreadPool* pool{nullptr};
+            std::size_t index{0};
+        };
+        static CurrentWorker& current() {
+            static thread_local CurrentWorker worker;
+            return worker;
+        };
+
+        std::size_t own_queue() const {
+            const CurrentWorker& worker = current();
+            return worker.pool == this ? worker.index : threads.size();
+        };
+
+        void push(Task task) {
+            WorkerQueue& queue = *queues[own_queue()];
+            {
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                queue.tasks.push_back(std::move(task));
+            }
+            queued.fetch_add(1, std::memory_order_release);
+            sleep_cv.notify_one();
+        };
+
+        // Выполнение одной задачи: сначала своя очередь (с конца), затем кража из чужих (с начала).
+        bool try_run_one() {
+            const std::size_t self = own_queue();
+            Task task;
+            {
+                WorkerQueue& queue = *queues[self];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (!queue.tasks.empty()) {
+                    task = std::move(queue.tasks.back());
+                    queue.tasks.pop_back();
+                }
+            }
+            for (std::size_t k = 1; !task && k < queues.size(); ++k) {
+                WorkerQueue& victim = *queues[(self + k) % queues.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.tasks.empty()) {
+                    task = std::move(victim.tasks.front());
+                    victim.tasks.pop_front();
+                }
+            }
+            if (!task) {
+                return false;
+            }
+            queued.fetch_sub(1, std::memory_order_acq_rel);
+            task();
+            return true;
+        };
+
+        void worker_loop(std::size_t index) {
+            current() = CurrentWorker{this, index};
+            for (;;) {
+                if (try_run_one()) {
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(sleep_mutex);
+                if (stopping) {
+                    return;
+                }
+                // Ожидание с таймаутом страхует от пропущенного уведомления между проверкой очередей и засыпанием.
+                sleep_cv.wait_for(lock, std::chrono::milliseconds(1), [this]() {
+                    return stopping || queued.load(std::memory_order_acquire) > 0;
+                });
+            }
+        };
+
+        // Рекурсивное деление диапазона: правая половина уходит в очередь, левая обрабатывается сразу.
+        template<class F>
+        void run_range(RangeState<F>& state, std::size_t lo, std::size_t hi) {
+            while (hi - lo > state.grain) {
+                std::size_t mid = lo + (hi - lo) / 2;
+                push([this, &state, mid, hi]() { run_range(state, mid, hi); });
+                hi = mid;
+            }
+            try {
+                state.body(lo, hi);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state.error_mutex);
+                if (!state.error) {
+                    state.error = std::current_exception();
+                }
+            }
+            // Последнее обращение к state: после этого вызывающий поток может завершить цикл.
+            state.remaining.fetch_sub(hi - lo, std::memory_order_acq_rel);
+        };
+
+        // Ожидание завершения цикла. Поток не простаивает, а выполняет задачи пула (в том числе чужие).
+        void wait_until_done(const std::atomic<std::size_t>& remaining) {
+            while (remaining.load(std::memory_order_acquire) > 0) {
+                if (!try_run_one()) {
+                    std::this_thread::yield();
+                }
+            }
+        };
+};
@@ -0,0 +1,104 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <vector>
+#include "boundingbox.h"
+
+// Равномерная сетка над набором прямоугольников: в каждой ячейке - номера прямоугольников, которые её задевают
+// (хранятся одним массивом, сгруппированным по ячейкам). Размер ячейки - средний размер прямоугольника;
+// количество ячеек не превышает 4n. Пустые прямоугольники в сетку не попадают.
+class UniformGrid {
+    public:
+        UniformGrid() = default;
+
+        explicit UniformGrid(std::span<const BoundingBox<double>> boxes) {
+            double size_sum = 0.0;
+            for (const auto& box : boxes) {
+                bounds.expand(box);
+                size_sum += std::max(box.width(), box.height());
+            }
+            if (bounds.is_empty()) {
+                return;
+            }
+            const std::size_t n = boxes.size();
+            cell_size = std::max(size_sum / static_cast<double>(n), 1e-12 * std::max({1.0, bounds.width(), bounds.height()}));
+            auto dimension = [this](double extent) {
+                return static_cast<std::size_t>(std::min(std::ceil(extent / cell_size), 1e9)) + 1;
+            };
+            const double limit = 4.0 * static_cast<double>(n);
+            while (static_cast<double>(dimension(bounds.width())) * static_cast<double>(dimension(bounds.height())) > limit) {
+                cell_size *= 2.0;
+            }
+            columns = dimension(bounds.width());
+            rows = dimension(bounds.height());
+
+            // Подсчёт, префиксные суммы и раскладка номеров по ячейкам.
+            starts.assign(columns * rows + 1, 0);
+            for (const auto& box : boxes) {
+                for_each_cell_index(box, [this](std::size_t c) { ++starts[c + 1]; });
+            }
+            for (std::size_t c = 0; c < columns * rows; ++c) {
+                starts[c + 1] += starts[c];
+            }
+            entries.resize(starts.back());
+            std::vector<std::size_t> fill(starts.begin(), starts.end() - 1);
+            for (std::size_t i = 0; i < n; ++i) {
+                for_each_cell_index(boxes[i], [&](std::size_t c) { entries[fill[c]++] = i; });
+            }
+        };
+
+        // Общий прямоугольник всех (непустых) прямоугольников сетки.
+        const BoundingBox<double>& get_bounds() const {
+            return bounds;
+        };
+
+        // Номера прямоугольников ячейки, в которую попадает точка (x, y). Точки вне get_bounds() относятся
+        // к ближайшей крайней ячейке, поэтому их нужно отбрасывать заранее.
+        std::span<const std::size_t> cell_entries(double x, double y) const {
+            if (bounds.is_empty()) {
+                return {};
+            }
+            return cell(row_of(y) * columns + column_of(x));
+        };
+
+        // Вызов body(номера прямоугольников ячейки) для каждой ячейки, которую задевает прямоугольник box.
+        // Прямоугольник, задевающий несколько из этих ячеек, встречается несколько раз.
+        template<class F>
+        void for_each_cell(const BoundingBox<double>& box, F&& body) const {
+            for_each_cell_index(box, [&](std::size_t c) { body(cell(c)); });
+        };
+
+    private:
+        std::span<const std::size_t> cell(std::size_t c) const {
+            return std::span<const std::size_t>(entries).subspan(starts[c], starts[c + 1] - starts[c]);
+        };
+
+        std::size_t column_of(double x) const {
+            return std::min(columns - 1, static_cast<std::size_t>(std::max(0.0, (x - bounds.min_x) / cell_size)));
+        };
+
+        std::size_t row_of(double y) const {
+            return std::min(rows - 1, static_cast<std::size_t>(std::max(0.0, (y - bounds.min_y) / cell_size)));
+        };
+
+        template<class F>
+        void for_each_cell_index(const BoundingBox<double>& box, F&& body) const {
+            if (box.is_empty() || bounds.is_empty()) {
+                return;
+            }
+            for (std::size_t r = row_of(box.min_y); r <= row_of(box.max_y); ++r) {
+                for (std::size_t c = column_of(box.min_x); c <= column_of(box.max_x); ++c) {
+                    body(r * columns + c);
+                }
+            }
+        };
+
+        BoundingBox<double> bounds;
+        double cell_size{1.0};
+        std::size_t columns{1};
+        std::size_t rows{1};
+        std::vector<std::size_t> starts;
+        std::vector<std::size_t> entries;
+};
@@ -0,0 +1,578 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <span>
+#include <utility>
+#include <vector>
+#include "point.h"
+#include "boundingbox.h"
+#include "threadpool.h"
+
+// Набор многоугольников в одном непрерывном буфере точек (контур i - точки [offsets[i], offsets[i + 1])).
+// Контуры приводятся к обходу против часовой стрелки, для каждого хранится ограничивающий прямоугольник.
+class PolygonSet {
+    public:
+        PolygonSet() : offsets{0} {};
+
+        // Добавление контура (меньше трёх вершин или нулевая площадь - контур не добавляется).
+        template<Scalar T>
+        void add(std::span<const Point<T>> contour) {
+            if (contour.size() < 3) {
+                return;
+            }
+            const std::size_t first = points.size();
+            BoundingBox<double> box;
+            double doubled_area = 0.0;
+            for (const auto& point : contour) {
+                Point<double> p(static_cast<double>(point.get_x()), static_cast<double>(point.get_y()));
+                points.push_back(p);
+                box.expand(p);
+            }
+            for (std::size_t i = first; i < points.size(); ++i) {
+                doubled_area += cross(points[i], points[i + 1 < points.size() ? i + 1 : first]);
+            }
+            if (doubled_area == 0.0) {
+                points.resize(first);
+                return;
+            }
+            if (doubled_area < 0.0) {
+                std::reverse(points.begin() + static_cast<std::ptrdiff_t>(first), points.end());
+            }
+            offsets.push_back(points.size());
+            boxes.push_back(box);
+        };
+
+        void reserve(std::size_t polygons, std::size_t vertices) {
+            offsets.reserve(polygons + 1);
+            boxes.reserve(polygons);
+            points.reserve(vertices);
+        };
+
+        std::size_t size() const {
+            return boxes.size();
+        };
+
+        std::span<const Point<double>> contour(std::size_t index) const {
+            return std::span<const Point<double>>(points).subspan(offsets[index], offsets[index + 1] - offsets[index]);
+        };
+
+        const BoundingBox<double>& box(std::size_t index) const {
+            return boxes[index];
+        };
+
+        std::span<const BoundingBox<double>> get_boxes() const {
+            return boxes;
+        };
+
+    private:
+        std::vector<Point<double>> points;
+        std::vector<std::size_t> offsets;
+        std::vector<BoundingBox<double>> boxes;
+};
+
+// Площадь объединения многоугольников (покрытая площадь: перекрытия считаются один раз).
+// Заметающая прямая движется по x. Вертикальные стороны не влияют на площадь и отбрасываются; остальные стороны -
+// отрезки прямых y(x), активные на [begin, end). Нижняя сторона многоугольника (обход против часовой стрелки идёт
+// вправо) увеличивает количество покрывающих многоугольников выше неё на 1, верхняя - уменьшает.
+// Между соседними событиями (концы сторон и точки пересечения сторон) порядок активных сторон по y не меняется,
+// поэтому покрытая длина сечения - линейная функция x, и площадь полосы - длина в середине полосы, умноженная на ширину.
+// Активные стороны хранятся в декартовом дереве (treap) по y; в каждом узле - сводка поддерева, из которой длина
+// сечения берётся в корне (см. Summary). Пересечения соседних сторон находятся как в алгоритме Бентли - Оттмана.
+// Время - O((m + k) log m), где m - число сторон, k - число пересечений сторон разных многоугольников, лежащих
+// рядом в порядке по y. Совпадающие и вложенные многоугольники не создают пересечений: n одинаковых или вложенных
+// квадратов обрабатываются за O(n log n).
+// Параллельный режим: ось x делится на полосы (tiles) примерно по grain многоугольников (меньше, если стороны длинные),
+// стороны обрезаются границами полос, полосы заметаются задачами пула независимо, а их площади складываются по порядку. Разбиение зависит только
+// от набора и grain, поэтому результат не зависит от количества потоков.
+// Многоугольники могут быть невыпуклыми, но не самопересекающимися.
+class UnionArea {
+    public:
+        static double compute(const PolygonSet& polygons, ThreadPool& pool, std::size_t grain) {
+            const std::size_t n = polygons.size();
+            std::size_t vertices = 0;
+            double scale = 1.0;
+            for (std::size_t i = 0; i < n; ++i) {
+                const auto& box = polygons.box(i);
+                vertices += polygons.contour(i).size();
+                scale = std::max({scale, std::fabs(box.min_x), std::fabs(box.max_x), std::fabs(box.min_y), std::fabs(box.max_y)});
+            }
+            std::vector<Edge> edges;
+            edges.reserve(vertices);
+            for (std::size_t i = 0; i < n; ++i) {
+                auto contour = polygons.contour(i);
+                const std::size_t count = contour.size();
+                for (std::size_t v = 0; v < count; ++v) {
+                    const Point<double>& a = contour[v];
+                    const Point<double>& b = contour[v + 1 < count ? v + 1 : 0];
+                    if (a.get_x() == b.get_x()) {
+                        continue;
+                    }
+                    const Point<double>& left = a.get_x() < b.get_x() ? a : b;
+                    const Point<double>& right = a.get_x() < b.get_x() ? b : a;
+                    const double slope = (right.get_y() - left.get_y()) / (right.get_x() - left.get_x());
+                    edges.push_back(Edge{left.get_x(), left.get_y(), slope, left.get_x(), right.get_x(), a.get_x() < b.get_x() ? 1 : -1});
+                }
+            }
+            if (edges.empty()) {
+                return 0.0;
+            }
+            // Порядок сторон с разницей y не больше tolerance определяется наклоном (как если бы они совпадали).
+            const double tolerance = 1e-12 * scale;
+
+            std::size_t tiles = std::min((n + std::max<std::size_t>(grain, 1) - 1) / std::max<std::size_t>(grain, 1), edges.size());
+            if (tiles <= 1) {
+                return Sweep(edges, tolerance).run();
+            }
+
+            // Границы полос - квантили левых концов сторон, чтобы в полосах было примерно поровну сторон.
+            // Длинная сторона копируется во все полосы, которые она пересекает (n вложенных квадратов дали бы
+            // O(n * tiles) кусков), поэтому полос становится вдвое меньше, пока кусков больше 2m.
+            std::vector<double> starts;
+            starts.reserve(edges.size());
+            for (const auto& edge : edges) {
+                starts.push_back(edge.begin);
+            }
+            std::sort(starts.begin(), starts.end());
+            std::vector<double> borders;
+            for (; tiles > 1; tiles /= 2) {
+                borders.clear();
+                for (std::size_t t = 1; t < tiles; ++t) {
+                    const double border = starts[t * starts.size() / tiles];
+                    if (border > starts.front() && (borders.empty() || border > borders.back())) {
+                        borders.push_back(border);
+                    }
+                }
+                std::size_t count = 0;
+                for (const auto& edge : edges) {
+                    count += static_cast<std::size_t>(std::lower_bound(borders.begin(), borders.end(), edge.end) -
+                                                      std::upper_bound(borders.begin(), borders.end(), edge.begin)) + 1;
+                }
+                if (count <= 2 * edges.size()) {
+                    break;
+                }
+            }
+            if (borders.empty() || tiles <= 1) {
+                return Sweep(edges, tolerance).run();
+            }
+
+            // Сторона попадает во все полосы, которые она пересекает, и обрезается их границами.
+            std::vector<std::vector<Edge>> pieces(borders.size() + 1);
+            for (const auto& edge : edges) {
+                std::size_t t = static_cast<std::size_t>(std::upper_bound(borders.begin(), borders.end(), edge.begin) - borders.begin());
+                for (; t < pieces.size(); ++t) {
+                    Edge piece = edge;
+                    piece.begin = t == 0 ? edge.begin : std::max(edge.begin, borders[t - 1]);
+                    piece.end = t == borders.size() ? edge.end : std::min(edge.end, borders[t]);
+                    if (piece.begin < piece.end) {
+                        pieces[t].push_back(piece);
+                    }
+                    if (t == borders.size() || edge.end <= borders[t]) {
+                        break;
+                    }
+                }
+            }
+            std::vector<double> areas(pieces.size(), 0.0);
+            pool.parallel_for(0, pieces.size(), 1, [&](std::size_t lo, std::size_t hi) {
+                for (std::size_t t = lo; t < hi; ++t) {
+                    areas[t] = Sweep(pieces[t], tolerance).run();
+                }
+            });
+            double area = 0.0;
+            for (double value : areas) {
+                area += value;
+            }
+            return area;
+        };
+
+    private:
+        // Сторона многоугольника: прямая y = y0 + slope (x - x0), активная на [begin, end).
+        // delta = +1 - нижняя сторона (многоугольник выше неё), -1 - верхняя.
+        struct Edge {
+            double x0;
+            double y0;
+            double slope;
+            double begin;
+            double end;
+            int delta;
+
+            double y_at(double x) const {
+                return y0 + slope * (x - x0);
+            };
+        };
+
+        // Линейная функция c0 + c1 (x - origin), где origin - начало заметания.
+        struct Linear {
+            double c0{0.0};
+            double c1{0.0};
+
+            Linear& operator+=(const Linear& other) {
+                c0 += other.c0;
+                c1 += other.c1;
+                return *this;
+            };
+
+            Linear& operator-=(const Linear& other) {
+                c0 -= other.c0;
+                c1 -= other.c1;
+                return *this;
+            };
+        };
+
+        // Сводка последовательности сторон (по возрастанию y). Префикс - сумма delta сторон от начала последовательности;
+        // minimum - наименьший префикс (включая пустой, равный 0). Количество покрывающих многоугольников неотрицательно,
+        // поэтому непокрытые промежутки - ровно те, где префикс всего сечения равен минимуму (в корне - нулю).
+        // Покрытая длина = сумма y верхних границ покрытия (сторон, после которых префикс равен минимуму)
+        // минус сумма y нижних границ (сторон, до которых префикс равен минимуму). Сводки поддеревьев объединяются
+        // за O(1), поэтому вставка и удаление стороны обновляют сводку корня за O(log m).
+        struct Summary {
+            int sum{0};
+            int minimum{0};
+            Linear length;
+        };
+
+        // Заметание одной полосы: события - концы сторон и пересечения соседних сторон.
+        // Узлы дерева выделяются при вставке стороны и дополнительно связаны в список по порядку (prev, next).
+        // В точке пересечения соседние стороны меняются узлами: форма дерева и список не меняются,
+        // обновляются только сводки на путях от этих узлов к корню.
+        class Sweep {
+            public:
+                // Стороны упорядочиваются по левому концу: вставки идут по массиву подряд.
+                Sweep(std::span<const Edge> sweep_edges, double sweep_tolerance)
+                    : tolerance(sweep_tolerance), slots(sweep_edges.size(), NONE) {
+                    std::vector<std::pair<double, std::size_t>> order(sweep_edges.size());
+                    for (std::size_t e = 0; e < order.size(); ++e) {
+                        order[e] = {sweep_edges[e].begin, e};
+                    }
+                    std::sort(order.begin(), order.end());
+                    edges.reserve(order.size());
+                    for (const auto& [begin, e] : order) {
+                        edges.push_back(sweep_edges[e]);
+                    }
+                    origin = edges.empty() ? 0.0 : edges.front().begin;
+                };
+
+                double run() {
+                    const std::size_t m = edges.size();
+                    // Правые концы сторон с номерами, по возрастанию.
+                    std::vector<std::pair<double, std::size_t>> ends(m);
+                    for (std::size_t e = 0; e < m; ++e) {
+                        ends[e] = {edges[e].end, e};
+                    }
+                    std::sort(ends.begin(), ends.end());
+
+                    std::vector<std::size_t> touched;
+                    double area = 0.0;
+                    double x = 0.0;
+                    bool started = false;
+                    std::size_t next_begin = 0;
+                    std::size_t next_end = 0;
+                    while (next_end < m) {
+                        double next = ends[next_end].first;
+                        if (next_begin < m) {
+                            next = std::min(next, edges[next_begin].begin);
+                        }
+                        if (!crossings.empty()) {
+                            next = std::min(next, crossings.top().x);
+                        }
+                        if (started) {
+                            area += covered_length(0.5 * (x + next)) * (next - x);
+                        }
+                        x = next;
+                        started = true;
+                        touched.clear();
+
+                        // Стороны, которые заканчиваются в x.
+                        for (; next_end < m && ends[next_end].first <= x; ++next_end) {
+                            remove(ends[next_end].second, touched);
+                        }
+                        // Пересечения в x: соседние стороны меняются местами.
+                        while (!crossings.empty() && crossings.top().x <= x) {
+                            const Crossing crossing = crossings.top();
+                            crossings.pop();
+                            swap_crossed(crossing.lower, crossing.upper, x);
+                        }
+                        // Стороны, которые начинаются в x.
+                        for (; next_begin < m && edges[next_begin].begin <= x; ++next_begin) {
+                            touched.push_back(insert(next_begin, x));
+                        }
+                        // Новые пары соседей.
+                        for (std::size_t v : touched) {
+                            if (nodes[v].active) {
+                                check_crossing(nodes[v].prev, v, x);
+                                check_crossing(v, nodes[v].next, x);
+                            }
+                        }
+                    }
+                    return area;
+                };
+
+            private:
+                static constexpr std::size_t NONE = static_cast<std::size_t>(-1);
+
+                // Узел хранит копию своей стороны: обновление сводок и сравнения не обращаются к массиву сторон.
+                struct Node {
+                    std::size_t edge{0};
+                    Edge data{};
+                    std::uint64_t priority{0};
+                    std::size_t left{NONE};
+                    std::size_t right{NONE};
+                    std::size_t parent{NONE};
+                    std::size_t prev{NONE};
+                    std::size_t next{NONE};
+                    bool active{true};
+                    // Сводка устарела: пересчитывается один раз на событие, перед вычислением покрытой длины.
+                    bool dirty{false};
+                    Summary summary;
+                };
+
+                // Пересечение сторон lower (ниже) и upper (выше) в точке x.
+                struct Crossing {
+                    double x;
+                    std::size_t lower;
+                    std::size_t upper;
+
+                    bool operator>(const Crossing& other) const {
+                        return x > other.x;
+                    };
+                };
+
+                std::vector<Edge> edges;
+                double tolerance;
+                double origin{0.0};
+                std::vector<Node> nodes;
+                // Узел, в котором лежит сторона (NONE - сторона ещё не вставлена или уже удалена).
+                std::vector<std::size_t> slots;
+                // Узлы удалённых сторон, которые можно занять снова: дерево остаётся размером с сечение и лежит в кэше.
+                std::vector<std::size_t> free_nodes;
+                std::size_t root{NONE};
+                std::uint64_t random_state{0x9E3779B97F4A7C15ull};
+                std::priority_queue<Crossing, std::vector<Crossing>, std::greater<Crossing>> crossings;
+
+                double covered_length(double x) {
+                    if (root == NONE) {
+                        return 0.0;
+                    }
+                    refresh(root);
+                    const Linear& length = nodes[root].summary.length;
+                    return length.c0 + length.c1 * (x - origin);
+                };
+
+                // Приоритет узла (splitmix64): форма дерева не зависит от порядка сторон.
+                std::uint64_t next_priority() {
+                    random_state += 0x9E3779B97F4A7C15ull;
+                    std::uint64_t z = random_state;
+                    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                    return z ^ (z >> 31);
+                };
+
+                // Сторона a ниже стороны b в точке x (при равных y - в точке правее x); a_id и b_id - их номера.
+                bool below(const Edge& a, std::size_t a_id, const Edge& b, std::size_t b_id, double x) const {
+                    const double dy = a.y_at(x) - b.y_at(x);
+                    if (std::fabs(dy) > tolerance) {
+                        return dy < 0.0;
+                    }
+                    if (a.slope != b.slope) {
+                        return a.slope < b.slope;
+                    }
+                    return a_id < b_id;
+                };
+
+                // Если стороны узлов lower и upper (соседних, lower ниже) пересекаются правее x,
+                // пересечение добавляется в очередь событий.
+                void check_crossing(std::size_t lower, std::size_t upper, double x) {
+                    if (lower == NONE || upper == NONE) {
+                        return;
+                    }
+                    const Edge& a = nodes[lower].data;
+                    const Edge& b = nodes[upper].data;
+                    const double limit = std::min(a.end, b.end);
+                    if (b.y_at(limit) - a.y_at(limit) >= -tolerance) {
+                        return;
+                    }
+                    double at = x + (b.y_at(x) - a.y_at(x)) / (a.slope - b.slope);
+                    if (!(at > x)) {
+                        at = std::nextafter(x, limit);
+                    }
+                    crossings.push(Crossing{std::min(at, limit), nodes[lower].edge, nodes[upper].edge});
+                };
+
+                // Перестановка пересекающихся сторон, если они всё ещё соседние и в точке x уже идут в обратном порядке.
+                void swap_crossed(std::size_t lower, std::size_t upper, double x) {
+                    const std::size_t a = slots[lower];
+                    const std::size_t b = slots[upper];
+                    if (a == NONE || b == NONE || nodes[a].next != b) {
+                        return;
+                    }
+                    if (!below(nodes[b].data, upper, nodes[a].data, lower, x)) {
+                        // Событие оказалось раньше пересечения (округление): пересечение ищется заново.
+                        check_crossing(a, b, x);
+                        return;
+                    }
+                    std::swap(nodes[a].edge, nodes[b].edge);
+                    std::swap(nodes[a].data, nodes[b].data);
+                    slots[upper] = a;
+                    slots[lower] = b;
+                    mark_dirty(a);
+                    mark_dirty(b);
+                    check_crossing(nodes[a].prev, a, x);
+                    check_crossing(b, nodes[b].next, x);
+                };
+
+                void update(std::size_t v) {
+                    static const Summary empty;
+                    Node& node = nodes[v];
+                    const Summary& l = node.left != NONE ? nodes[node.left].summary : empty;
+                    const Summary& r = node.right != NONE ? nodes[node.right].summary : empty;
+                    const Edge& edge = node.data;
+                    const Linear line{edge.y_at(origin), edge.slope};
+                    const int below_edge = l.sum;
+                    const int above_edge = below_edge + edge.delta;
+                    Summary& s = node.summary;
+                    s.sum = above_edge + r.sum;
+                    s.minimum = std::min(l.minimum, above_edge + r.minimum);
+                    s.length = l.minimum == s.minimum ? l.length : Linear{};
+                    if (above_edge == s.minimum) {
+                        s.length += line;
+                    }
+                    if (below_edge == s.minimum) {
+                        s.length -= line;
+                    }
+                    if (above_edge + r.minimum == s.minimum) {
+                        s.length += r.length;
+                    }
+                };
+
+                // Сводка узла v устарела. Если узел помечен, помечены и все его предки, поэтому подъём
+                // останавливается на первом помеченном узле.
+                void mark_dirty(std::size_t v) {
+                    for (; v != NONE && !nodes[v].dirty; v = nodes[v].parent) {
+                        nodes[v].dirty = true;
+                    }
+                };
+
+                // Пересчёт помеченных сводок поддерева v (снизу вверх).
+                void refresh(std::size_t v) {
+                    if (v == NONE || !nodes[v].dirty) {
+                        return;
+                    }
+                    refresh(nodes[v].left);
+                    refresh(nodes[v].right);
+                    update(v);
+                    nodes[v].dirty = false;
+                };
+
+                // Поворот: узел v поднимается на место своего родителя.
+                void rotate_up(std::size_t v) {
+                    const std::size_t p = nodes[v].parent;
+                    const std::size_t g = nodes[p].parent;
+                    if (nodes[p].left == v) {
+                        nodes[p].left = nodes[v].right;
+                        if (nodes[v].right != NONE) {
+                            nodes[nodes[v].right].parent = p;
+                        }
+                        nodes[v].right = p;
+                    } else {
+                        nodes[p].right = nodes[v].left;
+                        if (nodes[v].left != NONE) {
+                            nodes[nodes[v].left].parent = p;
+                        }
+                        nodes[v].left = p;
+                    }
+                    nodes[p].parent = v;
+                    nodes[v].parent = g;
+                    if (g == NONE) {
+                        root = v;
+                    } else if (nodes[g].left == p) {
+                        nodes[g].left = v;
+                    } else {
+                        nodes[g].right = v;
+                    }
+                    nodes[p].dirty = true;
+                    mark_dirty(v);
+                };
+
+                // Вставка стороны e в порядке по y в точке x. Возвращает её узел.
+                std::size_t insert(std::size_t e, double x) {
+                    std::size_t parent = NONE;
+                    std::size_t prev = NONE;
+                    std::size_t next = NONE;
+                    bool to_left = false;
+                    for (std::size_t current = root; current != NONE; current = to_left ? nodes[current].left : nodes[current].right) {
+                        parent = current;
+                        to_left = below(edges[e], e, nodes[current].data, nodes[current].edge, x);
+                        (to_left ? next : prev) = current;
+                    }
+                    std::size_t v = nodes.size();
+                    if (free_nodes.empty()) {
+                        nodes.emplace_back();
+                    } else {
+                        v = free_nodes.back();
+                        free_nodes.pop_back();
+                        nodes[v] = Node{};
+                    }
+                    Node& node = nodes[v];
+                    node.edge = e;
+                    node.data = edges[e];
+                    node.priority = next_priority();
+                    node.parent = parent;
+                    node.prev = prev;
+                    node.next = next;
+                    slots[e] = v;
+                    if (prev != NONE) {
+                        nodes[prev].next = v;
+                    }
+                    if (next != NONE) {
+                        nodes[next].prev = v;
+                    }
+                    if (parent == NONE) {
+                        root = v;
+                    } else if (to_left) {
+                        nodes[parent].left = v;
+                    } else {
+                        nodes[parent].right = v;
+                    }
+                    mark_dirty(v);
+                    while (nodes[v].parent != NONE && nodes[nodes[v].parent].priority < nodes[v].priority) {
+                        rotate_up(v);
+                    }
+                    return v;
+                };
+
+                // Удаление стороны e; её соседи становятся соседями друг друга и попадают в touched.
+                void remove(std::size_t e, std::vector<std::size_t>& touched) {
+                    const std::size_t v = slots[e];
+                    const std::size_t prev = nodes[v].prev;
+                    const std::size_t next = nodes[v].next;
+                    if (prev != NONE) {
+                        nodes[prev].next = next;
+                        touched.push_back(prev);
+                    }
+                    if (next != NONE) {
+                        nodes[next].prev = prev;
+                        touched.push_back(next);
+                    }
+                    while (nodes[v].left != NONE || nodes[v].right != NONE) {
+                        const std::size_t l = nodes[v].left;
+                        const std::size_t r = nodes[v].right;
+                        rotate_up(l == NONE ? r : r == NONE ? l : nodes[l].priority > nodes[r].priority ? l : r);
+                    }
+                    const std::size_t parent = nodes[v].parent;
+                    if (parent == NONE) {
+                        root = NONE;
+                    } else if (nodes[parent].left == v) {
+                        nodes[parent].left = NONE;
+                    } else {
+                        nodes[parent].right = NONE;
+                    }
+                    nodes[v].active = false;
+                    slots[e] = NONE;
+                    mark_dirty(parent);
+                    free_nodes.push_back(v);
+                };
+        };
+};
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+// Причина, по которой точки не образуют фигуру. Возвращается проверками фигур и фабриками try_create
+// вместо исключения, чтобы отбраковка некорректных записей не требовала раскрутки стека.
+enum class ValidationError : std::uint8_t {
+    // Проверка пройдена.
+    None,
+    RhombusUnequalSides,
+    RhombusDegenerateOrUnordered,
+    PentagonUnequalSides,
+    PentagonNotConcyclic,
+    HexagonUnequalSides,
+    HexagonNotConcyclic,
+    // Количество вершин не соответствует ни одной фигуре (в том числе запись, которую не удалось разобрать).
+    UnsupportedVertexCount,
+    Count
+};
+
+// Количество причин (размер таблиц, индексируемых ValidationError).
+inline constexpr std::size_t VALIDATION_ERROR_COUNT = static_cast<std::size_t>(ValidationError::Count);
+
+// Текст причины (он же сообщение исключения конструктора фигуры).
+constexpr const char* validation_error_message(ValidationError error) {
+    switch (error) {
+        case ValidationError::None: return "Valid figure.";
+        case ValidationError::RhombusUnequalSides: return "Invalid rhombus points: all sides must be of equal length.";
+        case ValidationError::RhombusDegenerateOrUnordered:
+            return "Invalid rhombus points: adjacent sides must be non-parallel and ordered correctly.";
+        case ValidationError::PentagonUnequalSides: return "Invalid pentagon points: all sides must be equal.";
+        case ValidationError::PentagonNotConcyclic: return "Invalid pentagon points: points must be concyclic.";
+        case ValidationError::HexagonUnequalSides: return "Invalid hexagon points: all sides must be equal.";
+        case ValidationError::HexagonNotConcyclic: return "Invalid hexagon points: points must be concyclic.";
+        case ValidationError::UnsupportedVertexCount: return "Invalid figure record: unsupported number of vertices.";
+        default: return "Invalid figure.";
+    }
+}
+
+// Исключение конструкторов фигур. Наследуется от std::invalid_argument, поэтому существующие обработчики
+// продолжают работать, и дополнительно хранит код причины.
+class FigureValidationError : public std::invalid_argument {
+    public:
+        explicit FigureValidationError(ValidationError error)
+            : std::invalid_argument(validation_error_message(error)), code(error) {};
+
+        ValidationError get_code() const noexcept {
+            return code;
+        };
+
+    private:
+        ValidationError code;
+};
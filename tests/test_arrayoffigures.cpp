@@ -1,11 +1,18 @@
 #include <gtest/gtest.h>
 #include <memory>
+#include <algorithm>
+#include <execution>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <sstream>
 #include "../include/arrayoffigures.h"
 #include "../include/rhombus.h"
 #include "../include/pentagon.h"
 #include "../include/hexagon.h"
 #include "../include/figure.h"
 #include "../include/point.h"
+#include "testfigures.h"
 
 static constexpr double EPS = 1e-6;
 
@@ -303,3 +310,509 @@ TEST(ArrayOfFiguresTest, RemoveFigure) {
     
     EXPECT_EQ(array.get_size(), 2);
 }
+
+// =========================
+// ЧАСТЬ 6: Итераторы, span и совместимость со стандартными алгоритмами
+// =========================
+
+static_assert(std::ranges::contiguous_range<ArrayOfFigures<Figure<double>>>);
+static_assert(std::ranges::sized_range<const ArrayOfFigures<Figure<double>>>);
+
+TEST(ArrayOfFiguresTest, Iterators_RangeForAndSpan) {
+    ArrayOfFigures<Figure<double>> array(2);
+
+    Point<double> p1(0.0, 1.0);
+    Point<double> p2(-1.0, 0.0);
+    Point<double> p3(0.0, -1.0);
+    Point<double> p4(1.0, 0.0);
+
+    for (int i = 0; i < 3; ++i) {
+        array.add_figure(std::make_shared<Rhombus<double>>(p1, p2, p3, p4));
+    }
+
+    // Итерация проходит только по занятой части массива
+    double total = 0.0;
+    size_t count = 0;
+    for (const auto& figure : array) {
+        total += figure->square();
+        ++count;
+    }
+    EXPECT_EQ(count, array.get_size());
+    EXPECT_NEAR(total, array.total_square(), EPS);
+
+    // span и data() указывают на один и тот же непрерывный буфер
+    auto view = array.as_span();
+    EXPECT_EQ(view.size(), 3u);
+    EXPECT_EQ(view.data(), array.data());
+    EXPECT_EQ(&array.get_unchecked(1), &array[1]);
+    EXPECT_EQ(array.end() - array.begin(), 3);
+}
+
+TEST(ArrayOfFiguresTest, Iterators_ParallelAlgorithm) {
+    ArrayOfFigures<Figure<double>> array(4);
+
+    Point<double> p1(0.0, 1.0);
+    Point<double> p2(-1.0, 0.0);
+    Point<double> p3(0.0, -1.0);
+    Point<double> p4(1.0, 0.0);
+
+    for (int i = 0; i < 100; ++i) {
+        array.add_figure(std::make_shared<Rhombus<double>>(p1, p2, p3, p4));
+    }
+
+    const auto& const_array = array;
+    double total = std::transform_reduce(std::execution::par_unseq, const_array.begin(), const_array.end(), 0.0,
+                                         std::plus<>(), [](const auto& figure) { return figure->square(); });
+    EXPECT_NEAR(total, 200.0, EPS);
+}
+
+TEST(ArrayOfFiguresTest, Iterators_EmptyArray) {
+    ArrayOfFigures<Figure<double>> array;
+
+    EXPECT_TRUE(array.empty());
+    EXPECT_EQ(array.begin(), array.end());
+    EXPECT_TRUE(array.as_span().empty());
+    EXPECT_NEAR(array.total_square(), 0.0, EPS);
+}
+
+// =========================
+// ЧАСТЬ 7: Параллельные массовые операции
+// =========================
+
+TEST(ArrayOfFiguresTest, Parallel_TotalSquareAndCentroids) {
+    auto array = mixed_figures(2000);
+    array.set_thread_pool(std::make_shared<ThreadPool>(4));
+
+    EXPECT_NEAR(array.parallel_total_square(), array.total_square(), 1e-6 * array.total_square());
+
+    auto centers = array.centroids();
+    ASSERT_EQ(centers.size(), array.get_size());
+    EXPECT_NEAR(centers[0].get_x(), 0.0, EPS);
+    EXPECT_NEAR(centers[1999].get_x(), 49.0, EPS);
+    EXPECT_NEAR(centers[1999].get_y(), 39.0, EPS);
+}
+
+TEST(ArrayOfFiguresTest, Parallel_ValidationCloneAndPrint) {
+    auto array = mixed_figures(1000);
+
+    EXPECT_TRUE(array.find_invalid().empty());
+
+    // Портим фигуру чтением некорректных вершин из потока
+    std::istringstream bad("(0, 0) (5, 0) (5, 1) (0, 1)");
+    bad >> *array[300];
+    auto invalid = array.find_invalid();
+    ASSERT_EQ(invalid.size(), 1u);
+    EXPECT_EQ(invalid[0], 300u);
+
+    auto copy = mixed_figures(1000).clone_all();
+    EXPECT_EQ(copy.get_size(), 1000u);
+    EXPECT_NEAR(copy.total_square(), mixed_figures(1000).total_square(), EPS);
+
+    std::ostringstream serial;
+    copy.print_figures(serial);
+    std::string parallel;
+    for (const auto& buffer : copy.print_to_buffers()) {
+        parallel += buffer;
+    }
+    EXPECT_EQ(parallel, serial.str());
+}
+
+// =========================
+// ЧАСТЬ 8: Политика единоличного владения (UniqueOwnership)
+// =========================
+
+TEST(ArrayOfFiguresTest, UniqueOwnership_AddResizeAndRemove) {
+    ArrayOfFigures<Figure<double>, UniqueOwnership> array(1);
+
+    for (int k = 1; k <= 5; ++k) {
+        array.add_figure(std::make_unique<Rhombus<double>>(
+            Point<double>(0.0, k), Point<double>(-k, 0.0), Point<double>(0.0, -k), Point<double>(k, 0.0)));
+    }
+    EXPECT_EQ(array.get_size(), 5u);
+    EXPECT_NEAR(array.total_square(), 2.0 * (1 + 4 + 9 + 16 + 25), EPS);
+
+    // Удаление сдвигает оставшиеся фигуры перемещением
+    array.remove_figure(0);
+    EXPECT_EQ(array.get_size(), 4u);
+    EXPECT_NEAR(array[0]->square(), 8.0, EPS);
+    EXPECT_NEAR(array[3]->square(), 50.0, EPS);
+}
+
+TEST(ArrayOfFiguresTest, UniqueOwnership_CopyIsDeep) {
+    ArrayOfFigures<Rhombus<double>, UniqueOwnership> array(2);
+    array.add_figure(std::make_unique<Rhombus<double>>(
+        Point<double>(0.0, 1.0), Point<double>(-1.0, 0.0), Point<double>(0.0, -1.0), Point<double>(1.0, 0.0)));
+
+    ArrayOfFigures<Rhombus<double>, UniqueOwnership> copy(array);
+    ASSERT_EQ(copy.get_size(), 1u);
+    EXPECT_NE(copy[0].get(), array[0].get());
+    EXPECT_NEAR(copy.total_square(), array.total_square(), EPS);
+
+    auto clones = array.clone_all();
+    EXPECT_NE(clones[0].get(), array[0].get());
+
+    ArrayOfFigures<Rhombus<double>, UniqueOwnership> moved(std::move(copy));
+    EXPECT_EQ(moved.get_size(), 1u);
+    EXPECT_EQ(copy.get_size(), 0u);
+}
+
+// =========================
+// ЧАСТЬ 9: Виды фигур (FigureKind)
+// =========================
+
+TEST(ArrayOfFiguresTest, CountByKind) {
+    auto array = mixed_figures(10);
+    auto counts = array.count_by_kind();
+    EXPECT_EQ(counts[static_cast<size_t>(FigureKind::Unknown)], 0u);
+    EXPECT_EQ(counts[static_cast<size_t>(FigureKind::Rhombus)], 4u);
+    EXPECT_EQ(counts[static_cast<size_t>(FigureKind::Pentagon)], 3u);
+    EXPECT_EQ(counts[static_cast<size_t>(FigureKind::Hexagon)], 3u);
+    EXPECT_EQ(array[0]->get_kind(), FigureKind::Rhombus);
+    EXPECT_EQ(array[1]->get_description(), "pentagon");
+}
+
+// =========================
+// ЧАСТЬ 10: Агрегаты массива
+// =========================
+
+TEST(ArrayOfFiguresTest, Aggregates_AddRemoveReplace) {
+    ArrayOfFigures<Figure<double>> array(2);
+    array.add_figure(shared_diamond(0.0, 0.0, 1.0));   // area = 2
+    array.add_figure(shared_diamond(10.0, 0.0, 2.0));  // area = 8
+    array.add_figure(std::make_shared<Pentagon<double>>(Pentagon<double>::regular(Point<double>(0.0, 0.0), 2.0)));
+
+    const auto& totals = array.aggregates();
+    EXPECT_EQ(totals.get_count(), 3u);
+    EXPECT_EQ(totals.get_count(FigureKind::Rhombus), 2u);
+    EXPECT_EQ(totals.get_count(FigureKind::Pentagon), 1u);
+    EXPECT_NEAR(array.total_area(), array.total_square(), EPS);
+    EXPECT_NEAR(totals.get_centroid_sum().get_x(), 10.0, EPS);
+    EXPECT_NEAR(array.bounding_box().max_x, 12.0, EPS);
+
+    // Удаление фигуры на границе прямоугольника уменьшает его при следующем чтении.
+    array.remove_figure(1);
+    EXPECT_EQ(array.aggregates().get_count(), 2u);
+    EXPECT_NEAR(array.bounding_box().max_x, 2.0, EPS);
+    EXPECT_NEAR(array.total_area(), array.total_square(), EPS);
+
+    // Замена через operator[] учитывается при следующем чтении.
+    array[0] = shared_diamond(0.0, 0.0, 3.0);  // area = 18
+    EXPECT_NEAR(array.total_area(), array.total_square(), EPS);
+    EXPECT_NEAR(array.bounding_box().min_x, -3.0, EPS);
+    array[1] = nullptr;
+    EXPECT_EQ(array.aggregates().get_count(FigureKind::Pentagon), 0u);
+    EXPECT_NEAR(array.total_area(), 18.0, EPS);
+
+    array.replace_figure(1, shared_diamond(0.0, 0.0, 1.0));
+    EXPECT_EQ(array.count_by_kind()[static_cast<size_t>(FigureKind::Rhombus)], 2u);
+    EXPECT_NEAR(array.total_perimeter(), 4.0 * std::sqrt(18.0) + 4.0 * std::sqrt(2.0), EPS);
+}
+
+TEST(ArrayOfFiguresTest, Aggregates_NoDriftAndRawAccess) {
+    ArrayOfFigures<Figure<double>> array(4);
+    array.add_figure(shared_diamond(0.0, 0.0, 1.0));
+    // Много добавлений и удалений фигур с сильно различающимися площадями.
+    for (int i = 0; i < 10000; ++i) {
+        array.add_figure(shared_diamond(0.0, 0.0, (i % 2) ? 1e4 : 1e-3));
+        array.remove_figure(1);
+    }
+    EXPECT_DOUBLE_EQ(array.total_area(), 2.0);
+
+    // Неконстантный доступ ко всему буферу приводит к полному пересчёту.
+    for (auto& figure : array) {
+        figure = shared_diamond(0.0, 0.0, 2.0);
+    }
+    EXPECT_NEAR(array.total_area(), 8.0, EPS);
+
+    ArrayOfFigures<Figure<double>> copy(array);
+    EXPECT_NEAR(copy.total_area(), 8.0, EPS);
+}
+
+// =========================
+// ЧАСТЬ 11: Создание фигур на месте и пакетное добавление
+// =========================
+
+TEST(ArrayOfFiguresTest, EmplaceFigure) {
+    ArrayOfFigures<Figure<double>> array(1);
+    Rhombus<double>& rhombus = array.emplace_figure<Rhombus<double>>(
+        Point<double>(0.0, 1.0), Point<double>(-1.0, 0.0), Point<double>(0.0, -1.0), Point<double>(1.0, 0.0));
+    EXPECT_EQ(array.get_size(), 1u);
+    EXPECT_EQ(array[0].get(), &rhombus);
+    EXPECT_EQ(array[0].use_count(), 1);
+    EXPECT_NEAR(array.total_area(), 2.0, EPS);
+
+    // Некорректные аргументы: исключение конструктора, массив не меняется.
+    EXPECT_THROW(array.emplace_figure<Rhombus<double>>(
+        Point<double>(0.0, 0.0), Point<double>(1.0, 0.0), Point<double>(5.0, 5.0), Point<double>(0.0, 1.0)), std::invalid_argument);
+    EXPECT_EQ(array.get_size(), 1u);
+
+    ArrayOfFigures<Rhombus<double>, UniqueOwnership> unique_array;
+    unique_array.emplace_figure(Point<double>(0.0, 2.0), Point<double>(-2.0, 0.0), Point<double>(0.0, -2.0), Point<double>(2.0, 0.0));
+    EXPECT_NEAR(unique_array.total_square(), 8.0, EPS);
+}
+
+TEST(ArrayOfFiguresTest, AddFiguresReservesOnce) {
+    std::vector<std::shared_ptr<Rhombus<double>>> batch;
+    for (int i = 1; i <= 100; ++i) {
+        batch.push_back(shared_diamond(0.0, 0.0, static_cast<double>(i)));
+    }
+    ArrayOfFigures<Figure<double>> array(1);
+    array.add_figure(batch[0]);
+    array.add_figures(batch);
+    EXPECT_EQ(array.get_size(), 101u);
+    EXPECT_EQ(array.get_capacity(), 101u);
+    EXPECT_EQ(array[1].get(), batch[0].get()); // lvalue-диапазон: указатели разделяются
+    EXPECT_NEAR(array.total_area(), array.total_square(), 1e-6);
+
+    // rvalue-диапазон перемещается в массив.
+    array.add_figures(std::move(batch));
+    EXPECT_EQ(array.get_size(), 201u);
+    EXPECT_EQ(batch[0], nullptr);
+
+    std::vector<std::unique_ptr<Rhombus<double>>> owned;
+    owned.push_back(std::make_unique<Rhombus<double>>(
+        Point<double>(0.0, 1.0), Point<double>(-1.0, 0.0), Point<double>(0.0, -1.0), Point<double>(1.0, 0.0)));
+    ArrayOfFigures<Rhombus<double>, UniqueOwnership> unique_array;
+    unique_array.reserve(16);
+    EXPECT_EQ(unique_array.get_capacity(), 16u);
+    unique_array.add_figures(std::move(owned));
+    EXPECT_EQ(unique_array.get_size(), 1u);
+    EXPECT_EQ(unique_array.get_capacity(), 16u);
+}
+
+// =========================
+// ЧАСТЬ 12: Аффинные преобразования всех фигур
+// =========================
+
+TEST(ArrayOfFiguresTest, TransformAllUpdatesAggregatesAnalytically) {
+    auto array = mixed_figures(2000);
+    array.set_thread_pool(std::make_shared<ThreadPool>(4));
+    array.add_figure(nullptr);
+    auto before = array.aggregates();
+
+    const auto matrix = Affine2D::rotation(0.5, 1.0, 2.0) * Affine2D::scaling(1.5);
+    array.transform_all(matrix);
+
+    // Аналитически обновлённые агрегаты совпадают с полным пересчётом.
+    auto analytic = array.aggregates();
+    EXPECT_NEAR(analytic.get_total_area(), 2.25 * before.get_total_area(), 1e-9 * analytic.get_total_area());
+    EXPECT_NEAR(analytic.get_total_perimeter(), 1.5 * before.get_total_perimeter(), 1e-9 * analytic.get_total_perimeter());
+    auto box = array.bounding_box();
+    array.refresh_aggregates();
+    const auto& exact = array.aggregates();
+    EXPECT_NEAR(analytic.get_total_area(), exact.get_total_area(), 1e-9 * exact.get_total_area());
+    EXPECT_NEAR(analytic.get_total_perimeter(), exact.get_total_perimeter(), 1e-9 * exact.get_total_perimeter());
+    EXPECT_NEAR(analytic.get_mean_centroid().get_x(), exact.get_mean_centroid().get_x(), 1e-9);
+    EXPECT_NEAR(analytic.get_mean_centroid().get_y(), exact.get_mean_centroid().get_y(), 1e-9);
+    EXPECT_EQ(box, exact.get_bounding_box());
+    EXPECT_NEAR(array.total_square(), exact.get_total_area(), 1e-9 * exact.get_total_area());
+}
+
+TEST(ArrayOfFiguresTest, TransformAllAxisAlignedAndRejected) {
+    ArrayOfFigures<Figure<double>> array;
+    array.add_figure(shared_diamond(0.0, 0.0, 1.0));
+    array.add_figure(shared_diamond(4.0, 0.0, 1.0));
+
+    // Без поворота прямоугольник переносится по углам, отражение меняет местами min и max.
+    array.transform_all(Affine2D::translation(1.0, 1.0) * Affine2D::scaling(-2.0));
+    EXPECT_TRUE(array.aggregates().has_valid_bounding_box());
+    EXPECT_EQ(array.bounding_box(), (BoundingBox<double>{-9.0, -1.0, 3.0, 3.0}));
+    EXPECT_NEAR(array.total_area(), 16.0, EPS);
+
+    // Ячейка, изменённая через operator[] до преобразования, учитывается.
+    array[0] = shared_diamond(0.0, 0.0, 2.0);
+    array.transform_all(Affine2D::translation(0.0, 5.0));
+    EXPECT_NEAR(array.total_area(), 16.0, EPS);
+    EXPECT_NEAR(array.aggregates().get_mean_centroid().get_y(), 5.5, EPS);
+
+    // Неподобное преобразование отклоняется до изменения фигур.
+    EXPECT_THROW(array.transform_all(Affine2D{1.0, 0.5, 0.0, 1.0, 0.0, 0.0}), std::invalid_argument);
+    EXPECT_NEAR(array[1]->geometric_center()->get_x(), -7.0, EPS);
+
+    // Целочисленные координаты округляются, поэтому агрегаты пересчитываются полностью.
+    ArrayOfFigures<Figure<int>> ints;
+    ints.add_figure(std::make_shared<Rhombus<int>>(Point<int>(0, 1), Point<int>(-1, 0), Point<int>(0, -1), Point<int>(1, 0)));
+    ints.transform_all(Affine2D::translation(2.0, 3.0) * Affine2D::scaling(3.0));
+    EXPECT_NEAR(ints.total_area(), 18.0, EPS);
+    EXPECT_EQ(ints.bounding_box(), (BoundingBox<double>{-1.0, 0.0, 5.0, 6.0}));
+}
+
+TEST(ArrayOfFiguresTest, TransformAllTransformsSharedFigureOnce) {
+    ArrayOfFigures<Figure<double>> array;
+    for (int i = 0; i < 3; ++i) {
+        array.add_figure(shared_diamond(0.0, 0.0, 1.0));
+    }
+    auto same = shared_diamond(5.0, 0.0, 1.0);
+    array.add_figure(same);
+    array.add_figure(same);
+    EXPECT_EQ(array.share_duplicates(), 2u);
+
+    array.transform_all(Affine2D::translation(10.0, 0.0));
+    EXPECT_NEAR(array[0]->geometric_center()->get_x(), 10.0, EPS);
+    EXPECT_NEAR(array[3]->geometric_center()->get_x(), 15.0, EPS);
+    EXPECT_NEAR(array.aggregates().get_mean_centroid().get_x(), 12.0, EPS);
+    auto box = array.bounding_box();
+    array.refresh_aggregates();
+    EXPECT_EQ(box, array.aggregates().get_bounding_box());
+    EXPECT_NEAR(array.aggregates().get_mean_centroid().get_x(), 12.0, EPS);
+}
+
+// =========================
+// ЧАСТЬ 13: Упорядочивание фигур вдоль кривых, заполняющих плоскость
+// =========================
+
+TEST(ArrayOfFiguresTest, ReorderSpatiallyGroupsNeighbours) {
+    // Фигуры в узлах сетки 32 x 32, добавленные в перемешанном порядке, и пустая ячейка.
+    std::vector<std::shared_ptr<Rhombus<double>>> grid;
+    for (int y = 0; y < 32; ++y) {
+        for (int x = 0; x < 32; ++x) {
+            grid.push_back(shared_diamond(10.0 * x, 10.0 * y, 1.0 + (x + y) % 3));
+        }
+    }
+    std::mt19937 rng(7);
+    std::shuffle(grid.begin(), grid.end(), rng);
+
+    for (auto curve : {SpaceFillingCurve::Morton, SpaceFillingCurve::Hilbert}) {
+        ArrayOfFigures<Figure<double>> array;
+        array.set_thread_pool(std::make_shared<ThreadPool>(4));
+        array.add_figure(nullptr);
+        array.add_figures(grid);
+        auto before = array.aggregates();
+        auto* first = array[1].get();
+
+        array.reorder_spatially(curve);
+        ASSERT_EQ(array.get_size(), grid.size() + 1);
+        EXPECT_EQ(array[grid.size()], nullptr);
+        EXPECT_TRUE(std::ranges::any_of(array, [first](const auto& f) { return f.get() == first; }));
+
+        // Первая четверть кривой - ровно фигуры левого нижнего квадранта.
+        for (size_t i = 0; i < grid.size() / 4; ++i) {
+            auto center = array[i]->geometric_center();
+            EXPECT_LT(center->get_x(), 160.0);
+            EXPECT_LT(center->get_y(), 160.0);
+        }
+        // Для кривой Гильберта соседние фигуры в массиве - соседи по сетке.
+        if (curve == SpaceFillingCurve::Hilbert) {
+            for (size_t i = 1; i < grid.size(); ++i) {
+                auto a = array[i - 1]->geometric_center();
+                auto b = array[i]->geometric_center();
+                EXPECT_NEAR(std::fabs(a->get_x() - b->get_x()) + std::fabs(a->get_y() - b->get_y()), 10.0, EPS);
+            }
+        }
+
+        // Перестановка не меняет агрегаты.
+        EXPECT_EQ(array.aggregates().get_count(), before.get_count());
+        EXPECT_NEAR(array.total_area(), before.get_total_area(), EPS);
+        EXPECT_EQ(array.bounding_box(), before.get_bounding_box());
+    }
+}
+
+// =========================
+// ЧАСТЬ 14: Удаление дубликатов и разделение памяти между совпадающими фигурами
+// =========================
+
+TEST(ArrayOfFiguresTest, DeduplicateIdenticalAndCongruent) {
+    ArrayOfFigures<Figure<double>> array;
+    array.set_thread_pool(std::make_shared<ThreadPool>(4));
+    for (int copy = 0; copy < 3; ++copy) {
+        for (int i = 0; i < 400; ++i) {
+            array.add_figure(shared_diamond(10.0 * i, 0.0, 1.0 + i % 4));
+        }
+    }
+    array.add_figure(nullptr);
+    array.add_figure(std::make_shared<Pentagon<double>>(Pentagon<double>::regular(Point<double>(0.0, 0.0), 1.0)));
+    auto* first = array[0].get();
+
+    // Совпадающие фигуры: остаются первые 400 ромбов, пустая ячейка и пятиугольник.
+    EXPECT_EQ(array.deduplicate(), 800u);
+    ASSERT_EQ(array.get_size(), 402u);
+    EXPECT_EQ(array[0].get(), first);
+    EXPECT_NEAR(array[399]->geometric_center()->get_x(), 3990.0, EPS);
+    EXPECT_EQ(array[400], nullptr);
+    EXPECT_EQ(array.aggregates().get_count(), 401u);
+    EXPECT_NEAR(array.total_area(), array.total_square(), 1e-6);
+
+    // Конгруэнтные фигуры: ромбы четырёх размеров и пятиугольник.
+    EXPECT_EQ(array.deduplicate(DeduplicationMode::Congruent), 396u);
+    EXPECT_EQ(array.get_size(), 6u);
+    EXPECT_EQ(array.aggregates().get_count(FigureKind::Rhombus), 4u);
+    EXPECT_NEAR(array.total_area(), array.total_square(), 1e-6);
+    EXPECT_EQ(array.bounding_box(), (BoundingBox<double>{-1.0, -4.0, 34.0, 4.0}));
+}
+
+TEST(ArrayOfFiguresTest, ShareDuplicatesKeepsSlots) {
+    ArrayOfFigures<Figure<double>> array;
+    for (int copy = 0; copy < 3; ++copy) {
+        for (int i = 0; i < 10; ++i) {
+            array.add_figure(shared_diamond(10.0 * i, 0.0, 1.0));
+        }
+    }
+    double area = array.total_area();
+    EXPECT_EQ(array.share_duplicates(), 20u);
+    EXPECT_EQ(array.get_size(), 30u);
+    EXPECT_EQ(array[25].get(), array[5].get());
+    EXPECT_NE(array[6].get(), array[5].get());
+    EXPECT_EQ(array[5].use_count(), 3);
+    EXPECT_NEAR(array.total_area(), area, EPS);
+    // Повторный вызов ничего не меняет.
+    EXPECT_EQ(array.share_duplicates(), 0u);
+}
+
+// =========================
+// ЧАСТЬ 15: Покрытая площадь (площадь объединения фигур)
+// =========================
+
+TEST(ArrayOfFiguresTest, CoveredAreaCountsOverlapsOnce) {
+    ArrayOfFigures<Figure<double>> array;
+    array.set_thread_pool(std::make_shared<ThreadPool>(4));
+    EXPECT_NEAR(array.covered_area(), 0.0, EPS);
+
+    // Два ромба с диагоналями 4, центры сдвинуты на 2 по X: перекрытие - ромб с диагоналями 2.
+    array.add_figure(shared_diamond(0.0, 0.0, 2.0));
+    array.add_figure(shared_diamond(2.0, 0.0, 2.0));
+    array.add_figure(nullptr);
+    EXPECT_NEAR(array.total_square(), 16.0, EPS);
+    EXPECT_NEAR(array.covered_area(), 14.0, EPS);
+
+    // Правильный шестиугольник внутри ромба не меняет покрытую площадь.
+    array.add_figure(std::make_shared<Hexagon<double>>(Hexagon<double>::regular(Point<double>(0.0, 0.0), 0.5)));
+    EXPECT_NEAR(array.covered_area(), 14.0, EPS);
+
+    // Много фигур: параллельный и последовательный результаты совпадают, непересекающиеся фигуры - сумма площадей.
+    ArrayOfFigures<Figure<double>> grid;
+    for (int i = 0; i < 3000; ++i) {
+        grid.add_figure(shared_diamond(3.0 * (i % 100), 3.0 * (i / 100), 1.0));
+    }
+    EXPECT_NEAR(grid.parallel_covered_area(), grid.total_square(), 1e-6);
+    array.add_figures(grid);
+    EXPECT_NEAR(array.parallel_covered_area(), array.covered_area(), 1e-6);
+}
+
+// =========================
+// ЧАСТЬ 16: Выпуклая оболочка вершин всех фигур
+// =========================
+
+TEST(ArrayOfFiguresTest, ConvexHullOfAllVertices) {
+    ArrayOfFigures<Figure<double>> array;
+    array.set_thread_pool(std::make_shared<ThreadPool>(4));
+    EXPECT_TRUE(array.convex_hull().empty());
+
+    array.add_figure(shared_diamond(0.0, 0.0, 1.0));
+    array.add_figure(nullptr);
+    array.add_figure(shared_diamond(4.0, 0.0, 1.0));
+    // Два ромба с центрами (0, 0) и (4, 0): внутренние вершины (1, 0) и (3, 0) в оболочку не входят.
+    std::vector<Point<double>> expected = {{-1.0, 0.0}, {0.0, -1.0}, {4.0, -1.0}, {5.0, 0.0}, {4.0, 1.0}, {0.0, 1.0}};
+    EXPECT_EQ(array.convex_hull(), expected);
+
+    // Много фигур: результат совпадает с оболочкой всех вершин, собранных последовательно.
+    auto grid = mixed_figures(5000);
+    array.add_figures(grid);
+    std::vector<Point<double>> vertices;
+    for (const auto& figure : array) {
+        if (figure) {
+            auto span = figure->vertices();
+            vertices.insert(vertices.end(), span.begin(), span.end());
+        }
+    }
+    EXPECT_EQ(array.convex_hull(), monotone_chain(vertices));
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "../include/clipping.h"
+#include "../include/arrayoffigures.h"
+#include "../include/rhombus.h"
+#include "../include/hexagon.h"
+#include "testfigures.h"
+
+static constexpr double EPS = 1e-9;
+
+static double area(std::span<const Point<double>> polygon) {
+    double doubled = 0.0;
+    for (std::size_t i = 0; i < polygon.size(); ++i) {
+        doubled += cross(polygon[i], polygon[(i + 1) % polygon.size()]);
+    }
+    return std::fabs(doubled) / 2.0;
+}
+
+// Тест: классификация по ограничивающему прямоугольнику
+TEST(ClippingTest, Classify) {
+    auto view = window(0, 0, 10, 10);
+    EXPECT_EQ(classify(window(1, 1, 2, 2), view), ClipClass::Inside);
+    EXPECT_EQ(classify(window(0, 0, 10, 10), view), ClipClass::Inside);
+    EXPECT_EQ(classify(window(11, 1, 12, 2), view), ClipClass::Outside);
+    EXPECT_EQ(classify(window(-1, 1, 2, 2), view), ClipClass::Boundary);
+    EXPECT_EQ(classify(BoundingBox<double>{}, view), ClipClass::Outside);
+}
+
+// Тест: отсечение многоугольников окном
+TEST(ClippingTest, SutherlandHodgman) {
+    std::vector<Point<double>> current;
+    std::vector<Point<double>> next;
+
+    // Ромб с диагоналями 4, центр в углу окна: остаётся четверть.
+    std::vector<Point<double>> rhombus = {{0, 2}, {-2, 0}, {0, -2}, {2, 0}};
+    sutherland_hodgman(std::span<const Point<double>>(rhombus), window(0, 0, 10, 10), current, next);
+    EXPECT_NEAR(area(current), 2.0, EPS);
+    for (const auto& p : current) {
+        EXPECT_TRUE(window(0, 0, 10, 10).contains(p.get_x(), p.get_y()));
+    }
+
+    // Окно внутри ромба: результат - само окно.
+    sutherland_hodgman(std::span<const Point<double>>(rhombus), window(-0.5, -0.5, 0.5, 0.5), current, next);
+    EXPECT_EQ(current.size(), 4u);
+    EXPECT_NEAR(area(current), 1.0, EPS);
+
+    // Срезанные углы: восьмиугольник.
+    sutherland_hodgman(std::span<const Point<double>>(rhombus), window(-1.5, -1.5, 1.5, 1.5), current, next);
+    EXPECT_EQ(current.size(), 8u);
+    EXPECT_NEAR(area(current), 8.0 - 4.0 * 0.25, EPS);
+
+    // Многоугольник снаружи: пусто.
+    sutherland_hodgman(std::span<const Point<double>>(rhombus), window(5, 5, 6, 6), current, next);
+    EXPECT_TRUE(current.empty());
+
+    // Целочисленные координаты.
+    std::vector<Point<int>> square = {{0, 0}, {4, 0}, {4, 4}, {0, 4}};
+    sutherland_hodgman(std::span<const Point<int>>(square), window(2, 1, 10, 3), current, next);
+    EXPECT_NEAR(area(current), 4.0, EPS);
+}
+
+// Тест: отсечение коллекции фигур
+TEST(ClippingTest, ArrayClip) {
+    ArrayOfFigures<Figure<double>> array;
+    array.set_thread_pool(std::make_shared<ThreadPool>(4));
+    array.add_figure(shared_diamond(5, 5, 1));    // внутри
+    array.add_figure(nullptr);
+    array.add_figure(shared_diamond(0, 5, 2));    // на границе: остаётся половина
+    array.add_figure(shared_diamond(20, 20, 1));  // снаружи
+    array.add_figure(shared_diamond(-1, 5, 1));   // касается окна вершиной: ничего не остаётся
+    array.add_figure(std::make_shared<Hexagon<double>>(Hexagon<double>::regular(Point<double>(10.0, 10.0), 1.0)));
+
+    auto clipped = array.clip(window(0, 0, 10, 10));
+    ASSERT_EQ(clipped.size(), 3u);
+    EXPECT_EQ(clipped.source(0), 0u);
+    EXPECT_EQ(clipped.source(1), 2u);
+    EXPECT_EQ(clipped.source(2), 5u);
+    EXPECT_NEAR(area(clipped.contour(0)), 2.0, EPS);
+    EXPECT_NEAR(area(clipped.contour(1)), 4.0, EPS);
+    EXPECT_NEAR(area(clipped.contour(2)), array[5]->square() / 4.0, 1e-6);
+    EXPECT_EQ(clipped.vertices().size(), clipped.contour(0).size() + clipped.contour(1).size() + clipped.contour(2).size());
+
+    EXPECT_THROW(array.clip(BoundingBox<double>{}), std::invalid_argument);
+}
+
+// Тест: результат не зависит от количества потоков и совпадает с поштучным отсечением
+TEST(ClippingTest, ParallelMatchesSequential) {
+    ArrayOfFigures<Figure<double>> array;
+    for (int i = 0; i < 5000; ++i) {
+        array.add_figure(shared_diamond(0.25 * (i % 100), 0.25 * (i / 100), 0.25 * (1 + i % 3)));
+    }
+    const auto view = window(3.1, 2.2, 17.9, 9.7);
+    std::vector<Point<double>> current;
+    std::vector<Point<double>> next;
+    ClippedPolygons expected;
+    for (std::size_t i = 0; i < array.get_size(); ++i) {
+        sutherland_hodgman(array[i]->vertices(), view, current, next);
+        expected.add(std::span<const Point<double>>(current), i);
+    }
+    for (std::size_t threads : {1u, 3u, 8u}) {
+        array.set_thread_pool(std::make_shared<ThreadPool>(threads));
+        auto clipped = array.clip(view);
+        ASSERT_EQ(clipped.size(), expected.size());
+        for (std::size_t k = 0; k < clipped.size(); ++k) {
+            EXPECT_EQ(clipped.source(k), expected.source(k));
+            ASSERT_EQ(clipped.contour(k).size(), expected.contour(k).size());
+            EXPECT_NEAR(area(clipped.contour(k)), area(expected.contour(k)), EPS);
+        }
+    }
+}
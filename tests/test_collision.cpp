@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <span>
+#include <vector>
+#include "../include/collision.h"
+#include "../include/arrayoffigures.h"
+#include "../include/rhombus.h"
+#include "../include/pentagon.h"
+#include "../include/hexagon.h"
+#include "testfigures.h"
+
+static bool intersect(std::span<const Point<double>> a, std::span<const Point<double>> b) {
+    return convex_polygons_intersect(a, b);
+}
+
+static bool intersect(const Rhombus<double>& a, const Rhombus<double>& b) {
+    return intersect(a.vertices(), b.vertices());
+}
+
+// Тест: узкая фаза по разделяющей оси
+TEST(CollisionTest, SeparatingAxis) {
+    EXPECT_TRUE(intersect(diamond(0, 0, 1), diamond(1, 0, 1)));
+    // Вложенный
+    EXPECT_TRUE(intersect(diamond(0, 0, 3), diamond(0.5, 0, 1)));
+    // Касание вершиной
+    EXPECT_TRUE(intersect(diamond(0, 0, 1), diamond(2, 0, 1)));
+    // Прямоугольники пересекаются, ромбы - нет (разделяет сторона)
+    EXPECT_FALSE(intersect(diamond(0, 0, 1), diamond(1.5, 1.5, 1)));
+    EXPECT_FALSE(intersect(diamond(0, 0, 1), diamond(5, 0, 1)));
+    // Обход по часовой стрелке
+    auto shifted = diamond(1.5, 1.5, 1);
+    std::vector<Point<double>> clockwise(shifted.vertices().rbegin(), shifted.vertices().rend());
+    EXPECT_FALSE(intersect(diamond(0, 0, 1).vertices(), clockwise));
+    EXPECT_TRUE(intersect(diamond(1, 1, 1).vertices(), clockwise));
+}
+
+// Тест: заметание совпадает с полным перебором пар, параллельный вариант - с последовательным
+TEST(CollisionTest, SweepMatchesBruteForce) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> position(0.0, 60.0);
+    std::uniform_real_distribution<double> radius(0.2, 2.0);
+    ArrayOfFigures<Figure<double>> array;
+    array.set_thread_pool(std::make_shared<ThreadPool>(4));
+    for (int i = 0; i < 3000; ++i) {
+        Point<double> center(position(rng), position(rng));
+        switch (i % 3) {
+            case 0: {
+                // Координаты кратны 0.25, чтобы проверка равенства сторон ромба была точной.
+                array.add_figure(shared_diamond(std::round(center.get_x() * 4) / 4, std::round(center.get_y() * 4) / 4, 0.25 * (1 + rng() % 8)));
+                break;
+            }
+            case 1:
+                array.add_figure(std::make_shared<Pentagon<double>>(Pentagon<double>::regular(center, radius(rng), 0.3 * i)));
+                break;
+            default:
+                array.add_figure(std::make_shared<Hexagon<double>>(Hexagon<double>::regular(center, radius(rng), 0.1 * i)));
+                break;
+        }
+        if (i % 500 == 0) {
+            array.add_figure(nullptr);
+        }
+    }
+
+    std::vector<CollisionPair> expected;
+    for (size_t i = 0; i < array.get_size(); ++i) {
+        for (size_t j = i + 1; j < array.get_size(); ++j) {
+            if (array[i] && array[j] && convex_polygons_intersect(array[i]->vertices(), array[j]->vertices())) {
+                expected.push_back(CollisionPair{i, j});
+            }
+        }
+    }
+    ASSERT_GT(expected.size(), 100u);
+
+    auto pairs = array.find_collisions();
+    auto parallel = array.parallel_find_collisions();
+    EXPECT_EQ(parallel, pairs);
+    auto by_index = [](const CollisionPair& a, const CollisionPair& b) {
+        return a.first < b.first || (a.first == b.first && a.second < b.second);
+    };
+    std::sort(pairs.begin(), pairs.end(), by_index);
+    EXPECT_EQ(pairs, expected);
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "../include/compressedfigures.h"
+#include "../include/rhombus.h"
+#include "../include/pentagon.h"
+#include "../include/hexagon.h"
+#include "testfigures.h"
+
+static constexpr double EPS = 1e-6;
+
+// Тест: распаковка восстанавливает все фигуры с точностью до шага квантования
+TEST(CompressedFiguresTest, RoundTripKeepsFigures) {
+    auto figures = mixed_figures(1000);
+    auto compressed = CompressedFigures<double>::compress(figures);
+    EXPECT_EQ(compressed.size(), 1000u);
+    EXPECT_EQ(compressed.block_count(), (1000 + CompressedFigures<double>::BLOCK_SIZE - 1) / CompressedFigures<double>::BLOCK_SIZE);
+
+    std::vector<FigureRejection> rejected;
+    auto restored = compressed.decompress(rejected);
+    EXPECT_TRUE(rejected.empty());
+    ASSERT_EQ(restored.get_size(), figures.get_size());
+    for (std::size_t i = 0; i < figures.get_size(); ++i) {
+        ASSERT_EQ(restored[i]->vertex_count(), figures[i]->vertex_count());
+        for (std::size_t v = 0; v < figures[i]->vertex_count(); ++v) {
+            EXPECT_NEAR(restored[i]->vertex(v).get_x(), figures[i]->vertex(v).get_x(), compressed.quantum());
+            EXPECT_NEAR(restored[i]->vertex(v).get_y(), figures[i]->vertex(v).get_y(), compressed.quantum());
+        }
+    }
+    EXPECT_NEAR(restored.total_square(), figures.total_square(), 1e-4);
+}
+
+// Тест: сжатое представление меньше записей фиксированного размера
+TEST(CompressedFiguresTest, SmallerThanRecords) {
+    auto figures = mixed_figures(3000);
+    auto compressed = CompressedFigures<double>::compress(figures);
+    EXPECT_LT(compressed.byte_size(), figures.get_size() * sizeof(FigureRecord<double>) / 2);
+
+    // Целочисленные координаты: малые приращения занимают по одному байту.
+    ArrayOfFigures<Figure<int>> integers;
+    for (int i = 0; i < 512; ++i) {
+        integers.emplace_figure<Rhombus<int>>(Point<int>(i, 2), Point<int>(i - 1, 0), Point<int>(i, -2), Point<int>(i + 1, 0));
+    }
+    auto packed = CompressedFigures<int>::compress(integers);
+    EXPECT_LT(packed.byte_size(), 512u * 10u);
+}
+
+// Тест: доступ к отдельной фигуре и блоку совпадает с полной распаковкой
+TEST(CompressedFiguresTest, RandomAccessMatchesBlocks) {
+    constexpr std::size_t B = CompressedFigures<double>::BLOCK_SIZE;
+    const std::size_t n = 2 * B + B / 2;
+    auto figures = mixed_figures(n);
+    auto compressed = CompressedFigures<double>::compress(figures);
+    std::vector<FigureRecord<double>> block(B);
+    EXPECT_EQ(compressed.decode_block(2, block), B / 2);
+    for (std::size_t index : {std::size_t{0}, B - 1, B, 2 * B - 1, 2 * B, 2 * B + 7, n - 1}) {
+        FigureRecord<double> single = compressed.record(index);
+        EXPECT_EQ(single.vertex_count, figures[index]->vertex_count());
+        EXPECT_NEAR(compressed.figure(index)->square(), figures[index]->square(), EPS);
+        if (index >= 2 * B) {
+            const FigureRecord<double>& from_block = block[index - 2 * B];
+            EXPECT_EQ(from_block.vertex_count, single.vertex_count);
+            for (std::size_t v = 0; v < single.vertex_count; ++v) {
+                EXPECT_EQ(from_block.vertices[v], single.vertices[v]);
+            }
+        }
+    }
+    EXPECT_THROW(compressed.record(n), std::out_of_range);
+    EXPECT_THROW(compressed.decode_block(3, block), std::out_of_range);
+    std::vector<FigureRecord<double>> small(B - 1);
+    EXPECT_THROW(compressed.decode_block(0, small), std::invalid_argument);
+}
+
+// Тест: целочисленные координаты сжимаются без потерь во всём диапазоне типа
+TEST(CompressedFiguresTest, IntegralCoordinatesAreLossless) {
+    const std::int64_t big = std::numeric_limits<std::int64_t>::max() / 4;
+    ArrayOfFigures<Figure<std::int64_t>> figures;
+    figures.emplace_figure<Rhombus<std::int64_t>>(Point<std::int64_t>(0, big), Point<std::int64_t>(-big, 0),
+                                                  Point<std::int64_t>(0, -big), Point<std::int64_t>(big, 0));
+    figures.emplace_figure<Rhombus<std::int64_t>>(Point<std::int64_t>(-big, 1), Point<std::int64_t>(-big - 1, 0),
+                                                  Point<std::int64_t>(-big, -1), Point<std::int64_t>(-big + 1, 0));
+    auto compressed = CompressedFigures<std::int64_t>::compress(figures);
+    for (std::size_t i = 0; i < figures.get_size(); ++i) {
+        FigureRecord<std::int64_t> record = compressed.record(i);
+        for (std::size_t v = 0; v < 4; ++v) {
+            EXPECT_EQ(record.vertices[v], figures[i]->vertex(v));
+        }
+    }
+    EXPECT_THROW(CompressedFigures<std::int64_t>::compress(figures, 2.0), std::invalid_argument);
+}
+
+// Тест: пустые ячейки сохраняются, отвергнутые после квантования записи сообщаются
+TEST(CompressedFiguresTest, EmptySlotsAndRejections) {
+    ArrayOfFigures<Figure<double>> figures;
+    figures.emplace_figure<Rhombus<double>>(Point<double>(0.0, 1.0), Point<double>(-1.0, 0.0), Point<double>(0.0, -1.0), Point<double>(1.0, 0.0));
+    figures.add_figure(nullptr);
+    figures.emplace_figure<Pentagon<double>>(Pentagon<double>::regular(Point<double>(5.0, 5.0), 1.0));
+    figures.emplace_figure<Rhombus<double>>(Point<double>(7.0, 9.0), Point<double>(5.0, 8.0), Point<double>(7.0, 7.0), Point<double>(9.0, 8.0));
+
+    // Грубый шаг: правильный пятиугольник перестаёт проходить проверку, ромб в целых координатах остаётся точным.
+    auto coarse = CompressedFigures<double>::compress(figures, 0.5);
+    std::vector<FigureRejection> rejected;
+    auto restored = coarse.decompress(rejected);
+    ASSERT_EQ(rejected.size(), 1u);
+    EXPECT_EQ(rejected[0].index, 2u);
+    EXPECT_EQ(rejected[0].error, ValidationError::PentagonUnequalSides);
+    // Номера сохраняются: на месте отвергнутой записи - пустая ячейка, следующая фигура не сдвигается.
+    ASSERT_EQ(restored.get_size(), 4u);
+    EXPECT_NEAR(restored[0]->square(), 2.0, EPS);
+    EXPECT_EQ(restored[1], nullptr);
+    EXPECT_EQ(restored[2], nullptr);
+    EXPECT_NEAR(restored[3]->square(), 4.0, EPS);
+    EXPECT_EQ(restored[3]->vertex(0), coarse.record(3).vertices[0]);
+    EXPECT_EQ(coarse.figure(1), nullptr);
+    EXPECT_THROW(coarse.figure(2), FigureValidationError);
+}
+
+// Тест: некорректный шаг и координаты вне квантуемого диапазона
+TEST(CompressedFiguresTest, RejectsInvalidParameters) {
+    ArrayOfFigures<Figure<double>> figures;
+    figures.emplace_figure<Rhombus<double>>(Point<double>(0.0, 1e300), Point<double>(-1e300, 0.0), Point<double>(0.0, -1e300), Point<double>(1e300, 0.0));
+    EXPECT_THROW(CompressedFigures<double>::compress(figures), std::invalid_argument);
+    EXPECT_THROW(CompressedFigures<double>::compress(figures, 0.0), std::invalid_argument);
+    EXPECT_THROW(CompressedFigures<double>::compress(figures, -1.0), std::invalid_argument);
+
+    ArrayOfFigures<Figure<double>> empty;
+    auto compressed = CompressedFigures<double>::compress(empty);
+    EXPECT_EQ(compressed.size(), 0u);
+    EXPECT_EQ(compressed.block_count(), 0u);
+    std::vector<FigureRejection> rejected;
+    EXPECT_EQ(compressed.decompress(rejected).get_size(), 0u);
+}
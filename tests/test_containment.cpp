@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "../include/containment.h"
+#include "../include/arrayoffigures.h"
+#include "../include/rhombus.h"
+#include "../include/pentagon.h"
+#include "../include/hexagon.h"
+#include "testfigures.h"
+
+// Эталон: точка внутри выпуклого многоугольника (или на границе) по знакам векторных произведений.
+static bool reference_contains(std::span<const Point<double>> polygon, const Point<double>& p) {
+    bool positive = true;
+    bool negative = true;
+    for (std::size_t i = 0; i < polygon.size(); ++i) {
+        double side = cross(polygon[(i + 1) % polygon.size()] - polygon[i], p - polygon[i]);
+        positive &= side >= 0.0;
+        negative &= side <= 0.0;
+    }
+    return positive || negative;
+}
+
+// Тест: ромб, граница и обход по часовой стрелке
+TEST(ContainmentTest, RhombusBoundaryAndOrientation) {
+    Rhombus<double> rhombus(Point<double>(0, 2), Point<double>(-2, 0), Point<double>(0, -2), Point<double>(2, 0));
+    std::vector<Point<double>> points = {{0, 0}, {1, 1}, {2, 0}, {1.5, 1.0}, {3, 0}, {-1, -1}, {-1.5, -1.0}};
+    std::vector<std::uint8_t> out(points.size(), 7);
+    rhombus.contains_batch(points, out);
+    EXPECT_EQ(out, (std::vector<std::uint8_t>{1, 1, 1, 0, 0, 1, 0}));
+
+    // Тот же ромб, обход в обратном направлении.
+    std::vector<Point<double>> reversed = {{2, 0}, {0, -2}, {-2, 0}, {0, 2}};
+    std::vector<std::uint8_t> again(points.size(), 7);
+    contains_convex(std::span<const Point<double>>(reversed), std::span<const Point<double>>(points), std::span<std::uint8_t>(again));
+    EXPECT_EQ(again, out);
+
+    std::vector<std::uint8_t> wrong(points.size() - 1);
+    EXPECT_THROW(rhombus.contains_batch(points, wrong), std::invalid_argument);
+}
+
+// Тест: ядра для пятиугольника и шестиугольника совпадают с эталоном
+TEST(ContainmentTest, PentagonAndHexagonMatchReference) {
+    auto points = random_points(20000, -3.0, 3.0, 5);
+    std::vector<std::uint8_t> out(points.size());
+    Pentagon<double> pentagon = Pentagon<double>::regular(Point<double>(0.5, -0.25), 2.0);
+    Hexagon<double> hexagon = Hexagon<double>::regular(Point<double>(-0.5, 0.25), 2.5);
+    for (const Figure<double>* figure : {static_cast<const Figure<double>*>(&pentagon), static_cast<const Figure<double>*>(&hexagon)}) {
+        figure->contains_batch(points, out);
+        std::size_t inside = 0;
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            ASSERT_EQ(out[i] != 0, reference_contains(figure->vertices(), points[i])) << i;
+            inside += out[i];
+        }
+        EXPECT_NEAR(static_cast<double>(inside) / points.size() * 36.0, figure->square(), 0.5);
+    }
+}
+
+// Тест: целочисленные координаты, многоугольники с другим числом вершин и вырожденные
+TEST(ContainmentTest, GenericPolygons) {
+    std::vector<Point<int>> triangle = {{0, 0}, {4, 0}, {0, 4}};
+    std::vector<Point<int>> points = {{1, 1}, {2, 2}, {3, 2}, {0, 4}, {-1, 0}};
+    std::vector<std::uint8_t> out(points.size());
+    contains_convex(std::span<const Point<int>>(triangle), std::span<const Point<int>>(points), std::span<std::uint8_t>(out));
+    EXPECT_EQ(out, (std::vector<std::uint8_t>{1, 1, 0, 1, 0}));
+
+    std::vector<Point<int>> segment = {{0, 0}, {2, 2}, {4, 4}};
+    contains_convex(std::span<const Point<int>>(segment), std::span<const Point<int>>(points), std::span<std::uint8_t>(out));
+    EXPECT_EQ(out, (std::vector<std::uint8_t>{0, 0, 0, 0, 0}));
+
+    std::vector<Point<int>> nonagon(9, Point<int>(0, 0));
+    EXPECT_THROW(contains_convex(std::span<const Point<int>>(nonagon), std::span<const Point<int>>(points), std::span<std::uint8_t>(out)),
+                 std::invalid_argument);
+}
+
+// Тест: проверка по коллекции совпадает с перебором всех фигур
+TEST(ContainmentTest, ArrayContainsBatch) {
+    ArrayOfFigures<Figure<double>> array;
+    std::vector<std::uint8_t> out(3, 7);
+    std::vector<Point<double>> few = {{0, 0}, {1, 1}, {2, 2}};
+    array.contains_batch(std::span<const Point<double>>(few), std::span<std::uint8_t>(out));
+    EXPECT_EQ(out, (std::vector<std::uint8_t>{0, 0, 0}));
+
+    for (int i = 0; i < 400; ++i) {
+        double cx = 0.25 * (i % 20) * 4.0;
+        double cy = 0.25 * (i / 20) * 4.0;
+        switch (i % 3) {
+            case 0:
+                array.add_figure(std::make_shared<Rhombus<double>>(Point<double>(cx, cy + 1), Point<double>(cx - 1, cy),
+                                                                   Point<double>(cx, cy - 1), Point<double>(cx + 1, cy)));
+                break;
+            case 1:
+                array.add_figure(std::make_shared<Pentagon<double>>(Pentagon<double>::regular(Point<double>(cx, cy), 0.75)));
+                break;
+            default:
+                array.add_figure(std::make_shared<Hexagon<double>>(Hexagon<double>::regular(Point<double>(cx, cy), 0.5)));
+                break;
+        }
+    }
+    array.add_figure(nullptr);
+    auto points = random_points(50000, -2.0, 22.0, 9);
+    std::vector<std::uint8_t> expected(points.size(), 0);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        for (const auto& figure : array) {
+            if (figure && reference_contains(figure->vertices(), points[i])) {
+                expected[i] = 1;
+                break;
+            }
+        }
+    }
+    for (std::size_t threads : {1u, 4u}) {
+        array.set_thread_pool(std::make_shared<ThreadPool>(threads));
+        std::vector<std::uint8_t> result(points.size(), 7);
+        array.contains_batch(std::span<const Point<double>>(points), std::span<std::uint8_t>(result));
+        EXPECT_EQ(result, expected);
+    }
+    EXPECT_THROW(array.contains_batch(std::span<const Point<double>>(points), std::span<std::uint8_t>(out)), std::invalid_argument);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <span>
+#include <vector>
+#include "../include/convexhull.h"
+#include "../include/threadpool.h"
+#include "testfigures.h"
+
+// Проверка оболочки: вершины обходятся строго против часовой стрелки и все точки лежат внутри или на границе.
+static void expect_hull_of(const std::vector<Point<double>>& hull, const std::vector<Point<double>>& points) {
+    const std::size_t m = hull.size();
+    ASSERT_GE(m, 3u);
+    for (std::size_t i = 0; i < m; ++i) {
+        const Point<double>& a = hull[i];
+        const Point<double>& b = hull[(i + 1) % m];
+        const Point<double>& c = hull[(i + 2) % m];
+        EXPECT_GT(cross(b - a, c - b), 0.0);
+        for (const auto& p : points) {
+            EXPECT_GE(cross(b - a, p - a), 0.0);
+        }
+    }
+}
+
+// Тест: квадрат с внутренними точками, точками на сторонах и повторами
+TEST(ConvexHullTest, SquareWithInteriorAndCollinearPoints) {
+    std::vector<Point<double>> points = {
+        {1.0, 1.0}, {0.0, 0.0}, {2.0, 0.0}, {0.5, 0.5}, {2.0, 2.0}, {1.0, 0.0},
+        {0.0, 2.0}, {0.0, 1.0}, {2.0, 2.0}, {1.5, 1.0}, {1.0, 2.0}};
+    std::vector<Point<double>> copy = points;
+    auto hull = monotone_chain(copy);
+    std::vector<Point<double>> expected = {{0.0, 0.0}, {2.0, 0.0}, {2.0, 2.0}, {0.0, 2.0}};
+    EXPECT_EQ(hull, expected);
+}
+
+// Тест: вырожденные наборы точек
+TEST(ConvexHullTest, DegenerateInputs) {
+    std::vector<Point<double>> empty;
+    EXPECT_TRUE(monotone_chain(empty).empty());
+
+    std::vector<Point<double>> single = {{1.0, 1.0}, {1.0, 1.0}};
+    EXPECT_EQ(monotone_chain(single), (std::vector<Point<double>>{{1.0, 1.0}}));
+
+    // Точки на одной прямой: оболочка - две крайние точки.
+    std::vector<Point<double>> line = {{2.0, 2.0}, {0.0, 0.0}, {1.0, 1.0}, {3.0, 3.0}};
+    EXPECT_EQ(monotone_chain(line), (std::vector<Point<double>>{{0.0, 0.0}, {3.0, 3.0}}));
+
+    ThreadPool pool(4);
+    EXPECT_TRUE(parallel_convex_hull(pool, std::span<const Point<double>>(), 16).empty());
+}
+
+// Тест: целочисленные координаты
+TEST(ConvexHullTest, IntegerCoordinates) {
+    std::vector<Point<int>> points = {{0, 0}, {4, 0}, {2, 1}, {4, 4}, {2, 4}, {0, 4}, {1, 2}};
+    auto hull = monotone_chain(points);
+    EXPECT_EQ(hull, (std::vector<Point<int>>{{0, 0}, {4, 0}, {4, 4}, {0, 4}}));
+}
+
+// Тест: параллельная оболочка случайных точек совпадает с последовательной при любом количестве потоков
+TEST(ConvexHullTest, ParallelMatchesSequential) {
+    auto points = random_points(20000, -100.0, 100.0, 7);
+    std::vector<Point<double>> copy = points;
+    const auto expected = monotone_chain(copy);
+    expect_hull_of(expected, points);
+
+    for (std::size_t threads : {1u, 2u, 8u}) {
+        ThreadPool pool(threads);
+        for (std::size_t grain : {7u, 1000u, 50000u}) {
+            EXPECT_EQ(parallel_convex_hull(pool, std::span<const Point<double>>(points), grain), expected);
+        }
+    }
+}
+
+// Тест: точки на окружности - все являются вершинами оболочки
+TEST(ConvexHullTest, AllPointsOnHull) {
+    std::vector<Point<double>> points;
+    for (int i = 0; i < 360; ++i) {
+        double angle = i * 3.14159265358979323846 / 180.0;
+        points.emplace_back(std::cos(angle), std::sin(angle));
+    }
+    ThreadPool pool(4);
+    auto hull = parallel_convex_hull(pool, std::span<const Point<double>>(points), 32);
+    EXPECT_EQ(hull.size(), points.size());
+    expect_hull_of(hull, points);
+}
@@ -0,0 +1,242 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../include/figurestream.h"
+#include "../include/figureio.h"
+#include "../include/rhombus.h"
+#include "../include/pentagon.h"
+#include "../include/point.h"
+
+static constexpr double EPS = 1e-6;
+
+// Вспомогательная функция: текстовая строка для ромба с площадью 2 * k * k.
+static std::string rhombus_line(int k) {
+    std::ostringstream oss;
+    oss << "rhombus (0, " << k << ") (" << -k << ", 0) (0, " << -k << ") (" << k << ", 0)\n";
+    return oss.str();
+}
+
+// Тест: запись фигуры в текстовом формате и чтение её обратно
+TEST(FigureIOTest, TextRoundTrip) {
+    Rhombus<double> rhombus(Point<double>(0.0, 1.0), Point<double>(-1.0, 0.0), Point<double>(0.0, -1.0), Point<double>(1.0, 0.0));
+
+    std::stringstream ss;
+    write_text_record(ss, to_record<double>(rhombus));
+
+    FigureRecord<double> record;
+    ASSERT_TRUE(read_text_record(ss, record));
+    EXPECT_EQ(record.vertex_count, 4u);
+    auto figure = make_figure(record);
+    EXPECT_NEAR(figure->square(), 2.0, EPS);
+    EXPECT_FALSE(read_text_record(ss, record));
+}
+
+// Тест: запись и чтение в двоичном формате, проверка заголовка
+TEST(FigureIOTest, BinaryRoundTripAndHeaderCheck) {
+    double radius = 1.0;
+    Pentagon<double> pentagon(
+        Point<double>(radius * std::cos(0 * M_PI / 180), radius * std::sin(0 * M_PI / 180)),
+        Point<double>(radius * std::cos(72 * M_PI / 180), radius * std::sin(72 * M_PI / 180)),
+        Point<double>(radius * std::cos(144 * M_PI / 180), radius * std::sin(144 * M_PI / 180)),
+        Point<double>(radius * std::cos(216 * M_PI / 180), radius * std::sin(216 * M_PI / 180)),
+        Point<double>(radius * std::cos(288 * M_PI / 180), radius * std::sin(288 * M_PI / 180)));
+
+    std::stringstream ss;
+    write_binary_header<double>(ss, 1);
+    write_binary_record(ss, to_record<double>(pentagon));
+
+    auto header = read_binary_header<double>(ss);
+    EXPECT_EQ(header.count, 1u);
+    FigureRecord<double> record;
+    ASSERT_TRUE(read_binary_record(ss, record));
+    EXPECT_NEAR(make_figure(record)->square(), pentagon.square(), EPS);
+
+    // Файл с координатами другого типа должен быть отвергнут
+    std::stringstream wrong;
+    write_binary_header<float>(wrong);
+    EXPECT_THROW(read_binary_header<double>(wrong), std::runtime_error);
+}
+
+// Тест: некорректная запись отвергается при создании фигуры
+TEST(FigureIOTest, MalformedRecordIsRejected) {
+    std::stringstream ss("triangle (0, 0) (1, 0) (0, 1)\nrhombus (0, 0) (1, 0)\n");
+    FigureRecord<double> record;
+    ASSERT_TRUE(read_text_record(ss, record));
+    EXPECT_THROW(make_figure(record), std::invalid_argument);
+    ASSERT_TRUE(read_text_record(ss, record));
+    EXPECT_THROW(make_figure(record), std::invalid_argument);
+}
+
+// Тест: создание фигур без исключений и пакетное построение со списком отказов
+TEST(FigureIOTest, TryBuildCollectsRejections) {
+    std::stringstream ss(rhombus_line(1) + "triangle (0, 0) (1, 0) (0, 1)\n" + rhombus_line(2) +
+                         "rhombus (0, 0) (1, 0) (5, 5) (0, 1)\n" + rhombus_line(3));
+    std::vector<FigureRecord<double>> records;
+    FigureRecord<double> record;
+    while (read_text_record(ss, record)) {
+        records.push_back(record);
+    }
+    ASSERT_EQ(records.size(), 5u);
+
+    auto single = try_make_figure(records[3]);
+    ASSERT_FALSE(single.has_value());
+    EXPECT_EQ(single.error(), ValidationError::RhombusUnequalSides);
+    EXPECT_TRUE(try_make_figure(records[0]).has_value());
+
+    ArrayOfFigures<Figure<double>> figures;
+    std::vector<FigureRejection> rejected;
+    EXPECT_EQ(try_build(std::span<const FigureRecord<double>>(records), figures, rejected), 3u);
+    EXPECT_EQ(figures.get_size(), 3u);
+    EXPECT_NEAR(figures.total_area(), 2.0 + 8.0 + 18.0, EPS);
+    ASSERT_EQ(rejected.size(), 2u);
+    EXPECT_EQ(rejected[0].index, 1u);
+    EXPECT_EQ(rejected[0].error, ValidationError::UnsupportedVertexCount);
+    EXPECT_EQ(rejected[1].index, 3u);
+    EXPECT_EQ(rejected[1].error, ValidationError::RhombusUnequalSides);
+
+    ArrayOfFigures<Figure<double>, UniqueOwnership> unique_figures;
+    rejected.clear();
+    EXPECT_EQ(try_build(std::span<const FigureRecord<double>>(records), unique_figures, rejected), 3u);
+
+    // Исключение конструктора содержит тот же код причины.
+    try {
+        make_figure(records[3]);
+        FAIL() << "make_figure must throw";
+    } catch (const FigureValidationError& error) {
+        EXPECT_EQ(error.get_code(), ValidationError::RhombusUnequalSides);
+    }
+}
+
+// Тест: конвейер обрабатывает поток блоками и накапливает итоги
+TEST(FigureStreamPipelineTest, ChunkedTotals) {
+    std::stringstream ss;
+    for (int k = 1; k <= 10; ++k) {
+        ss << rhombus_line(k);
+    }
+    // Некорректный ромб (стороны не равны)
+    ss << "rhombus (0, 0) (5, 0) (5, 1) (0, 1)\n";
+
+    FigureStreamPipeline<double> pipeline(3);
+    std::vector<std::size_t> seen;
+    pipeline.on_chunk([&seen](const StreamTotals& totals) { seen.push_back(totals.read); });
+    StreamTotals totals = pipeline.run(ss, FigureFileFormat::Text);
+
+    EXPECT_EQ(totals.read, 11u);
+    EXPECT_EQ(totals.rejected, 1u);
+    EXPECT_EQ(totals.accepted, 10u);
+    EXPECT_EQ(totals.chunks, 4u);
+    // Сумма 2 * k^2 для k = 1..10 = 770
+    EXPECT_NEAR(totals.total_square, 770.0, EPS);
+    EXPECT_EQ(seen, (std::vector<std::size_t>{3, 6, 9, 11}));
+}
+
+// Тест: фильтры, преобразования и приёмник применяются в порядке чтения
+TEST(FigureStreamPipelineTest, FilterTransformAndSink) {
+    std::stringstream ss;
+    write_binary_header<double>(ss);
+    for (int k = 1; k <= 6; ++k) {
+        Rhombus<double> rhombus(Point<double>(0.0, k), Point<double>(-k, 0.0), Point<double>(0.0, -k), Point<double>(k, 0.0));
+        write_binary_record(ss, to_record<double>(rhombus));
+    }
+
+    FigureStreamPipeline<double> pipeline(2);
+    std::vector<double> areas;
+    pipeline.filter([](const Figure<double>& figure) { return figure.square() > 10.0; })
+            .transform([](std::shared_ptr<Figure<double>> figure) { return figure->clone(); })
+            .sink([&areas](const Figure<double>& figure) { areas.push_back(figure.square()); });
+    StreamTotals totals = pipeline.run(ss, FigureFileFormat::Binary);
+
+    EXPECT_EQ(totals.accepted, 4u);
+    EXPECT_EQ(totals.filtered, 2u);
+    ASSERT_EQ(areas.size(), 4u);
+    EXPECT_NEAR(areas.front(), 18.0, EPS);
+    EXPECT_NEAR(areas.back(), 72.0, EPS);
+}
+
+// Тест: много мелких блоков, ошибка приёмника и ошибка чтения посреди потока
+TEST(FigureStreamPipelineTest, ManyChunksAndErrors) {
+    std::stringstream ss;
+    for (int k = 1; k <= 2000; ++k) {
+        ss << rhombus_line(1 + k % 5);
+    }
+    FigureStreamPipeline<double> pipeline(1);
+    StreamTotals totals = pipeline.run(ss, FigureFileFormat::Text);
+    EXPECT_EQ(totals.chunks, 2000u);
+    EXPECT_EQ(totals.accepted, 2000u);
+
+    // Исключение приёмника прерывает чтение и пробрасывается вызывающему.
+    std::stringstream again;
+    for (int k = 1; k <= 100; ++k) {
+        again << rhombus_line(k);
+    }
+    std::size_t received = 0;
+    FigureStreamPipeline<double> failing(4);
+    failing.sink([&received](const Figure<double>&) {
+        if (++received == 10) {
+            throw std::runtime_error("sink failed");
+        }
+    });
+    EXPECT_THROW(failing.run(again, FigureFileFormat::Text), std::runtime_error);
+    EXPECT_EQ(received, 10u);
+
+    // Ошибка чтения пробрасывается после обработки блоков, прочитанных до неё.
+    Rhombus<double> rhombus(Point<double>(0.0, 1.0), Point<double>(-1.0, 0.0), Point<double>(0.0, -1.0), Point<double>(1.0, 0.0));
+    std::stringstream truncated;
+    write_binary_header<double>(truncated);
+    for (int k = 0; k < 7; ++k) {
+        write_binary_record(truncated, to_record<double>(rhombus));
+    }
+    truncated << std::string(10, '\0');
+    std::size_t processed = 0;
+    FigureStreamPipeline<double> reading(2);
+    reading.on_chunk([&processed](const StreamTotals& totals) { processed = totals.read; });
+    EXPECT_THROW(reading.run(truncated, FigureFileFormat::Binary), std::runtime_error);
+    EXPECT_EQ(processed, 6u);
+}
+
+// Тест: обрезанная последняя запись и несовпадение количества записей с заголовком
+TEST(FigureIOTest, BinaryTruncationAndHeaderCount) {
+    Rhombus<double> rhombus(Point<double>(0.0, 1.0), Point<double>(-1.0, 0.0), Point<double>(0.0, -1.0), Point<double>(1.0, 0.0));
+    auto make_stream = [&](std::uint64_t header_count, int records, std::size_t tail_bytes) {
+        std::stringstream ss;
+        write_binary_header<double>(ss, header_count);
+        for (int k = 0; k < records; ++k) {
+            write_binary_record(ss, to_record<double>(rhombus));
+        }
+        ss << std::string(tail_bytes, '\0');
+        return ss;
+    };
+    auto read_all = [](std::stringstream& ss) {
+        FigureChunkReader<double> reader(ss, FigureFileFormat::Binary, 2);
+        std::vector<FigureRecord<double>> chunk;
+        std::size_t total = 0;
+        while (reader.next_chunk(chunk)) {
+            total += chunk.size();
+        }
+        return total;
+    };
+
+    // Часть записи в конце потока - ошибка, а не конец файла.
+    auto truncated = make_stream(0, 3, 10);
+    FigureRecord<double> record;
+    read_binary_header<double>(truncated);
+    for (int k = 0; k < 3; ++k) {
+        ASSERT_TRUE(read_binary_record(truncated, record));
+    }
+    EXPECT_THROW(read_binary_record(truncated, record), std::runtime_error);
+    auto truncated_chunks = make_stream(0, 3, 10);
+    EXPECT_THROW(read_all(truncated_chunks), std::runtime_error);
+
+    // В заголовке 5 записей, в потоке 3.
+    auto short_stream = make_stream(5, 3, 0);
+    EXPECT_THROW(read_all(short_stream), std::runtime_error);
+    // В заголовке 2 записи: остальные не читаются (как в MappedFigures).
+    auto long_stream = make_stream(2, 3, 0);
+    EXPECT_EQ(read_all(long_stream), 2u);
+    auto exact = make_stream(3, 3, 0);
+    EXPECT_EQ(read_all(exact), 3u);
+}
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <functional>
+#include <stdexcept>
+#include <unordered_set>
+#include "../include/geometricsignature.h"
+#include "../include/affine.h"
+#include "../include/rhombus.h"
+#include "../include/pentagon.h"
+#include "../include/hexagon.h"
+
+// Тест: начальная вершина и направление обхода не влияют на сигнатуру
+TEST(GeometricSignatureTest, IdenticalIgnoresStartVertexAndOrientation) {
+    Rhombus<double> a(Point<double>(0.0, 1.0), Point<double>(-1.0, 0.0), Point<double>(0.0, -1.0), Point<double>(1.0, 0.0));
+    Rhombus<double> shifted_start(Point<double>(-1.0, 0.0), Point<double>(0.0, -1.0), Point<double>(1.0, 0.0), Point<double>(0.0, 1.0));
+    Rhombus<double> reversed(Point<double>(1.0, 0.0), Point<double>(0.0, -1.0), Point<double>(-1.0, 0.0), Point<double>(0.0, 1.0), "named");
+    auto signature = GeometricSignature::of(a);
+    EXPECT_EQ(signature, GeometricSignature::of(shifted_start));
+    EXPECT_EQ(signature, GeometricSignature::of(reversed));
+    EXPECT_EQ(std::hash<GeometricSignature>{}(signature), std::hash<GeometricSignature>{}(GeometricSignature::of(reversed)));
+
+    // Погрешность меньше кванта не меняет сигнатуру, сдвиг - меняет.
+    Rhombus<double> noisy(Point<double>(0.0, 1.0 + 1e-9), Point<double>(-1.0, 1e-9), Point<double>(0.0, -1.0 + 1e-9), Point<double>(1.0, 1e-9));
+    EXPECT_EQ(signature, GeometricSignature::of(noisy));
+    Rhombus<double> moved(Point<double>(5.0, 1.0), Point<double>(4.0, 0.0), Point<double>(5.0, -1.0), Point<double>(6.0, 0.0));
+    EXPECT_NE(signature, GeometricSignature::of(moved));
+}
+
+// Тест: конгруэнтные фигуры (сдвиг, поворот, отражение) имеют одну сигнатуру
+TEST(GeometricSignatureTest, CongruentIgnoresRigidMotion) {
+    auto p = Pentagon<double>::regular(Point<double>(0.0, 0.0), 2.0);
+    auto q = Pentagon<double>::regular(Point<double>(100.0, -3.0), 2.0, 0.4);
+    auto r = p;
+    r.transform(Affine2D{-1.0, 0.0, 0.0, 1.0, 7.0, 0.0}); // отражение
+    auto signature = GeometricSignature::of(p, DeduplicationMode::Congruent);
+    EXPECT_EQ(signature, GeometricSignature::of(q, DeduplicationMode::Congruent));
+    EXPECT_EQ(signature, GeometricSignature::of(r, DeduplicationMode::Congruent));
+    EXPECT_NE(GeometricSignature::of(p), GeometricSignature::of(q));
+
+    // Другой размер или вид фигуры - другая сигнатура.
+    auto bigger = Pentagon<double>::regular(Point<double>(0.0, 0.0), 2.5);
+    EXPECT_NE(signature, GeometricSignature::of(bigger, DeduplicationMode::Congruent));
+    auto hexagon = Hexagon<double>::regular(Point<double>(0.0, 0.0), 2.0);
+    EXPECT_NE(signature, GeometricSignature::of(hexagon, DeduplicationMode::Congruent));
+
+    // Ромбы с разными углами и одинаковыми сторонами различаются.
+    Rhombus<double> square(Point<double>(0.0, 1.0), Point<double>(-1.0, 0.0), Point<double>(0.0, -1.0), Point<double>(1.0, 0.0));
+    Rhombus<double> flat(Point<double>(0.0, 0.5), Point<double>(-std::sqrt(1.75), 0.0), Point<double>(0.0, -0.5), Point<double>(std::sqrt(1.75), 0.0));
+    EXPECT_NE(GeometricSignature::of(square, DeduplicationMode::Congruent), GeometricSignature::of(flat, DeduplicationMode::Congruent));
+
+    std::unordered_set<GeometricSignature> set{signature, GeometricSignature::of(q, DeduplicationMode::Congruent)};
+    EXPECT_EQ(set.size(), 1u);
+    EXPECT_THROW(GeometricSignature::of(p, DeduplicationMode::Congruent, 0.0), std::invalid_argument);
+}
@@ -209,3 +209,19 @@ TEST(HexagonTest, AreaFormulaValidation) {
     EXPECT_NEAR(hexagon.square(), expected_area, 0.01); // Допуск из-за формулы Гаусса
 }
 
+
+// Тест: фабрика правильного шестиугольника по центру, радиусу и углу поворота
+TEST(HexagonTest, RegularFactory) {
+    const double R = 3.0;
+    auto h = Hexagon<double>::regular(Point<double>(0.0, 0.0), R, M_PI / 6, "tile");
+    EXPECT_TRUE(h.is_valid());
+    EXPECT_EQ(h.get_description(), "tile");
+    EXPECT_NEAR(h.square(), 3.0 * std::sqrt(3.0) / 2.0 * R * R, EPS);
+    EXPECT_NEAR(h.perimeter(), 6.0 * R, EPS);
+    EXPECT_NEAR(h.vertex(0).get_y(), R * 0.5, EPS);
+
+    Hexagon<double> same(h.vertex(0), h.vertex(1), h.vertex(2), h.vertex(3), h.vertex(4), h.vertex(5));
+    EXPECT_NEAR(h.square(), same.square(), EPS);
+    EXPECT_NEAR(h.perimeter(), same.perimeter(), EPS);
+    EXPECT_NEAR(h.clone()->square(), h.square(), EPS);
+}
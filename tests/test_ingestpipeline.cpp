@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../include/ingestpipeline.h"
+#include "../include/boundedqueue.h"
+#include "../include/arrayoffigures.h"
+#include "../include/rhombus.h"
+#include "../include/point.h"
+
+static constexpr double EPS = 1e-6;
+
+// Вспомогательная функция: текстовый поток из n ромбов, ромб с номером k имеет площадь 2 * k * k.
+// Каждая запись с номером, кратным invalid_every, заменяется некорректной.
+static std::string make_input(int n, int invalid_every = 0) {
+    std::ostringstream oss;
+    for (int k = 1; k <= n; ++k) {
+        if (invalid_every != 0 && k % invalid_every == 0) {
+            oss << "rhombus (0, 0) (5, 0) (5, 1) (0, 1)\n";
+        } else {
+            oss << "rhombus (0, " << k << ") (" << -k << ", 0) (0, " << -k << ") (" << k << ", 0)\n";
+        }
+    }
+    return oss.str();
+}
+
+// Тест: очередь сохраняет порядок FIFO и сообщает о заполнении
+TEST(BoundedQueueTest, FifoAndCapacity) {
+    BoundedQueue<int> queue(3);
+    EXPECT_EQ(queue.get_capacity(), 4u);
+
+    for (int i = 0; i < 4; ++i) {
+        int value = i;
+        EXPECT_TRUE(queue.try_push(value));
+    }
+    int extra = 100;
+    EXPECT_FALSE(queue.try_push(extra));
+    EXPECT_EQ(queue.approx_size(), 4u);
+
+    for (int i = 0; i < 4; ++i) {
+        int value = -1;
+        EXPECT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    int value = -1;
+    EXPECT_FALSE(queue.try_pop(value));
+}
+
+// Тест: несколько производителей и потребителей передают все элементы без потерь
+TEST(BoundedQueueTest, MultiProducerMultiConsumer) {
+    BoundedQueue<int> queue(16);
+    constexpr int PER_PRODUCER = 10000;
+    std::atomic<long long> sum{0};
+    std::atomic<int> producers_left{2};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < 2; ++p) {
+        threads.emplace_back([&]() {
+            QueueWaitStats stats;
+            for (int i = 1; i <= PER_PRODUCER; ++i) {
+                int value = i;
+                queue.push(value, stats);
+            }
+            if (producers_left.fetch_sub(1) == 1) {
+                queue.close();
+            }
+        });
+    }
+    for (int c = 0; c < 2; ++c) {
+        threads.emplace_back([&]() {
+            QueueWaitStats stats;
+            int value = 0;
+            while (queue.pop(value, stats)) {
+                sum += value;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(sum.load(), 2LL * PER_PRODUCER * (PER_PRODUCER + 1) / 2);
+}
+
+// Тест: упорядоченная загрузка сохраняет порядок входного потока
+TEST(FigureIngestPipelineTest, OrderedIngestion) {
+    std::istringstream input(make_input(500, 7));
+    ArrayOfFigures<Figure<double>> figures;
+
+    FigureIngestPipeline<double> pipeline({.workers = 4, .queue_capacity = 8, .ordered = true});
+    IngestStats stats = pipeline.run(input, FigureFileFormat::Text, figures);
+
+    EXPECT_EQ(stats.reader.items, 500u);
+    EXPECT_EQ(stats.rejected, 500u / 7);
+    EXPECT_EQ(stats.accepted, figures.get_size());
+    EXPECT_LE(stats.input_queue.max_depth, stats.input_queue.capacity);
+
+    // Площади должны идти по возрастанию, как во входном потоке
+    for (size_t i = 1; i < figures.get_size(); ++i) {
+        EXPECT_LT(figures[i - 1]->square(), figures[i]->square());
+    }
+}
+
+// Тест: неупорядоченная загрузка принимает все корректные фигуры
+TEST(FigureIngestPipelineTest, UnorderedIngestion) {
+    std::istringstream input(make_input(300));
+    ArrayOfFigures<Figure<double>> figures;
+
+    FigureIngestPipeline<double> pipeline({.workers = 3, .queue_capacity = 4, .ordered = false});
+    IngestStats stats = pipeline.run(input, FigureFileFormat::Text, figures);
+
+    EXPECT_EQ(stats.accepted, 300u);
+    EXPECT_EQ(stats.rejected, 0u);
+    EXPECT_EQ(stats.workers.items, 300u);
+    EXPECT_EQ(stats.workers.threads, 3u);
+
+    // Сумма 2 * k^2 для k = 1..300
+    double expected = 2.0 * 300 * 301 * 601 / 6;
+    EXPECT_NEAR(figures.total_square(), expected, EPS * expected);
+
+    std::ostringstream report;
+    report << stats;
+    EXPECT_NE(report.str().find("throughput"), std::string::npos);
+}
+
+// Тест: загрузка из двоичного формата
+TEST(FigureIngestPipelineTest, BinaryIngestion) {
+    std::stringstream input;
+    write_binary_header<double>(input);
+    for (int k = 1; k <= 50; ++k) {
+        Rhombus<double> rhombus(Point<double>(0.0, k), Point<double>(-k, 0.0), Point<double>(0.0, -k), Point<double>(k, 0.0));
+        write_binary_record(input, to_record<double>(rhombus));
+    }
+    ArrayOfFigures<Figure<double>> figures;
+
+    FigureIngestPipeline<double> pipeline({.workers = 2, .queue_capacity = 4, .ordered = true});
+    IngestStats stats = pipeline.run(input, FigureFileFormat::Binary, figures);
+
+    EXPECT_EQ(stats.accepted, 50u);
+    EXPECT_NEAR(figures[49]->square(), 2.0 * 50 * 50, EPS);
+}
+
+// Тест: обрезанный двоичный поток и несовпадение с количеством записей в заголовке
+TEST(FigureIngestPipelineTest, BinaryTruncationIsAnError) {
+    Rhombus<double> rhombus(Point<double>(0.0, 1.0), Point<double>(-1.0, 0.0), Point<double>(0.0, -1.0), Point<double>(1.0, 0.0));
+    FigureIngestPipeline<double> pipeline({.workers = 2, .queue_capacity = 4, .ordered = true});
+
+    std::stringstream truncated;
+    write_binary_header<double>(truncated);
+    write_binary_record(truncated, to_record<double>(rhombus));
+    truncated << "partial";
+    ArrayOfFigures<Figure<double>> figures;
+    EXPECT_THROW(pipeline.run(truncated, FigureFileFormat::Binary, figures), std::runtime_error);
+
+    std::stringstream short_stream;
+    write_binary_header<double>(short_stream, 4);
+    write_binary_record(short_stream, to_record<double>(rhombus));
+    ArrayOfFigures<Figure<double>> more;
+    EXPECT_THROW(pipeline.run(short_stream, FigureFileFormat::Binary, more), std::runtime_error);
+
+    std::stringstream counted;
+    write_binary_header<double>(counted, 2);
+    for (int k = 0; k < 3; ++k) {
+        write_binary_record(counted, to_record<double>(rhombus));
+    }
+    ArrayOfFigures<Figure<double>> exact;
+    EXPECT_EQ(pipeline.run(counted, FigureFileFormat::Binary, exact).accepted, 2u);
+}
@@ -0,0 +1,73 @@
+// Инструментирование включается для этого теста независимо от опции сборки.
+#define FIGURES_INSTRUMENTATION 1
+#include <gtest/gtest.h>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include "../include/instrumentation.h"
+#include "../include/arrayoffigures.h"
+#include "../include/rhombus.h"
+#include "../include/point.h"
+
+static Point<double> p1(0.0, 1.0);
+static Point<double> p2(-1.0, 0.0);
+static Point<double> p3(0.0, -1.0);
+static Point<double> p4(1.0, 0.0);
+
+// Тест: создание, клонирование и отказы проверки учитываются счётчиками
+TEST(InstrumentationTest, CountsConstructionCloneAndRejections) {
+    Instrumentation::reset();
+
+    Rhombus<double> rhombus(p1, p2, p3, p4);
+    auto copy = rhombus.clone();
+    EXPECT_THROW(Rhombus<double>(Point<double>(0.0, 0.0), Point<double>(5.0, 0.0), Point<double>(5.0, 1.0), Point<double>(0.0, 1.0)),
+                 std::invalid_argument);
+
+    InstrumentationSnapshot snapshot = Instrumentation::snapshot();
+    EXPECT_EQ(snapshot.get(FigureCounter::Constructed), 3u);
+    EXPECT_EQ(snapshot.get(FigureCounter::Cloned), 1u);
+    EXPECT_EQ(snapshot.get(FigureCounter::ValidationFailures), 1u);
+    ASSERT_EQ(snapshot.validation_failures.size(), 1u);
+    EXPECT_EQ(snapshot.validation_failures[0].second, 1u);
+    EXPECT_NE(snapshot.validation_failures[0].first.find("equal length"), std::string::npos);
+}
+
+// Тест: изменения размера массива, выделенная память и задержки операций
+TEST(InstrumentationTest, ArrayResizesAndLatencies) {
+    Instrumentation::reset();
+
+    ArrayOfFigures<Figure<double>> array(1);
+    for (int i = 0; i < 5; ++i) {
+        array.add_figure(std::make_shared<Rhombus<double>>(p1, p2, p3, p4));
+    }
+    array.total_square();
+    array.total_square();
+    std::ostringstream oss;
+    array.print_figures(oss);
+
+    InstrumentationSnapshot snapshot = Instrumentation::snapshot();
+    // Ёмкость 2 -> 4 -> 8
+    EXPECT_EQ(snapshot.get(FigureCounter::ArrayResizes), 2u);
+    EXPECT_EQ(snapshot.get(FigureCounter::BytesAllocated), (2u + 4u + 8u) * sizeof(std::shared_ptr<Figure<double>>));
+    EXPECT_EQ(snapshot.get(FigureLatency::TotalSquare).count, 2u);
+    EXPECT_EQ(snapshot.get(FigureLatency::PrintFigures).count, 1u);
+
+    std::ostringstream dump;
+    dump << snapshot;
+    EXPECT_NE(dump.str().find("array_resizes = 2"), std::string::npos);
+}
+
+// Тест: счётчики завершившихся потоков попадают в снимок
+TEST(InstrumentationTest, CountersSurviveThreadExit) {
+    Instrumentation::reset();
+
+    std::thread worker([]() {
+        for (int i = 0; i < 10; ++i) {
+            Rhombus<double> rhombus(p1, p2, p3, p4);
+        }
+    });
+    worker.join();
+
+    EXPECT_EQ(Instrumentation::snapshot().get(FigureCounter::Constructed), 10u);
+}
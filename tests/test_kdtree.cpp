@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "../include/kdtree.h"
+#include "../include/arrayoffigures.h"
+#include "../include/rhombus.h"
+#include "../include/hexagon.h"
+#include "testfigures.h"
+
+// Эталон: k ближайших перебором, равные расстояния - по номеру.
+static std::vector<Neighbour> brute_nearest(const std::vector<Point<double>>& points, const Point<double>& query, std::size_t k,
+                                            std::size_t exclude) {
+    std::vector<Neighbour> all;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        if (i != exclude) {
+            all.push_back(Neighbour{i, std::sqrt(squared_norm(points[i] - query))});
+        }
+    }
+    std::sort(all.begin(), all.end(), [](const Neighbour& a, const Neighbour& b) {
+        return a.distance < b.distance || (a.distance == b.distance && a.index < b.index);
+    });
+    all.resize(k);
+    return all;
+}
+
+// Тест: k ближайших совпадают с перебором
+TEST(KdTreeTest, NearestMatchesBruteForce) {
+    auto points = random_points(3000, -50.0, 50.0, 1);
+    ThreadPool pool(4);
+    KdTree tree(points, pool);
+    EXPECT_EQ(tree.size(), points.size());
+    auto queries = random_points(200, -50.0, 50.0, 2);
+    std::vector<Neighbour> out(7);
+    for (const auto& query : queries) {
+        EXPECT_EQ(tree.nearest(query, 7, out), 7u);
+        EXPECT_EQ(out, brute_nearest(points, query, 7, Neighbour::NONE));
+    }
+    std::vector<Neighbour> small(3);
+    EXPECT_THROW(tree.nearest(queries[0], 4, small), std::invalid_argument);
+}
+
+// Тест: соседи всех точек, повторяющиеся точки и нехватка точек
+TEST(KdTreeTest, AllNearestAndDegenerateInputs) {
+    // Сетка с повторами: много равных расстояний.
+    std::vector<Point<double>> points;
+    for (int i = 0; i < 400; ++i) {
+        points.emplace_back(i % 20, (i / 20) % 10);
+    }
+    ThreadPool pool(3);
+    KdTree tree(points, pool);
+    auto rows = tree.all_nearest(5, pool, 16);
+    ASSERT_EQ(rows.size(), points.size() * 5);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        std::vector<Neighbour> row(rows.begin() + i * 5, rows.begin() + (i + 1) * 5);
+        EXPECT_EQ(row, brute_nearest(points, points[i], 5, i)) << i;
+    }
+
+    std::vector<Point<double>> three = {{0, 0}, {1, 0}, {3, 0}};
+    KdTree tiny(three, pool);
+    auto tiny_rows = tiny.all_nearest(4, pool, 1);
+    EXPECT_EQ(tiny_rows[0], (Neighbour{1, 1.0}));
+    EXPECT_EQ(tiny_rows[1], (Neighbour{2, 3.0}));
+    EXPECT_EQ(tiny_rows[2], Neighbour{});
+    EXPECT_EQ(tiny_rows[3], Neighbour{});
+
+    KdTree empty(std::span<const Point<double>>(), pool);
+    std::vector<Neighbour> out(2);
+    EXPECT_EQ(empty.nearest(Point<double>(0, 0), 2, out), 0u);
+}
+
+// Тест: ближайшая пара совпадает с перебором
+TEST(KdTreeTest, ClosestPair) {
+    EXPECT_FALSE(closest_pair(std::span<const Point<double>>()).has_value());
+    for (unsigned seed : {3u, 4u, 5u}) {
+        auto points = random_points(2000, -50.0, 50.0, seed);
+        ClosestPair expected{0, 0, INFINITY};
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            for (std::size_t j = i + 1; j < points.size(); ++j) {
+                double d = std::sqrt(squared_norm(points[i] - points[j]));
+                if (d < expected.distance) {
+                    expected = ClosestPair{i, j, d};
+                }
+            }
+        }
+        auto pair = closest_pair(points);
+        ASSERT_TRUE(pair.has_value());
+        EXPECT_EQ(*pair, expected);
+    }
+    // Совпадающие точки.
+    std::vector<Point<double>> duplicates = {{5, 5}, {1, 1}, {2, 2}, {1, 1}};
+    EXPECT_EQ(*closest_pair(duplicates), (ClosestPair{1, 3, 0.0}));
+    // Из нескольких групп совпадающих точек выбирается первая пара в порядке (first, second).
+    std::vector<Point<double>> groups = {{7, 7}, {3, 3}, {0, 0}, {3, 3}, {7, 7}, {0, 0}};
+    EXPECT_EQ(*closest_pair(groups), (ClosestPair{0, 4, 0.0}));
+    // Много совпадающих точек (например, центры одинаковых фигур) не приводят к квадратичному заметанию.
+    std::vector<Point<double>> stacked(200000, Point<double>(1.5, -2.5));
+    stacked.emplace_back(0.0, 0.0);
+    EXPECT_EQ(*closest_pair(stacked), (ClosestPair{0, 1, 0.0}));
+}
+
+// Тест: соседи и ближайшая пара фигур коллекции
+TEST(KdTreeTest, ArrayNeighbours) {
+    ArrayOfFigures<Figure<double>> array;
+    array.set_thread_pool(std::make_shared<ThreadPool>(4));
+    EXPECT_FALSE(array.closest_pair().has_value());
+    array.add_figure(std::make_shared<Hexagon<double>>(Hexagon<double>::regular(Point<double>(0.0, 0.0), 1.0)));
+    array.add_figure(nullptr);
+    array.add_figure(std::make_shared<Rhombus<double>>(Point<double>(10, 11), Point<double>(9, 10), Point<double>(10, 9), Point<double>(11, 10)));
+    array.add_figure(std::make_shared<Hexagon<double>>(Hexagon<double>::regular(Point<double>(3.0, 4.0), 2.0)));
+    array.add_figure(std::make_shared<Hexagon<double>>(Hexagon<double>::regular(Point<double>(10.0, 12.0), 0.5)));
+
+    auto pair = array.closest_pair();
+    ASSERT_TRUE(pair.has_value());
+    EXPECT_EQ(pair->first, 2u);
+    EXPECT_EQ(pair->second, 4u);
+    EXPECT_NEAR(pair->distance, 2.0, 1e-9);
+
+    auto rows = array.nearest_neighbours(2);
+    ASSERT_EQ(rows.size(), 10u);
+    EXPECT_EQ(rows[0].index, 3u);
+    EXPECT_NEAR(rows[0].distance, 5.0, 1e-9);
+    EXPECT_EQ(rows[2], Neighbour{});
+    EXPECT_EQ(rows[3], Neighbour{});
+    EXPECT_EQ(rows[4].index, 4u);
+    EXPECT_EQ(rows[5].index, 3u);
+    EXPECT_EQ(rows[8].index, 2u);
+}
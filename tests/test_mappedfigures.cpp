@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "../include/mappedfigures.h"
+#include "../include/kdtree.h"
+#include "../include/rhombus.h"
+#include "../include/pentagon.h"
+#include "../include/hexagon.h"
+#include "testfigures.h"
+
+static constexpr double EPS = 1e-6;
+
+// Временный файл, удаляемый по окончании теста.
+class TemporaryFile {
+    public:
+        explicit TemporaryFile(const std::string& name)
+            : path(std::filesystem::temp_directory_path() / (name + "_" + std::to_string(::getpid()) + ".figs")) {};
+
+        ~TemporaryFile() {
+            std::filesystem::remove(path);
+        };
+
+        std::string string() const {
+            return path.string();
+        };
+
+    private:
+        std::filesystem::path path;
+};
+
+// Тест: фигуры, добавленные в файл, доступны после повторного открытия без создания объектов
+TEST(MappedFiguresTest, AppendAndReopen) {
+    TemporaryFile file("mapped_reopen");
+    auto figures = mixed_figures(3000);
+    {
+        auto mapped = MappedFigures<double>::create(file.string());
+        EXPECT_TRUE(mapped.empty());
+        mapped.append(figures);
+        EXPECT_EQ(mapped.size(), 3000u);
+    }
+    // Лишняя ёмкость отрезана при закрытии.
+    EXPECT_EQ(std::filesystem::file_size(file.string()), sizeof(BinaryFigureHeader) + 3000 * sizeof(FigureRecord<double>));
+
+    MappedFigures<double> mapped(file.string());
+    ASSERT_EQ(mapped.size(), figures.get_size());
+    EXPECT_NEAR(mapped.total_square(), figures.total_square(), 1e-6 * figures.total_square());
+    for (std::size_t i : {0u, 1u, 2u, 1234u, 2999u}) {
+        EXPECT_NEAR(mapped.square(i), figures[i]->square(), EPS);
+        EXPECT_NEAR(mapped.figure(i)->perimeter(), figures[i]->perimeter(), EPS);
+        EXPECT_EQ(mapped.vertices(i).size(), figures[i]->vertex_count());
+    }
+    auto centers = mapped.centroids();
+    auto boxes = mapped.bounding_boxes();
+    for (std::size_t i = 0; i < figures.get_size(); i += 97) {
+        auto center = figures[i]->geometric_center();
+        EXPECT_NEAR(centers[i].get_x(), center->get_x(), EPS);
+        EXPECT_NEAR(centers[i].get_y(), center->get_y(), EPS);
+        EXPECT_TRUE(boxes[i].contains(center->get_x(), center->get_y()));
+    }
+
+    // Центры из файла сразу подходят для индексов.
+    KdTree tree(centers, ThreadPool::global());
+    std::vector<Neighbour> nearest(1);
+    EXPECT_EQ(tree.nearest(Point<double>(10.1, 3.0), 1, nearest), 1u);
+    EXPECT_EQ(nearest[0].index, 160u);
+
+    std::vector<FigureRejection> rejected;
+    auto loaded = mapped.load(rejected);
+    EXPECT_TRUE(rejected.empty());
+    EXPECT_EQ(loaded.get_size(), figures.get_size());
+    EXPECT_THROW(mapped.record(3000), std::out_of_range);
+}
+
+// Тест: добавление в существующий файл и рост отображения
+TEST(MappedFiguresTest, AppendToExistingFile) {
+    TemporaryFile file("mapped_append");
+    Rhombus<double> rhombus(Point<double>(0.0, 1.0), Point<double>(-1.0, 0.0), Point<double>(0.0, -1.0), Point<double>(1.0, 0.0));
+    {
+        auto mapped = MappedFigures<double>::create(file.string());
+        mapped.append(rhombus);
+    }
+    {
+        MappedFigures<double> mapped(file.string(), MapMode::ReadWrite);
+        ASSERT_EQ(mapped.size(), 1u);
+        // Рост далеко за MIN_GROWTH: отображение перемещается, ранее добавленные записи сохраняются.
+        for (int i = 0; i < 5000; ++i) {
+            mapped.append(rhombus);
+        }
+        EXPECT_EQ(mapped.size(), 5001u);
+        EXPECT_NEAR(mapped.total_square(), 2.0 * 5001, EPS);
+        mapped.flush();
+    }
+    MappedFigures<double> mapped(file.string());
+    EXPECT_EQ(mapped.size(), 5001u);
+    EXPECT_THROW(mapped.append(rhombus), std::runtime_error);
+}
+
+// Тест: некорректные записи не попадают в файл
+TEST(MappedFiguresTest, AppendValidatesRecords) {
+    TemporaryFile file("mapped_validate");
+    auto mapped = MappedFigures<double>::create(file.string());
+    Rhombus<double> rhombus(Point<double>(0.0, 1.0), Point<double>(-1.0, 0.0), Point<double>(0.0, -1.0), Point<double>(1.0, 0.0));
+    std::vector<FigureRecord<double>> records{to_record<double>(rhombus), to_record<double>(rhombus)};
+    records[1].vertices[0] = Point<double>(0.0, 2.0);
+    EXPECT_THROW(mapped.append(records), FigureValidationError);
+    EXPECT_EQ(mapped.size(), 0u);
+    records.pop_back();
+    mapped.append(records);
+    EXPECT_EQ(mapped.size(), 1u);
+}
+
+// Тест: несовпадение формата, версии, типа координат и обрезанный файл
+TEST(MappedFiguresTest, DetectsFormatMismatch) {
+    TemporaryFile file("mapped_format");
+    {
+        auto mapped = MappedFigures<double>::create(file.string());
+        mapped.append(mixed_figures(10));
+    }
+    EXPECT_THROW(MappedFigures<float>(file.string()), std::runtime_error);
+    EXPECT_THROW(MappedFigures<int>(file.string()), std::runtime_error);
+
+    auto patch = [&](std::streamoff offset, const char* bytes, std::size_t size) {
+        std::fstream fs(file.string(), std::ios::in | std::ios::out | std::ios::binary);
+        fs.seekp(offset);
+        fs.write(bytes, static_cast<std::streamsize>(size));
+    };
+    const std::uint16_t future_version = BINARY_FIGURE_FORMAT_VERSION + 1;
+    patch(4, reinterpret_cast<const char*>(&future_version), sizeof(future_version));
+    EXPECT_THROW(MappedFigures<double>(file.string()), std::runtime_error);
+    patch(4, reinterpret_cast<const char*>(&BINARY_FIGURE_FORMAT_VERSION), sizeof(BINARY_FIGURE_FORMAT_VERSION));
+    EXPECT_EQ(MappedFigures<double>(file.string()).size(), 10u);
+    patch(0, "FIGX", 4);
+    EXPECT_THROW(MappedFigures<double>(file.string()), std::runtime_error);
+    patch(0, "FIGS", 4);
+
+    // В заголовке 10 записей, в файле - 9 с половиной.
+    std::filesystem::resize_file(file.string(), sizeof(BinaryFigureHeader) + 9 * sizeof(FigureRecord<double>) + 8);
+    EXPECT_THROW(MappedFigures<double>(file.string()), std::runtime_error);
+    std::filesystem::resize_file(file.string(), 8);
+    EXPECT_THROW(MappedFigures<double>(file.string()), std::runtime_error);
+    EXPECT_THROW(MappedFigures<double>(file.string() + ".missing"), std::system_error);
+}
+
+// Тест: файл, записанный потоком без количества записей, читается до конца
+TEST(MappedFiguresTest, OpensStreamWrittenFile) {
+    TemporaryFile file("mapped_stream");
+    auto figures = mixed_figures(7);
+    {
+        std::ofstream os(file.string(), std::ios::binary);
+        write_binary_header<double>(os);
+        for (const auto& figure : figures) {
+            write_binary_record(os, to_record(*figure));
+        }
+    }
+    MappedFigures<double> mapped(file.string());
+    EXPECT_EQ(mapped.size(), 7u);
+    EXPECT_NEAR(mapped.total_square(), figures.total_square(), EPS);
+}
+
+// Тест: площадь по записям с целочисленными координатами считается без переполнения
+TEST(MappedFiguresTest, IntegerAreaDoesNotOverflow) {
+    TemporaryFile file("mapped_int");
+    auto mapped = MappedFigures<int>::create(file.string());
+    mapped.append(Rhombus<int>(Point<int>(0, 0), Point<int>(100000, 0), Point<int>(100000, 100000), Point<int>(0, 100000)));
+    mapped.append(Rhombus<int>(Point<int>(0, 100000), Point<int>(-100000, 0), Point<int>(0, -100000), Point<int>(100000, 0)));
+    EXPECT_DOUBLE_EQ(mapped.square(0), 1e10);
+    EXPECT_DOUBLE_EQ(mapped.total_square(), 3e10);
+}
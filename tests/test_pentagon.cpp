@@ -107,3 +107,59 @@ TEST(PentagonTest, OutputOperator) {
     EXPECT_TRUE(out.find("pentagon") != std::string::npos);
 }
 
+
+// Тест: фабрика правильного пятиугольника по центру, радиусу и углу поворота
+TEST(PentagonTest, RegularFactory) {
+    const double R = 2.0;
+    auto p = Pentagon<double>::regular(Point<double>(1.0, -1.0), R, 0.3);
+    EXPECT_TRUE(p.is_valid());
+    EXPECT_EQ(p.get_description(), "pentagon");
+
+    // Сохранённые значения совпадают с вычисленными по вершинам.
+    Pentagon<double> same(p.vertex(0), p.vertex(1), p.vertex(2), p.vertex(3), p.vertex(4));
+    EXPECT_NEAR(p.square(), same.square(), EPS);
+    EXPECT_NEAR(p.perimeter(), same.perimeter(), EPS);
+    EXPECT_NEAR(p.square(), 2.5 * R * R * std::sin(72 * M_PI / 180), EPS);
+    auto c = p.geometric_center();
+    EXPECT_NEAR(c->get_x(), 1.0, EPS);
+    EXPECT_NEAR(c->get_y(), -1.0, EPS);
+    EXPECT_NEAR(p.vertex(0).get_x(), 1.0 + R * std::cos(0.3), EPS);
+
+    // Копия сохраняет значения, чтение новых вершин сбрасывает их.
+    Pentagon<double> copy(p);
+    EXPECT_NEAR(copy.square(), p.square(), EPS);
+    auto small = make_regular_pentagon(1.0);
+    std::stringstream ss;
+    for (const auto& point : small) {
+        ss << point << " ";
+    }
+    ss >> copy;
+    EXPECT_NEAR(copy.square(), 2.5 * std::sin(72 * M_PI / 180), EPS);
+
+    EXPECT_THROW(Pentagon<double>::regular(Point<double>(0.0, 0.0), 0.0), std::invalid_argument);
+}
+
+// Тест: преобразование подобия сохраняет правильность и пересчитывает сохранённые площадь и периметр
+TEST(PentagonTest, SimilarityTransform) {
+    auto p = Pentagon<double>::regular(Point<double>(0.0, 0.0), 1.0);
+    double area = p.square();
+    double perimeter = p.perimeter();
+
+    p.transform(Affine2D::translation(3.0, -1.0) * Affine2D::rotation(0.7) * Affine2D::scaling(2.0));
+    EXPECT_TRUE(p.is_valid());
+    EXPECT_NEAR(p.square(), 4.0 * area, EPS);
+    EXPECT_NEAR(p.perimeter(), 2.0 * perimeter, EPS);
+    auto c = p.geometric_center();
+    EXPECT_NEAR(c->get_x(), 3.0, EPS);
+    EXPECT_NEAR(c->get_y(), -1.0, EPS);
+    EXPECT_NEAR(p.vertex(0).get_x(), 3.0 + 2.0 * std::cos(0.7), EPS);
+
+    // Сохранённые значения совпадают с вычисленными по новым вершинам.
+    Pentagon<double> same(p.vertex(0), p.vertex(1), p.vertex(2), p.vertex(3), p.vertex(4));
+    EXPECT_NEAR(p.square(), same.square(), EPS);
+    EXPECT_NEAR(p.perimeter(), same.perimeter(), EPS);
+
+    // Неравномерное растяжение не сохраняет правильный пятиугольник: исключение, вершины не меняются.
+    EXPECT_THROW(p.transform(Affine2D::scaling(2.0, 1.0)), std::invalid_argument);
+    EXPECT_NEAR(p.vertex(0).get_x(), 3.0 + 2.0 * std::cos(0.7), EPS);
+}
@@ -87,4 +87,39 @@ TEST(PointAllMethods, CopyConstructorAndAssignment) {
     assigned = src;
     EXPECT_NEAR(assigned.get_x(), src.get_x(), EPS);
     EXPECT_NEAR(assigned.get_y(), src.get_y(), EPS);
-}
\ No newline at end of file
+}
+// Тест: векторная арифметика точек
+TEST(PointAllMethods, VectorArithmetic) {
+    Point<double> a(1.0, 2.0);
+    Point<double> b(3.0, -4.0);
+    EXPECT_EQ(a + b, Point<double>(4.0, -2.0));
+    EXPECT_EQ(a - b, Point<double>(-2.0, 6.0));
+    EXPECT_EQ(-a, Point<double>(-1.0, -2.0));
+    EXPECT_EQ(a * 2.0, Point<double>(2.0, 4.0));
+    EXPECT_EQ(0.5 * b, Point<double>(1.5, -2.0));
+    EXPECT_NEAR(dot(a, b), -5.0, EPS);
+    EXPECT_NEAR(cross(a, b), -10.0, EPS);
+    EXPECT_NEAR(cross(b, a), 10.0, EPS);
+    EXPECT_NEAR(squared_norm(b), 25.0, EPS);
+    EXPECT_EQ(lerp(a, b, 0.0), a);
+    EXPECT_EQ(lerp(a, b, 1.0), b);
+    EXPECT_EQ(lerp(a, b, 0.5), Point<double>(2.0, -1.0));
+
+    // Целочисленные координаты: промежуточные t не отбрасываются, результат округляется.
+    Point<int> from(0, 10);
+    Point<int> to(10, -10);
+    EXPECT_EQ(lerp(from, to, 0.25), Point<int>(3, 5));
+    EXPECT_EQ(lerp(from, to, 0.5), Point<int>(5, 0));
+    EXPECT_EQ(lerp(from, to, 0.0), from);
+    EXPECT_EQ(lerp(from, to, 1.0), to);
+    EXPECT_EQ(lerp(Point<int>(-2000000000, 0), Point<int>(2000000000, 0), 0.75), Point<int>(1000000000, 0));
+
+    Point<double> c = a;
+    c += b;
+    c -= a;
+    c *= 2.0;
+    EXPECT_EQ(c, Point<double>(6.0, -8.0));
+
+    Point<int> i(2, 3);
+    EXPECT_EQ(cross(i, Point<int>(1, 1)), -1);
+}
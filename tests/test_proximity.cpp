@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include "../include/proximity.h"
+#include "../include/arrayoffigures.h"
+#include "../include/rhombus.h"
+#include "../include/pentagon.h"
+#include "../include/hexagon.h"
+#include "testfigures.h"
+
+static constexpr double EPS = 1e-9;
+
+// Тест: расстояние между непересекающимися фигурами
+TEST(ProximityTest, Distance) {
+    EXPECT_NEAR(figure_distance(square(0, 0, 1), square(3, 0, 1)), 2.0, EPS);
+    EXPECT_NEAR(figure_distance(square(0, 0, 1), square(2, 2, 1)), std::sqrt(2.0), EPS);
+    EXPECT_NEAR(figure_distance(diamond(0, 0, 1), diamond(3, 0, 1)), 1.0, EPS);
+    // Параллельные стороны x + y = 1 и x + y = 2: прямоугольники пересекаются, фигуры - нет.
+    EXPECT_NEAR(figure_distance(diamond(0, 0, 1), diamond(1.5, 1.5, 1)), 1.0 / std::sqrt(2.0), EPS);
+    EXPECT_FALSE(figures_overlap(diamond(0, 0, 1), diamond(1.5, 1.5, 1)));
+
+    auto pentagon = Pentagon<double>::regular(Point<double>(0.0, 0.0), 1.0);
+    auto hexagon = Hexagon<double>::regular(Point<double>(10.0, 0.0), 1.0);
+    EXPECT_NEAR(figure_distance(pentagon, hexagon), 8.0, EPS);
+    EXPECT_NEAR(figure_distance(hexagon, pentagon), 8.0, EPS);
+
+    // Пересекающиеся и касающиеся фигуры.
+    EXPECT_NEAR(figure_distance(square(0, 0, 2), square(1, 1, 2)), 0.0, EPS);
+    EXPECT_NEAR(figure_distance(square(0, 0, 1), square(1, 0, 1)), 0.0, EPS);
+    EXPECT_TRUE(figures_overlap(square(0, 0, 1), square(1, 0, 1)));
+}
+
+// Тест: глубина и направление проникновения
+TEST(ProximityTest, Penetration) {
+    auto hit = penetration_depth(square(0, 0, 2), square(1.5, 0, 2));
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_NEAR(hit->depth, 0.5, EPS);
+    EXPECT_NEAR(hit->normal.get_x(), 1.0, EPS);
+    EXPECT_NEAR(hit->normal.get_y(), 0.0, EPS);
+
+    // Сдвиг второй фигуры по normal на depth устраняет проникновение.
+    hit = penetration_depth(square(0, 0, 2), square(0.5, -1.75, 2));
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_NEAR(hit->depth, 0.25, EPS);
+    EXPECT_NEAR(hit->normal.get_y(), -1.0, EPS);
+
+    auto touch = penetration_depth(square(0, 0, 1), square(1, 0, 1));
+    ASSERT_TRUE(touch.has_value());
+    EXPECT_NEAR(touch->depth, 0.0, EPS);
+    EXPECT_FALSE(penetration_depth(square(0, 0, 1), square(3, 0, 1)).has_value());
+}
+
+// Тест: пакетные запросы одной фигуры ко всем фигурам массива
+TEST(ProximityTest, BatchedQueries) {
+    ArrayOfFigures<Figure<double>> array;
+    array.set_thread_pool(std::make_shared<ThreadPool>(4));
+    for (int i = 0; i < 1000; ++i) {
+        array.add_figure(std::make_shared<Rhombus<double>>(diamond(3.0 * i, 0.0, 1.0)));
+    }
+    array.add_figure(nullptr);
+
+    auto probe_figure = square(9.5, -0.25, 1.0);
+    ConvexProbe<double> probe(probe_figure);
+
+    auto distances = array.distances_to(probe);
+    ASSERT_EQ(distances.size(), 1001u);
+    EXPECT_TRUE(std::isnan(distances[1000]));
+    for (size_t i = 0; i < 1000; i += 97) {
+        EXPECT_NEAR(distances[i], figure_distance(probe_figure, *array[i]), EPS);
+    }
+
+    // Ромб с центром 9 пересекает квадрат [9.5, 10.5], ромбы с центрами 12 и 6 - на расстоянии 0.5 и 2.5.
+    EXPECT_EQ(array.within_distance(probe, 0.0), (std::vector<size_t>{3}));
+    EXPECT_EQ(array.within_distance(probe, 0.5), (std::vector<size_t>{3, 4}));
+    EXPECT_EQ(array.within_distance(probe, 2.6).size(), 3u);
+
+    auto hits = array.penetrations(probe);
+    ASSERT_EQ(hits.size(), 1u);
+    EXPECT_EQ(hits[0].first, 3u);
+    EXPECT_GT(hits[0].second.depth, 0.0);
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "../include/rasterizer.h"
+#include "../include/arrayoffigures.h"
+#include "../include/rhombus.h"
+#include "../include/hexagon.h"
+#include "testfigures.h"
+
+static std::vector<Point<double>> rectangle(double x0, double y0, double x1, double y1) {
+    return {{x0, y0}, {x1, y0}, {x1, y1}, {x0, y1}};
+}
+
+// Тест: проверка размеров сетки и режима
+TEST(RasterizerTest, GridValidation) {
+    std::vector<std::uint8_t> cells(100);
+    EXPECT_THROW(RasterGrid<std::uint8_t>(std::span<std::uint8_t>(cells), 10, 9, window(0, 0, 10, 10)), std::invalid_argument);
+    EXPECT_THROW(RasterGrid<std::uint8_t>(std::span<std::uint8_t>(cells), 10, 10, window(0, 0, 10, 0)), std::invalid_argument);
+    RasterGrid<std::uint8_t> grid(std::span<std::uint8_t>(cells), 10, 10, window(0, 0, 10, 10));
+    EXPECT_THROW(PolygonRasterizer<std::uint8_t>(grid, RasterMode::Area), std::invalid_argument);
+}
+
+// Тест: двоичное покрытие и количество фигур над ячейкой
+TEST(RasterizerTest, BinaryAndCount) {
+    std::vector<int> cells(100, 0);
+    RasterGrid<int> grid(std::span<int>(cells), 10, 10, window(0, 0, 10, 10));
+    PolygonRasterizer<int> binary(grid, RasterMode::Binary);
+    auto rect = rectangle(2, 3, 6, 5);
+    binary.draw(std::span<const Point<double>>(rect), 0, 10);
+    binary.draw(std::span<const Point<double>>(rect), 0, 10);
+    EXPECT_EQ(std::accumulate(cells.begin(), cells.end(), 0), 8);
+    EXPECT_EQ(grid.at(2, 3), 1);
+    EXPECT_EQ(grid.at(5, 4), 1);
+    EXPECT_EQ(grid.at(6, 4), 0);
+    EXPECT_EQ(grid.at(2, 5), 0);
+
+    // Смежные прямоугольники с общей стороной не закрашивают ячейку дважды, перекрывающиеся - закрашивают.
+    std::fill(cells.begin(), cells.end(), 0);
+    PolygonRasterizer<int> count(grid, RasterMode::Count);
+    auto left = rectangle(0.3, 0.3, 4.7, 9.7);
+    auto right = rectangle(4.7, 0.3, 9.7, 9.7);
+    count.draw(std::span<const Point<double>>(left), 0, 10);
+    count.draw(std::span<const Point<double>>(right), 0, 10);
+    EXPECT_EQ(*std::max_element(cells.begin(), cells.end()), 1);
+    EXPECT_EQ(std::accumulate(cells.begin(), cells.end(), 0), 100);
+    auto overlap = rectangle(3, 3, 5, 5);
+    count.draw(std::span<const Point<double>>(overlap), 0, 10);
+    EXPECT_EQ(grid.at(3, 3), 2);
+
+    // Отрисовка ограничивается заданными строками.
+    std::fill(cells.begin(), cells.end(), 0);
+    count.draw(std::span<const Point<double>>(left), 4, 6);
+    EXPECT_EQ(std::accumulate(cells.begin(), cells.end(), 0), 10);
+}
+
+// Тест: покрытие по площади
+TEST(RasterizerTest, AreaCoverage) {
+    std::vector<double> cells(64, 0.0);
+    RasterGrid<double> grid(std::span<double>(cells), 8, 8, window(0, 0, 4, 4));
+    PolygonRasterizer<double> area(grid, RasterMode::Area);
+
+    // Прямоугольник по серединам ячеек: внутренние ячейки 1, стороны 0.5, углы 0.25.
+    auto rect = rectangle(0.25, 0.25, 1.75, 1.25);
+    area.draw(std::span<const Point<double>>(rect), 0, 8);
+    EXPECT_DOUBLE_EQ(grid.at(0, 0), 0.25);
+    EXPECT_DOUBLE_EQ(grid.at(1, 0), 0.5);
+    EXPECT_DOUBLE_EQ(grid.at(1, 1), 1.0);
+    EXPECT_DOUBLE_EQ(grid.at(3, 1), 0.5);
+    EXPECT_DOUBLE_EQ(grid.at(3, 2), 0.25);
+    EXPECT_NEAR(std::accumulate(cells.begin(), cells.end(), 0.0), 1.5 / 0.25, 1e-12);
+
+    // Ромб: сумма долей равна площади в ячейках, каждая доля в [0, 1].
+    std::fill(cells.begin(), cells.end(), 0.0);
+    std::vector<Point<double>> rhombus = {{2.0, 3.7}, {0.3, 2.0}, {2.0, 0.3}, {3.7, 2.0}};
+    area.draw(std::span<const Point<double>>(rhombus), 0, 8);
+    EXPECT_NEAR(std::accumulate(cells.begin(), cells.end(), 0.0), 2.0 * 1.7 * 1.7 / 0.25, 1e-9);
+    for (double value : cells) {
+        EXPECT_GE(value, 0.0);
+        EXPECT_LE(value, 1.0 + 1e-12);
+    }
+}
+
+// Тест: растеризация коллекции фигур не зависит от количества потоков
+TEST(RasterizerTest, ArrayRasterize) {
+    ArrayOfFigures<Figure<double>> array;
+    for (int i = 0; i < 3000; ++i) {
+        array.add_figure(shared_diamond(1.0 + 0.25 * (i % 150), 1.0 + 0.25 * (i / 150), 0.25 * (1 + i % 4)));
+    }
+    array.add_figure(nullptr);
+    array.add_figure(std::make_shared<Hexagon<double>>(Hexagon<double>::regular(Point<double>(20.0, 3.0), 1.5)));
+    const auto view = window(0, 0, 40, 8);
+
+    std::vector<float> reference(400 * 80, 0.0f);
+    std::vector<std::uint16_t> reference_count(400 * 80, 0);
+    array.set_thread_pool(std::make_shared<ThreadPool>(1));
+    array.rasterize(RasterGrid<float>(std::span<float>(reference), 400, 80, view), RasterMode::Area);
+    array.rasterize(RasterGrid<std::uint16_t>(std::span<std::uint16_t>(reference_count), 400, 80, view), RasterMode::Count);
+    // Все фигуры в окне: сумма долей - суммарная площадь в ячейках.
+    const double cell_area = 0.1 * 0.1;
+    EXPECT_NEAR(std::accumulate(reference.begin(), reference.end(), 0.0) * cell_area, array.total_square(), 1e-2);
+
+    for (std::size_t threads : {2u, 8u}) {
+        array.set_thread_pool(std::make_shared<ThreadPool>(threads));
+        std::vector<float> cells(400 * 80, 0.0f);
+        std::vector<std::uint16_t> counts(400 * 80, 0);
+        array.rasterize(RasterGrid<float>(std::span<float>(cells), 400, 80, view), RasterMode::Area);
+        array.rasterize(RasterGrid<std::uint16_t>(std::span<std::uint16_t>(counts), 400, 80, view), RasterMode::Count);
+        EXPECT_EQ(cells, reference);
+        EXPECT_EQ(counts, reference_count);
+    }
+}
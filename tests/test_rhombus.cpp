@@ -264,3 +264,66 @@ TEST(RhombusAllMethods, CopyAndMoveAssignment) {
     mdest = std::move(msrc); // перемещающее присваивание
     EXPECT_NEAR(mdest.square(), 8.0, EPS); // масштабированный ромб area = 8
 }
+
+// Тест: вид фигуры и описание (пользовательское описание хранится только если оно задано)
+TEST(RhombusAllMethods, KindAndDescription) {
+    Rhombus<double> plain(Point<double>(0,1), Point<double>(-1,0), Point<double>(0,-1), Point<double>(1,0));
+    EXPECT_EQ(plain.get_kind(), FigureKind::Rhombus);
+    EXPECT_EQ(plain.get_description(), "rhombus");
+    EXPECT_EQ(Rhombus<double>().get_description(), "rhombus");
+
+    Rhombus<double> named(Point<double>(0,1), Point<double>(-1,0), Point<double>(0,-1), Point<double>(1,0), "orig");
+    EXPECT_EQ(named.get_kind(), FigureKind::Rhombus);
+    EXPECT_EQ(named.get_description(), "orig");
+
+    // Копирование, присваивание и клонирование сохраняют описание.
+    Rhombus<double> copy(named);
+    EXPECT_EQ(copy.get_description(), "orig");
+    Rhombus<double> assigned;
+    assigned = named;
+    EXPECT_EQ(assigned.get_description(), "orig");
+    EXPECT_EQ(named.clone()->get_description(), "orig");
+    EXPECT_EQ(named.clone_unique()->get_kind(), FigureKind::Rhombus);
+    Rhombus<double> moved(std::move(copy));
+    EXPECT_EQ(moved.get_description(), "orig");
+}
+
+// Тест: создание ромба без исключений
+TEST(RhombusAllMethods, TryCreate) {
+    auto good = Rhombus<double>::try_create(Point<double>(0,1), Point<double>(-1,0), Point<double>(0,-1), Point<double>(1,0), "ok");
+    ASSERT_TRUE(good.has_value());
+    EXPECT_NEAR(good->square(), 2.0, EPS);
+    EXPECT_EQ(good->get_description(), "ok");
+
+    auto unequal = Rhombus<double>::try_create(Point<double>(0,0), Point<double>(1,0), Point<double>(5,5), Point<double>(0,1));
+    ASSERT_FALSE(unequal.has_value());
+    EXPECT_EQ(unequal.error(), ValidationError::RhombusUnequalSides);
+
+    // Вырожденный ромб: все вершины совпадают.
+    auto degenerate = Rhombus<double>::try_create(Point<double>(0,0), Point<double>(0,0), Point<double>(0,0), Point<double>(0,0));
+    ASSERT_FALSE(degenerate.has_value());
+    EXPECT_EQ(degenerate.error(), ValidationError::RhombusDegenerateOrUnordered);
+}
+
+// Тест: преобразование фигуры с целочисленными координатами округляет вершины к ближайшему целому
+TEST(RhombusAllMethods, IntegerTransformRounds) {
+    EXPECT_EQ(Affine2D::rotation(M_PI).apply(Point<int>(1, 1)), Point<int>(-1, -1));
+
+    Rhombus<int> rhombus(Point<int>(0, 2), Point<int>(-1, 0), Point<int>(0, -2), Point<int>(1, 0));
+    rhombus.transform(Affine2D::rotation(M_PI / 2));
+    EXPECT_EQ(rhombus.vertex(0), Point<int>(-2, 0));
+    EXPECT_EQ(rhombus.vertex(1), Point<int>(0, -1));
+    EXPECT_EQ(rhombus.vertex(2), Point<int>(2, 0));
+    EXPECT_EQ(rhombus.vertex(3), Point<int>(0, 1));
+    EXPECT_NEAR(rhombus.square(), 4.0, EPS);
+}
+
+// Тест: площадь и периметр считаются в double - без переполнения int и потери точности float
+TEST(RhombusAllMethods, LargeCoordinatesDoNotOverflow) {
+    Rhombus<int> big(Point<int>(0, 0), Point<int>(100000, 0), Point<int>(100000, 100000), Point<int>(0, 100000));
+    EXPECT_DOUBLE_EQ(big.square(), 1e10);
+    EXPECT_DOUBLE_EQ(big.perimeter(), 400000.0);
+
+    Rhombus<float> precise(Point<float>(0, 0), Point<float>(4097, 0), Point<float>(4097, 4097), Point<float>(0, 4097));
+    EXPECT_DOUBLE_EQ(precise.square(), 16785409.0);
+}
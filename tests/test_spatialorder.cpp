@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../include/spatialorder.h"
+
+// Тест: ключ Мортона чередует биты координат
+TEST(SpatialOrderTest, MortonKeyInterleavesBits) {
+    EXPECT_EQ(morton_key(0, 0), 0u);
+    EXPECT_EQ(morton_key(1, 0), 1u);
+    EXPECT_EQ(morton_key(0, 1), 2u);
+    EXPECT_EQ(morton_key(3, 3), 15u);
+    EXPECT_EQ(morton_key(5, 9), 0b10010011u);
+    EXPECT_EQ(morton_key(SPATIAL_GRID_MAX, SPATIAL_GRID_MAX), 0xFFFFFFFFu);
+}
+
+// Тест: кривая Гильберта обходит квадрат 16 x 16 в углу сетки, каждый шаг - в соседнюю ячейку
+TEST(SpatialOrderTest, HilbertKeyVisitsNeighbouringCells) {
+    const std::uint32_t side = 16;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> cells(side * side, {side, side});
+    for (std::uint32_t x = 0; x < side; ++x) {
+        for (std::uint32_t y = 0; y < side; ++y) {
+            std::uint32_t key = hilbert_key(x, y);
+            ASSERT_LT(key, side * side);
+            EXPECT_EQ(cells[key].first, side); // каждый ключ встречается один раз
+            cells[key] = {x, y};
+        }
+    }
+    for (std::size_t k = 1; k < cells.size(); ++k) {
+        auto dx = std::abs(static_cast<int>(cells[k].first) - static_cast<int>(cells[k - 1].first));
+        auto dy = std::abs(static_cast<int>(cells[k].second) - static_cast<int>(cells[k - 1].second));
+        EXPECT_EQ(dx + dy, 1) << "step " << k;
+    }
+    EXPECT_EQ(space_filling_key(SpaceFillingCurve::Hilbert, 3, 5), hilbert_key(3, 5));
+    EXPECT_EQ(space_filling_key(SpaceFillingCurve::Morton, 3, 5), morton_key(3, 5));
+}
+
+// Тест: параллельная поразрядная сортировка совпадает с устойчивой сортировкой
+TEST(SpatialOrderTest, ParallelRadixSortIsStable) {
+    ThreadPool pool(4);
+    std::mt19937 rng(42);
+    std::vector<SpatialKey> items(20000);
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        // Мало различных значений старших байтов, чтобы были равные ключи и пропускаемые проходы.
+        items[i] = SpatialKey{static_cast<std::uint32_t>(rng() % 5000) << 12, i};
+    }
+    auto expected = items;
+    std::stable_sort(expected.begin(), expected.end(), [](const SpatialKey& a, const SpatialKey& b) { return a.key < b.key; });
+
+    parallel_radix_sort(pool, items, 1000);
+    ASSERT_EQ(items.size(), expected.size());
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        EXPECT_EQ(items[i].key, expected[i].key);
+        EXPECT_EQ(items[i].index, expected[i].index);
+    }
+
+    std::vector<SpatialKey> single{{7u, 0}};
+    parallel_radix_sort(pool, single, 1000);
+    EXPECT_EQ(single[0].key, 7u);
+}
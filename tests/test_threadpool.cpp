@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+#include "../include/threadpool.h"
+
+// Тест: параллельный цикл обрабатывает каждый индекс ровно один раз
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> visits(10000);
+
+    pool.parallel_for(0, visits.size(), 16, [&visits](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            visits[i].fetch_add(1);
+        }
+    });
+
+    for (const auto& visit : visits) {
+        EXPECT_EQ(visit.load(), 1);
+    }
+}
+
+// Тест: свёртка детерминирована и не зависит от количества потоков
+TEST(ThreadPoolTest, ParallelReduceIsDeterministic) {
+    std::vector<double> values(100000);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = 1.0 / static_cast<double>(i + 1);
+    }
+    auto sum_with = [&values](ThreadPool& pool) {
+        return pool.parallel_reduce(0, values.size(), 1000, 0.0,
+            [&values](size_t lo, size_t hi) { return std::accumulate(values.begin() + lo, values.begin() + hi, 0.0); },
+            [](double a, double b) { return a + b; });
+    };
+
+    ThreadPool single(1);
+    ThreadPool many(8);
+    EXPECT_EQ(sum_with(single), sum_with(many));
+}
+
+// Тест: вложенные параллельные циклы не приводят к взаимной блокировке
+TEST(ThreadPoolTest, NestedParallelFor) {
+    ThreadPool pool(2);
+    std::atomic<long> total{0};
+
+    pool.parallel_for(0, 8, 1, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            pool.parallel_for(0, 1000, 10, [&](size_t a, size_t b) { total += static_cast<long>(b - a); });
+        }
+    });
+
+    EXPECT_EQ(total.load(), 8000);
+}
+
+// Тест: исключение из тела цикла передаётся вызывающему потоку
+TEST(ThreadPoolTest, ExceptionIsPropagated) {
+    ThreadPool pool(3);
+    EXPECT_THROW(pool.parallel_for(0, 1000, 10, [](size_t lo, size_t) {
+        if (lo == 500) {
+            throw std::runtime_error("failure");
+        }
+    }), std::runtime_error);
+
+    // Пул остаётся работоспособным после исключения
+    std::atomic<size_t> count{0};
+    pool.parallel_for(0, 100, 1, [&count](size_t lo, size_t hi) { count += hi - lo; });
+    EXPECT_EQ(count.load(), 100u);
+}
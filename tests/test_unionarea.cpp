@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+#include "../include/unionarea.h"
+#include "testfigures.h"
+
+static constexpr double EPS = 1e-9;
+
+static double union_of(const std::vector<Rhombus<double>>& squares, std::size_t grain = 1) {
+    ThreadPool pool(4);
+    PolygonSet set;
+    for (const auto& s : squares) {
+        set.add(s.vertices());
+    }
+    return UnionArea::compute(set, pool, grain);
+}
+
+// Тест: простые случаи объединения квадратов
+TEST(UnionAreaTest, Squares) {
+    EXPECT_NEAR(union_of({}), 0.0, EPS);
+    EXPECT_NEAR(union_of({square(0, 0, 1)}), 1.0, EPS);
+    // Перекрытие
+    EXPECT_NEAR(union_of({square(0, 0, 2), square(1, 1, 2)}), 7.0, EPS);
+    // Непересекающиеся
+    EXPECT_NEAR(union_of({square(0, 0, 1), square(5, 5, 2)}), 5.0, EPS);
+    // Дубликаты считаются один раз
+    EXPECT_NEAR(union_of({square(0, 0, 2), square(0, 0, 2), square(0, 0, 2)}), 4.0, EPS);
+    // Общая сторона
+    EXPECT_NEAR(union_of({square(0, 0, 1), square(1, 0, 1)}), 2.0, EPS);
+    // Вложенный квадрат
+    EXPECT_NEAR(union_of({square(0, 0, 4), square(1, 1, 1)}), 16.0, EPS);
+    // Частично совпадающая сторона
+    EXPECT_NEAR(union_of({square(0, 0, 2), square(2, 1, 2)}), 8.0, EPS);
+}
+
+// Тест: обход по часовой стрелке приводится к обходу против часовой
+TEST(UnionAreaTest, ClockwiseContour) {
+    auto shifted = square(1, 1, 2);
+    std::vector<Point<double>> reversed(shifted.vertices().rbegin(), shifted.vertices().rend());
+    ThreadPool pool(4);
+    PolygonSet clockwise;
+    clockwise.add(square(0, 0, 2).vertices());
+    clockwise.add(std::span<const Point<double>>(reversed));
+    EXPECT_NEAR(UnionArea::compute(clockwise, pool, 1), 7.0, EPS);
+
+    // Вырожденный контур не добавляется.
+    PolygonSet set;
+    std::array<Point<double>, 3> line = {Point<double>(0, 0), Point<double>(1, 1), Point<double>(2, 2)};
+    set.add(std::span<const Point<double>>(line));
+    EXPECT_EQ(set.size(), 0u);
+}
+
+// Тест: сравнение с подсчётом покрытых клеток сетки; результат не зависит от разбиения на части
+TEST(UnionAreaTest, RandomSquaresMatchGridCount) {
+    std::mt19937 rng(3);
+    std::vector<Rhombus<double>> squares;
+    std::set<std::pair<int, int>> cells;
+    for (int k = 0; k < 300; ++k) {
+        int x = static_cast<int>(rng() % 40);
+        int y = static_cast<int>(rng() % 40);
+        int side = 1 + static_cast<int>(rng() % 4);
+        squares.push_back(square(x, y, side));
+        for (int i = 0; i < side; ++i) {
+            for (int j = 0; j < side; ++j) {
+                cells.emplace(x + i, y + j);
+            }
+        }
+    }
+    double expected = static_cast<double>(cells.size());
+    EXPECT_NEAR(union_of(squares, squares.size()), expected, 1e-7);
+    EXPECT_NEAR(union_of(squares, 7), expected, 1e-7);
+}
+
+// Тест: сильное перекрытие. Совпадающие и вложенные квадраты не создают пересечений сторон, поэтому
+// заметание идёт за O(n log n); при попарной обработке перекрытий 20000 квадратов считались бы минутами.
+TEST(UnionAreaTest, HeavyOverlapIsNearLinear) {
+    const std::size_t n = 20000;
+    std::vector<Rhombus<double>> same(n, square(0, 0, 1));
+    EXPECT_NEAR(union_of(same, n), 1.0, EPS);
+    EXPECT_NEAR(union_of(same, 256), 1.0, EPS);
+
+    std::vector<Rhombus<double>> nested;
+    for (std::size_t k = 1; k <= n; ++k) {
+        const double half = static_cast<double>(k);
+        nested.push_back(square(-half, -half, 2.0 * half));
+    }
+    const double expected = 4.0 * static_cast<double>(n) * static_cast<double>(n);
+    EXPECT_NEAR(union_of(nested, n), expected, expected * 1e-12);
+    EXPECT_NEAR(union_of(nested, 256), expected, expected * 1e-12);
+}
+
+// Тест: цепочка ромбов, стороны соседних ромбов пересекаются
+TEST(UnionAreaTest, CrossingDiamonds) {
+    const std::size_t n = 1000;
+    const double step = 0.25;
+    PolygonSet set;
+    for (std::size_t i = 0; i < n; ++i) {
+        const double c = static_cast<double>(i) * step;
+        set.add(diamond(c, 0, 1).vertices());
+    }
+    // Ромб площади 2 плюс для каждого следующего - полоса шириной step без треугольника step^2 / 2.
+    const double gaps = static_cast<double>(n - 1);
+    const double expected = 2.0 + 2.0 * gaps * step - gaps * step * step / 2.0;
+    ThreadPool pool(4);
+    EXPECT_NEAR(UnionArea::compute(set, pool, n), expected, 1e-9);
+    EXPECT_NEAR(UnionArea::compute(set, pool, 16), expected, 1e-9);
+}
+
+// Тест: невыпуклый многоугольник (буква L) и квадрат, закрывающий её вырез
+TEST(UnionAreaTest, NonConvexContour) {
+    std::array<Point<double>, 6> letter = {Point<double>(0, 0), Point<double>(2, 0), Point<double>(2, 1),
+                                           Point<double>(1, 1), Point<double>(1, 2), Point<double>(0, 2)};
+    ThreadPool pool(4);
+    PolygonSet set;
+    set.add(std::span<const Point<double>>(letter));
+    EXPECT_NEAR(UnionArea::compute(set, pool, 1), 3.0, EPS);
+
+    set.add(square(0.5, 0.5, 1.0).vertices());
+    EXPECT_NEAR(UnionArea::compute(set, pool, 2), 3.25, EPS);
+    EXPECT_NEAR(UnionArea::compute(set, pool, 1), 3.25, EPS);
+}
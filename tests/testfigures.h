@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+#include "../include/arrayoffigures.h"
+#include "../include/boundingbox.h"
+#include "../include/rhombus.h"
+#include "../include/pentagon.h"
+#include "../include/hexagon.h"
+
+// Общие наборы фигур для тестов.
+
+// Окно [min_x, max_x] x [min_y, max_y].
+inline BoundingBox<double> window(double min_x, double min_y, double max_x, double max_y) {
+    BoundingBox<double> box;
+    box.expand(min_x, min_y);
+    box.expand(max_x, max_y);
+    return box;
+}
+
+// n случайных точек, равномерно распределённых в квадрате [low, high] x [low, high].
+inline std::vector<Point<double>> random_points(std::size_t n, double low, double high, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> coordinate(low, high);
+    std::vector<Point<double>> points(n);
+    for (auto& point : points) {
+        point = Point<double>(coordinate(rng), coordinate(rng));
+    }
+    return points;
+}
+
+// Ромб с центром (cx, cy) и диагоналями 2k по осям; площадь 2k^2.
+inline Rhombus<double> diamond(double cx, double cy, double k) {
+    return Rhombus<double>(Point<double>(cx, cy + k), Point<double>(cx - k, cy), Point<double>(cx, cy - k), Point<double>(cx + k, cy));
+}
+
+// Тот же ромб для добавления в коллекцию.
+inline std::shared_ptr<Rhombus<double>> shared_diamond(double cx, double cy, double k) {
+    return std::make_shared<Rhombus<double>>(diamond(cx, cy, k));
+}
+
+// Квадрат [x, x + side] x [y, y + side] (ромб с прямыми углами), обход против часовой стрелки.
+inline Rhombus<double> square(double x, double y, double side) {
+    return Rhombus<double>(Point<double>(x, y), Point<double>(x + side, y), Point<double>(x + side, y + side), Point<double>(x, y + side));
+}
+
+// Коллекция из n фигур трёх видов (ромб, повёрнутый правильный пятиугольник, правильный шестиугольник)
+// с центрами в узлах сетки: фигура i - в точке (i % columns, i / columns).
+// Вершины ромбов кратны 0.25, поэтому проверка равенства сторон ромба точная.
+inline ArrayOfFigures<Figure<double>> mixed_figures(std::size_t n, std::size_t columns = 50) {
+    ArrayOfFigures<Figure<double>> figures;
+    for (std::size_t i = 0; i < n; ++i) {
+        double cx = static_cast<double>(i % columns);
+        double cy = static_cast<double>(i / columns);
+        switch (i % 3) {
+            case 0:
+                figures.emplace_figure<Rhombus<double>>(Point<double>(cx, cy + 0.5), Point<double>(cx - 0.25, cy),
+                                                        Point<double>(cx, cy - 0.5), Point<double>(cx + 0.25, cy));
+                break;
+            case 1:
+                figures.emplace_figure<Pentagon<double>>(Pentagon<double>::regular(Point<double>(cx, cy), 0.4, 0.1 * static_cast<double>(i)));
+                break;
+            default:
+                figures.emplace_figure<Hexagon<double>>(Hexagon<double>::regular(Point<double>(cx, cy), 0.3));
+                break;
+        }
+    }
+    return figures;
+}